@@ -10,7 +10,7 @@ struct BSTDeleteOptions : public DefaultBenchmarkOptions
 {
 	using MainRandomizer = DYN_GENERATOR;
 	constexpr static bool need_node_pointers = true;
-	using NodePointerRandomizer = UseUniform;
+	using NodePointerRandomizer = NodePointerRandomizerFor<MainRandomizer>;
 
 	constexpr static bool distinct = true;
 	constexpr static bool values_from_fixed = true; // TODO this makes no sense!
@@ -34,11 +34,11 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -47,7 +47,7 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggRBBSTFixture, BM_BST_Deletion)
 
@@ -63,11 +63,11 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixtureCC, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -76,7 +76,7 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixtureCC, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggRBBSTFixtureCC, BM_BST_Deletion)
 
@@ -92,11 +92,11 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixtureArith, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -105,10 +105,39 @@ BENCHMARK_DEFINE_F(DeleteYggRBBSTFixtureArith, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggRBBSTFixtureArith, BM_BST_Deletion)
 
+/*
+ * Ygg's Red-Black Tree, rebalancing top-down
+ */
+using DeleteYggRBBSTFixtureSP =
+    BSTFixture<YggRBTreeInterface<RBSinglePassTreeOptions>, DeleteExperiment,
+               BSTDeleteOptions>;
+BENCHMARK_DEFINE_F(DeleteYggRBBSTFixtureSP, BM_BST_Deletion)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto n : this->experiment_node_pointers) {
+			this->t.remove(*n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (auto n : this->experiment_node_pointers) {
+			this->t.insert(*n);
+		}
+		// TODO shuffling here?
+	}
+
+	this->counters.report_and_reset(state);
+}
+REGISTER(DeleteYggRBBSTFixtureSP, BM_BST_Deletion)
+
 /*
  * Ygg's Weight-Balanced Trees
  */
@@ -122,11 +151,11 @@ BENCHMARK_DEFINE_F(DeleteYggWBDefGDefDTPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -135,7 +164,7 @@ BENCHMARK_DEFINE_F(DeleteYggWBDefGDefDTPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWBDefGDefDTPBSTFixture, BM_BST_Deletion)
 
@@ -149,11 +178,11 @@ BENCHMARK_DEFINE_F(DeleteYggWBDefGDefDSPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -162,7 +191,7 @@ BENCHMARK_DEFINE_F(DeleteYggWBDefGDefDSPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWBDefGDefDSPBSTFixture, BM_BST_Deletion)
 
@@ -176,11 +205,11 @@ BENCHMARK_DEFINE_F(DeleteYggWB3G2DSPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -189,7 +218,7 @@ BENCHMARK_DEFINE_F(DeleteYggWB3G2DSPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWB3G2DSPBSTFixture, BM_BST_Deletion)
 
@@ -203,11 +232,11 @@ BENCHMARK_DEFINE_F(DeleteYggWB3G2DTPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -216,7 +245,7 @@ BENCHMARK_DEFINE_F(DeleteYggWB3G2DTPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWB3G2DTPBSTFixture, BM_BST_Deletion)
 
@@ -230,11 +259,11 @@ BENCHMARK_DEFINE_F(DeleteYggWBLWSPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -243,7 +272,7 @@ BENCHMARK_DEFINE_F(DeleteYggWBLWSPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWBLWSPBSTFixture, BM_BST_Deletion)
 
@@ -257,11 +286,11 @@ BENCHMARK_DEFINE_F(DeleteYggWBBalSPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -270,7 +299,7 @@ BENCHMARK_DEFINE_F(DeleteYggWBBalSPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWBBalSPBSTFixture, BM_BST_Deletion)
 
@@ -284,11 +313,11 @@ BENCHMARK_DEFINE_F(DeleteYggWBSuperBalSPBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -297,7 +326,7 @@ BENCHMARK_DEFINE_F(DeleteYggWBSuperBalSPBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggWBSuperBalSPBSTFixture, BM_BST_Deletion)
 
@@ -313,11 +342,11 @@ BENCHMARK_DEFINE_F(DeleteYggEBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -326,7 +355,7 @@ BENCHMARK_DEFINE_F(DeleteYggEBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggEBSTFixture, BM_BST_Deletion)
 
@@ -341,11 +370,11 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -354,7 +383,7 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggZBSTFixture, BM_BST_Deletion)
 
@@ -370,11 +399,11 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixtureHashing, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -383,7 +412,7 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixtureHashing, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggZBSTFixtureHashing, BM_BST_Deletion)
 
@@ -399,11 +428,11 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixtureHUL, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.remove(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -412,7 +441,7 @@ BENCHMARK_DEFINE_F(DeleteYggZBSTFixtureHUL, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteYggZBSTFixtureHUL, BM_BST_Deletion)
 
@@ -427,11 +456,11 @@ BENCHMARK_DEFINE_F(DeleteBISetBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			this->t.erase(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : this->experiment_node_pointers) {
@@ -440,7 +469,7 @@ BENCHMARK_DEFINE_F(DeleteBISetBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteBISetBSTFixture, BM_BST_Deletion)
 
@@ -469,11 +498,11 @@ BENCHMARK_DEFINE_F(DeleteStdSetBSTFixture, BM_BST_Deletion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto inner_it : experiment_iterators) {
 			extracted_nodes.push_back(this->t.extract(inner_it));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		experiment_iterators.clear();
@@ -484,7 +513,7 @@ BENCHMARK_DEFINE_F(DeleteStdSetBSTFixture, BM_BST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(DeleteStdSetBSTFixture, BM_BST_Deletion)
 
@@ -7,7 +7,7 @@ struct BSTEraseOptions : public DefaultBenchmarkOptions
 {
 	using MainRandomizer = DYN_GENERATOR;
 	constexpr static bool need_node_pointers = true;
-	using NodePointerRandomizer = UseUniform;
+	using NodePointerRandomizer = NodePointerRandomizerFor<MainRandomizer>;
 
 	//	constexpr static bool distinct = true;
 	constexpr static bool distinct = false; // Distinctness in values and the Zipf
@@ -38,11 +38,11 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -53,7 +53,7 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggRBBSTFixture, BM_BST_Erasure)
 
@@ -73,11 +73,11 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixtureArith, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -88,7 +88,7 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixtureArith, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggRBBSTFixtureArith, BM_BST_Erasure)
 
@@ -108,11 +108,11 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixturePF, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -123,7 +123,7 @@ BENCHMARK_DEFINE_F(EraseYggRBBSTFixturePF, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggRBBSTFixturePF, BM_BST_Erasure)
 
@@ -144,11 +144,11 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDTPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -159,7 +159,7 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDTPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBDefGDefDTPBSTFixture, BM_BST_Erasure)
 
@@ -177,11 +177,11 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDSPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -192,7 +192,7 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDSPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBDefGDefDSPBSTFixture, BM_BST_Erasure)
 
@@ -210,11 +210,11 @@ BENCHMARK_DEFINE_F(EraseYggWBLWSPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -225,7 +225,7 @@ BENCHMARK_DEFINE_F(EraseYggWBLWSPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBLWSPBSTFixture, BM_BST_Erasure)
 
@@ -243,11 +243,11 @@ BENCHMARK_DEFINE_F(EraseYggWBBalSPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -258,7 +258,7 @@ BENCHMARK_DEFINE_F(EraseYggWBBalSPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBBalSPBSTFixture, BM_BST_Erasure)
 
@@ -276,11 +276,11 @@ BENCHMARK_DEFINE_F(EraseYggWBSuperBalSPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -291,7 +291,7 @@ BENCHMARK_DEFINE_F(EraseYggWBSuperBalSPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBSuperBalSPBSTFixture, BM_BST_Erasure)
 
@@ -309,11 +309,11 @@ BENCHMARK_DEFINE_F(EraseYggWBBalSPArithBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -324,7 +324,7 @@ BENCHMARK_DEFINE_F(EraseYggWBBalSPArithBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBBalSPArithBSTFixture, BM_BST_Erasure)
 
@@ -342,11 +342,11 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDSPOPTBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -357,7 +357,7 @@ BENCHMARK_DEFINE_F(EraseYggWBDefGDefDSPOPTBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWBDefGDefDSPOPTBSTFixture, BM_BST_Erasure)
 
@@ -375,11 +375,11 @@ BENCHMARK_DEFINE_F(EraseYggWB3G2DSPBSTFixture, BM_BST_Erasure)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto n : this->experiment_node_pointers) {
 			erased_nodes.push_back(this->t.erase_optimistic(n->get_value()));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto n : erased_nodes) {
@@ -390,7 +390,7 @@ BENCHMARK_DEFINE_F(EraseYggWB3G2DSPBSTFixture, BM_BST_Erasure)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWB3G2DSPBSTFixture, BM_BST_Erasure)
 
@@ -407,11 +407,11 @@ BENCHMARK_DEFINE_F(EraseYggWB3G2DTPBSTFixture, BM_BST_Erasure)
   erased_nodes.reserve(this->experiment_node_pointers.size());
 
   Clock c; for (auto _ : state) {
-    c.start(); this->papi.start();
+    c.start(); this->counters.start();
     for (auto n : this->experiment_node_pointers) {
       erased_nodes.push_back(this->t.erase(n->get_value()));
     }
-    this->papi.stop(); state.SetIterationTime(c.get());
+    this->counters.stop(); state.SetIterationTime(c.get());
 
 
     for (auto n : erased_nodes) {
@@ -423,7 +423,7 @@ BENCHMARK_DEFINE_F(EraseYggWB3G2DTPBSTFixture, BM_BST_Erasure)
 
   }
 
-  this->papi.report_and_reset(state);
+  this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggWB3G2DTPBSTFixture, BM_BST_Erasure)
 */
@@ -443,11 +443,11 @@ BENCHMARK_DEFINE_F(EraseYggEBSTFixture, BM_BST_Erasure)
   erased_nodes.reserve(this->experiment_node_pointers.size());
 
   Clock c; for (auto _ : state) {
-    c.start(); this->papi.start();
+    c.start(); this->counters.start();
     for (auto n : this->experiment_node_pointers) {
       erased_nodes.push_back(this->t.erase(n->get_value()));
     }
-    this->papi.stop(); state.SetIterationTime(c.get());
+    this->counters.stop(); state.SetIterationTime(c.get());
 
 
     for (auto n : erased_nodes) {
@@ -459,7 +459,7 @@ BENCHMARK_DEFINE_F(EraseYggEBSTFixture, BM_BST_Erasure)
 
   }
 
-  this->papi.report_and_reset(state);
+  this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggEBSTFixture, BM_BST_Erasure);
 */
@@ -478,11 +478,11 @@ BENCHMARK_DEFINE_F(EraseYggZBSTFixture, BM_BST_Erasure)
   erased_nodes.reserve(this->experiment_node_pointers.size());
 
   Clock c; for (auto _ : state) {
-    c.start(); this->papi.start();
+    c.start(); this->counters.start();
     for (auto n : this->experiment_node_pointers) {
       erased_nodes.push_back(this->t.erase(n->get_value()));
     }
-    this->papi.stop(); state.SetIterationTime(c.get());
+    this->counters.stop(); state.SetIterationTime(c.get());
 
 
     for (auto n : erased_nodes) {
@@ -494,7 +494,7 @@ BENCHMARK_DEFINE_F(EraseYggZBSTFixture, BM_BST_Erasure)
 
   }
 
-  this->papi.report_and_reset(state);
+  this->counters.report_and_reset(state);
 }
 REGISTER(EraseYggZBSTFixture, BM_BST_Erasure)
 */
@@ -510,11 +510,11 @@ UseUniform, false>; BENCHMARK_DEFINE_F(EraseBISetBSTFixture, BM_BST_Erasure)
 {
 TODO Rebuild for the new erased_node system
   Clock c; for (auto _ : state) {
-    c.start(); this->papi.start();
+    c.start(); this->counters.start();
     for (auto n : this->experiment_node_pointers) {
       this->t.erase(*n);
     }
-    this->papi.stop(); state.SetIterationTime(c.get());
+    this->counters.stop(); state.SetIterationTime(c.get());
 
 
     for (auto n : this->experiment_node_pointers) {
@@ -524,7 +524,7 @@ TODO Rebuild for the new erased_node system
 
   }
 
-  this->papi.report_and_reset(state);
+  this->counters.report_and_reset(state);
 }
 REGISTER(EraseBISetBSTFixture, BM_BST_Erasure);
 */
@@ -552,11 +552,11 @@ UseNone, false>; BENCHMARK_DEFINE_F(EraseStdSetBSTFixture, BM_BST_Erasure)
   all_iterators.clear();
 
   Clock c; for (auto _ : state) {
-    c.start(); this->papi.start();
+    c.start(); this->counters.start();
     for (auto inner_it : experiment_iterators) {
       extracted_nodes.push_back(this->t.extract(inner_it));
     }
-    this->papi.stop(); state.SetIterationTime(c.get());
+    this->counters.stop(); state.SetIterationTime(c.get());
 
 
     experiment_iterators.clear();
@@ -568,7 +568,7 @@ UseNone, false>; BENCHMARK_DEFINE_F(EraseStdSetBSTFixture, BM_BST_Erasure)
 
   }
 
-  this->papi.report_and_reset(state);
+  this->counters.report_and_reset(state);
 }
 REGISTER(EraseStdSetBSTFixture, BM_BST_Erasure);
 */
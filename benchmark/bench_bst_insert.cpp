@@ -27,11 +27,11 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -40,7 +40,7 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggRBBSTFixture, BM_BST_Insertion)
 
@@ -56,11 +56,11 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixtureArith, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -69,7 +69,7 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixtureArith, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggRBBSTFixtureArith, BM_BST_Insertion)
 
@@ -85,11 +85,11 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixturePF, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -98,7 +98,7 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixturePF, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggRBBSTFixturePF, BM_BST_Insertion)
 
@@ -114,11 +114,11 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixtureCC, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -127,10 +127,39 @@ BENCHMARK_DEFINE_F(InsertYggRBBSTFixtureCC, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggRBBSTFixtureCC, BM_BST_Insertion)
 
+/*
+ * Ygg's Red-Black Tree, rebalancing top-down
+ */
+using InsertYggRBBSTFixtureSP =
+    BSTFixture<YggRBTreeInterface<RBSinglePassTreeOptions>, InsertExperiment,
+               BSTInsertOptions>;
+BENCHMARK_DEFINE_F(InsertYggRBBSTFixtureSP, BM_BST_Insertion)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto & n : this->experiment_nodes) {
+			this->t.insert(n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (auto & n : this->experiment_nodes) {
+			this->t.remove(n);
+		}
+		// TODO shuffling here?
+	}
+
+	this->counters.report_and_reset(state);
+}
+REGISTER(InsertYggRBBSTFixtureSP, BM_BST_Insertion)
+
 /*
  * Ygg's Weight-Balanced Tree
  */
@@ -144,11 +173,11 @@ BENCHMARK_DEFINE_F(InsertYggWBDefGDefDTPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -157,7 +186,7 @@ BENCHMARK_DEFINE_F(InsertYggWBDefGDefDTPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBDefGDefDTPBSTFixture, BM_BST_Insertion)
 
@@ -171,11 +200,11 @@ BENCHMARK_DEFINE_F(InsertYggWBDefGDefDSPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -184,7 +213,7 @@ BENCHMARK_DEFINE_F(InsertYggWBDefGDefDSPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBDefGDefDSPBSTFixture, BM_BST_Insertion)
 
@@ -198,11 +227,11 @@ BENCHMARK_DEFINE_F(InsertYggWBLWSPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -211,7 +240,7 @@ BENCHMARK_DEFINE_F(InsertYggWBLWSPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBLWSPBSTFixture, BM_BST_Insertion)
 
@@ -225,11 +254,11 @@ BENCHMARK_DEFINE_F(InsertYggWBBalSPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -238,7 +267,7 @@ BENCHMARK_DEFINE_F(InsertYggWBBalSPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBBalSPBSTFixture, BM_BST_Insertion)
 
@@ -252,11 +281,11 @@ BENCHMARK_DEFINE_F(InsertYggWBBalSPArithBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -265,7 +294,7 @@ BENCHMARK_DEFINE_F(InsertYggWBBalSPArithBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBBalSPArithBSTFixture, BM_BST_Insertion)
 
@@ -279,11 +308,11 @@ BENCHMARK_DEFINE_F(InsertYggWBSuperBalSPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -292,7 +321,7 @@ BENCHMARK_DEFINE_F(InsertYggWBSuperBalSPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWBSuperBalSPBSTFixture, BM_BST_Insertion)
 
@@ -306,11 +335,11 @@ BENCHMARK_DEFINE_F(InsertYggWB3G2DSPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -319,7 +348,7 @@ BENCHMARK_DEFINE_F(InsertYggWB3G2DSPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWB3G2DSPBSTFixture, BM_BST_Insertion)
 
@@ -333,11 +362,11 @@ BENCHMARK_DEFINE_F(InsertYggWB3G2DTPBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -346,7 +375,7 @@ BENCHMARK_DEFINE_F(InsertYggWB3G2DTPBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggWB3G2DTPBSTFixture, BM_BST_Insertion)
 
@@ -362,11 +391,11 @@ BENCHMARK_DEFINE_F(InsertYggEBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -375,7 +404,7 @@ BENCHMARK_DEFINE_F(InsertYggEBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggEBSTFixture, BM_BST_Insertion)
 
@@ -390,11 +419,11 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -402,7 +431,7 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixture, BM_BST_Insertion)
 		}
 		// TODO shuffling here?
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggZBSTFixture, BM_BST_Insertion)
 
@@ -417,11 +446,11 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHash, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -429,7 +458,7 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHash, BM_BST_Insertion)
 		}
 		// TODO shuffling here?
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggZBSTFixtureHash, BM_BST_Insertion)
 
@@ -445,11 +474,11 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHUL, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -457,10 +486,107 @@ BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHUL, BM_BST_Insertion)
 		}
 		// TODO shuffling here?
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertYggZBSTFixtureHUL, BM_BST_Insertion)
 
+/*
+ * Ygg's Zip Tree, using hashing + mixing
+ *
+ * Ranks are computed from the mixed hash on every comparison during unzipping
+ * and zipping. This needs no rank storage in the nodes, at the cost of one
+ * 64x64->128 bit multiplication per rank lookup (compared to plain hashing).
+ * With the identity hash on (shuffled) consecutive integers used here, plain
+ * hashing already yields well-distributed ranks and is slightly faster. Mixing
+ * makes the rank distribution independent of the keys' structure (e.g., keys
+ * that are all multiples of a power of two, or node addresses).
+ */
+using InsertYggZBSTFixtureHMix =
+    BSTFixture<YggZTreeInterface<ZMixHashTreeOptions>, InsertExperiment,
+               BSTInsertOptions>;
+BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHMix, BM_BST_Insertion)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto & n : this->experiment_nodes) {
+			this->t.insert(n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (auto & n : this->experiment_nodes) {
+			this->t.remove(n);
+		}
+		// TODO shuffling here?
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(InsertYggZBSTFixtureHMix, BM_BST_Insertion)
+
+/*
+ * Ygg's Zip Tree, using hashing + mixing, with stored ranks
+ *
+ * Trades one byte per node (which often fits into padding) for not having to
+ * recompute the ranks during comparisons. The ranks of the experiment nodes
+ * are computed in bulk (see ZTree::update_ranks) before each insertion run.
+ */
+using InsertYggZBSTFixtureHMixS =
+    BSTFixture<YggZTreeInterface<ZMixHashStoredTreeOptions>, InsertExperiment,
+               BSTInsertOptions>;
+BENCHMARK_DEFINE_F(InsertYggZBSTFixtureHMixS, BM_BST_Insertion)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		decltype(this->t)::update_ranks(this->experiment_nodes.begin(),
+		                                this->experiment_nodes.end());
+		for (auto & n : this->experiment_nodes) {
+			this->t.insert(n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (auto & n : this->experiment_nodes) {
+			this->t.remove(n);
+		}
+		// TODO shuffling here?
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(InsertYggZBSTFixtureHMixS, BM_BST_Insertion)
+
+/*
+ * Ygg's B-Tree Index
+ */
+using InsertYggBTreeBSTFixture =
+    BSTFixture<YggBTreeIndexInterface<BTree32TreeOptions>, InsertExperiment,
+               BSTInsertOptions>;
+BENCHMARK_DEFINE_F(InsertYggBTreeBSTFixture, BM_BST_Insertion)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto & n : this->experiment_nodes) {
+			this->t.insert(n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (auto & n : this->experiment_nodes) {
+			this->t.remove(n);
+		}
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(InsertYggBTreeBSTFixture, BM_BST_Insertion)
+
 /*
  * Boost::Intrusive::Set
  */
@@ -472,11 +598,11 @@ BENCHMARK_DEFINE_F(InsertBISetBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (auto & n : this->experiment_nodes) {
@@ -484,7 +610,7 @@ BENCHMARK_DEFINE_F(InsertBISetBSTFixture, BM_BST_Insertion)
 		}
 		// TODO shuffling here?
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertBISetBSTFixture, BM_BST_Insertion)
 
@@ -506,12 +632,12 @@ BENCHMARK_DEFINE_F(InsertStdSetBSTFixture, BM_BST_Insertion)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			// TODO emplace_back incurs a minimal overhead. Can we work around this?
 			insertion_iterators.emplace_back(this->t.insert(std::move(n)));
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		// Since we moved, we must completely rebuild the experiment nodes
@@ -523,7 +649,7 @@ BENCHMARK_DEFINE_F(InsertStdSetBSTFixture, BM_BST_Insertion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(InsertStdSetBSTFixture, BM_BST_Insertion)
 
@@ -12,7 +12,7 @@ struct BSTMoveOptions : public DefaultBenchmarkOptions
 	using ValueRandomizer = UseUniform;
 	constexpr static size_t node_value_change_percentage = 5;
 	constexpr static bool need_node_pointers = true;
-	using NodePointerRandomizer = UseUniform;
+	using NodePointerRandomizer = NodePointerRandomizerFor<MainRandomizer>;
 
 #ifdef PRESORT
 	constexpr static bool nodes_presort = true;
@@ -33,7 +33,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -42,7 +42,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -55,7 +55,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggRBBSTFixture, BM_BST_Move)
 
@@ -71,7 +71,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureCC, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -80,7 +80,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureCC, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -93,7 +93,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureCC, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggRBBSTFixtureCC, BM_BST_Move)
 
@@ -109,7 +109,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureArith, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -118,7 +118,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureArith, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -131,7 +131,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixtureArith, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggRBBSTFixtureArith, BM_BST_Move)
 
@@ -147,7 +147,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixturePF, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -156,7 +156,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixturePF, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -169,7 +169,7 @@ BENCHMARK_DEFINE_F(MoveYggRBBSTFixturePF, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggRBBSTFixturePF, BM_BST_Move)
 
@@ -186,7 +186,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDTPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -195,7 +195,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDTPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -208,7 +208,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDTPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBDefGDefDTPBSTFixture, BM_BST_Move)
 
@@ -222,7 +222,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDSPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -231,7 +231,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDSPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -244,7 +244,7 @@ BENCHMARK_DEFINE_F(MoveYggWBDefGDefDSPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBDefGDefDSPBSTFixture, BM_BST_Move)
 
@@ -258,7 +258,7 @@ BENCHMARK_DEFINE_F(MoveYggWBLWSPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -267,7 +267,7 @@ BENCHMARK_DEFINE_F(MoveYggWBLWSPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -280,7 +280,7 @@ BENCHMARK_DEFINE_F(MoveYggWBLWSPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBLWSPBSTFixture, BM_BST_Move)
 
@@ -294,7 +294,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -303,7 +303,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -316,7 +316,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBBalSPBSTFixture, BM_BST_Move)
 
@@ -330,7 +330,7 @@ BENCHMARK_DEFINE_F(MoveYggWBSuperBalSPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -339,7 +339,7 @@ BENCHMARK_DEFINE_F(MoveYggWBSuperBalSPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -352,7 +352,7 @@ BENCHMARK_DEFINE_F(MoveYggWBSuperBalSPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBSuperBalSPBSTFixture, BM_BST_Move)
 
@@ -366,7 +366,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPArithBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -375,7 +375,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPArithBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -388,7 +388,7 @@ BENCHMARK_DEFINE_F(MoveYggWBBalSPArithBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWBBalSPArithBSTFixture, BM_BST_Move)
 
@@ -402,7 +402,7 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DSPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -411,7 +411,7 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DSPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -424,7 +424,7 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DSPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWB3G2DSPBSTFixture, BM_BST_Move)
 
@@ -438,7 +438,7 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DTPBSTFixture, BM_BST_Move)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
 			auto * n = this->experiment_node_pointers[i];
 			auto new_val = this->experiment_values[i];
@@ -447,7 +447,7 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DTPBSTFixture, BM_BST_Move)
 			NodeInterface::set_value(*n, new_val);
 			this->t.insert(*n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 
 		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
@@ -460,10 +460,48 @@ BENCHMARK_DEFINE_F(MoveYggWB3G2DTPBSTFixture, BM_BST_Move)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(MoveYggWB3G2DTPBSTFixture, BM_BST_Move)
 
+/*
+ * Ygg's Energy-Balanced Tree
+ */
+using MoveYggEBSTFixture =
+    BSTFixture<YggEnergyTreeInterface<BasicTreeOptions>, MoveExperiment,
+               BSTMoveOptions>;
+BENCHMARK_DEFINE_F(MoveYggEBSTFixture, BM_BST_Move)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
+			auto * n = this->experiment_node_pointers[i];
+			auto new_val = this->experiment_values[i];
+
+			this->t.remove(*n);
+			NodeInterface::set_value(*n, new_val);
+			this->t.insert(*n);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+
+		for (size_t i = 0; i < this->experiment_node_pointers.size(); i++) {
+			auto * n = this->experiment_node_pointers[i];
+			auto old_val = this->fixed_values[i];
+
+			this->t.remove(*n);
+			NodeInterface::set_value(*n, old_val);
+			this->t.insert(*n);
+		}
+	}
+
+	this->counters.report_and_reset(state);
+}
+REGISTER(MoveYggEBSTFixture, BM_BST_Move)
+
 #ifndef NOMAIN
 #include "main.hpp"
 #endif
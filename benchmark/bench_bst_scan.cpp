@@ -0,0 +1,141 @@
+/*
+ * In-order iteration and range scans.
+ *
+ * Scan and ReverseScan iterate over the whole tree, forwards and backwards.
+ * RangeQuery<k> looks up every experiment value via lower_bound() and then
+ * advances the iterator k times (or until the end of the tree). Other than
+ * searching, these mostly exercise the iterators' successor / predecessor
+ * logic. With PRESORT, half of the nodes are stored in key order, which makes
+ * iterating over them more cache-friendly.
+ *
+ * Per-operation hardware counters (USEPERF) are per visited node for the scans
+ * and per range query otherwise.
+ */
+#ifndef BENCH_BST_SCAN_HPP
+#define BENCH_BST_SCAN_HPP
+
+#include "common_bst.hpp"
+
+struct BSTScanOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = DYN_GENERATOR;
+#ifdef PRESORT
+	constexpr static bool fixed_presort = true;
+	constexpr static double fixed_presort_fraction = 0.5;
+#endif
+};
+
+struct BSTRangeQueryOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = DYN_GENERATOR;
+	constexpr static bool need_values = true;
+	using ValueRandomizer = UseUniform;
+	constexpr static bool values_from_fixed = true;
+#ifdef PRESORT
+	constexpr static bool fixed_presort = true;
+	constexpr static double fixed_presort_fraction = 0.5;
+#endif
+};
+
+template <class Fixture>
+void
+measure_scan(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		f.counters.start();
+		for (const auto & n : f.t) {
+			benchmark::DoNotOptimize(n);
+		}
+		f.counters.stop();
+		state.SetIterationTime(c.get());
+	}
+
+	// Every iteration visits all nodes
+	f.counters.report_and_reset(state, f.fixed_nodes.size());
+}
+
+template <class Fixture>
+void
+measure_reverse_scan(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		f.counters.start();
+		for (auto it = f.t.rbegin(); it != f.t.rend(); ++it) {
+			benchmark::DoNotOptimize(*it);
+		}
+		f.counters.stop();
+		state.SetIterationTime(c.get());
+	}
+
+	// Every iteration visits all nodes
+	f.counters.report_and_reset(state, f.fixed_nodes.size());
+}
+
+template <size_t k>
+struct RangeQuery
+{
+	template <class Fixture>
+	static void
+	measure(Fixture & f, benchmark::State & state)
+	{
+		Clock c;
+		for (auto _ : state) {
+			c.start();
+			f.counters.start();
+			for (auto val : f.experiment_values) {
+				auto it = f.t.lower_bound(val);
+				for (size_t i = 0; (i < k) && (it != f.t.end()); ++i) {
+					benchmark::DoNotOptimize(*it);
+					++it;
+				}
+			}
+			f.counters.stop();
+			state.SetIterationTime(c.get());
+		}
+
+		f.counters.report_and_reset(state);
+	}
+};
+
+#define SCAN_BENCHMARK(Fixture, Method, measure)                               \
+	BENCHMARK_DEFINE_F(Fixture, Method)                                          \
+	(benchmark::State & state) { measure(*this, state); }                        \
+	REGISTER(Fixture, Method)
+
+#define SCAN_BENCHMARKS(Name, Interface)                                       \
+	using Scan##Name##BSTFixture =                                               \
+	    BSTFixture<Interface, ScanExperiment, BSTScanOptions>;                   \
+	SCAN_BENCHMARK(Scan##Name##BSTFixture, BM_BST_Scan, measure_scan)            \
+	using ReverseScan##Name##BSTFixture =                                        \
+	    BSTFixture<Interface, ReverseScanExperiment, BSTScanOptions>;            \
+	SCAN_BENCHMARK(ReverseScan##Name##BSTFixture, BM_BST_ReverseScan,            \
+	               measure_reverse_scan)                                         \
+	using RangeQuery10##Name##BSTFixture =                                       \
+	    BSTFixture<Interface, RangeQuery10Experiment, BSTRangeQueryOptions>;     \
+	SCAN_BENCHMARK(RangeQuery10##Name##BSTFixture, BM_BST_RangeQuery,            \
+	               RangeQuery<10>::measure)                                      \
+	using RangeQuery100##Name##BSTFixture =                                      \
+	    BSTFixture<Interface, RangeQuery100Experiment, BSTRangeQueryOptions>;    \
+	SCAN_BENCHMARK(RangeQuery100##Name##BSTFixture, BM_BST_RangeQuery,           \
+	               RangeQuery<100>::measure)                                     \
+	using RangeQuery1000##Name##BSTFixture =                                     \
+	    BSTFixture<Interface, RangeQuery1000Experiment, BSTRangeQueryOptions>;   \
+	SCAN_BENCHMARK(RangeQuery1000##Name##BSTFixture, BM_BST_RangeQuery,          \
+	               RangeQuery<1000>::measure)
+
+SCAN_BENCHMARKS(YggRB, YggRBTreeInterface<BasicTreeOptions>)
+SCAN_BENCHMARKS(YggWBDefSP, YggWBTreeInterface<WBTSinglepassTreeOptions>)
+SCAN_BENCHMARKS(YggZ, YggZTreeInterface<ZRandomTreeOptions>)
+SCAN_BENCHMARKS(YggE, YggEnergyTreeInterface<BasicTreeOptions>)
+SCAN_BENCHMARKS(BISet, BoostSetInterface)
+SCAN_BENCHMARKS(StdSet, StdSetInterface)
+
+#ifndef NOMAIN
+#include "main.hpp"
+#endif
+
+#endif
@@ -25,17 +25,17 @@ BENCHMARK_DEFINE_F(SearchYggRBBSTFixtureArith, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggRBBSTFixtureArith, BM_BST_Search)
 
@@ -51,17 +51,17 @@ BENCHMARK_DEFINE_F(SearchYggRBBSTFixturePF, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggRBBSTFixturePF, BM_BST_Search)
 
@@ -76,17 +76,17 @@ BENCHMARK_DEFINE_F(SearchYggRBBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggRBBSTFixture, BM_BST_Search)
 
@@ -102,17 +102,17 @@ BENCHMARK_DEFINE_F(SearchYggRBBSTFixtureCC, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggRBBSTFixtureCC, BM_BST_Search)
 
@@ -128,17 +128,17 @@ BENCHMARK_DEFINE_F(SearchYggWBDefTPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWBDefTPBSTFixture, BM_BST_Search)
 
@@ -154,17 +154,17 @@ BENCHMARK_DEFINE_F(SearchYggWBDefSPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWBDefSPBSTFixture, BM_BST_Search)
 
@@ -180,17 +180,17 @@ BENCHMARK_DEFINE_F(SearchYggWBLWSPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWBLWSPBSTFixture, BM_BST_Search)
 
@@ -206,17 +206,17 @@ BENCHMARK_DEFINE_F(SearchYggWBBalSPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWBBalSPBSTFixture, BM_BST_Search)
 
@@ -232,17 +232,17 @@ BENCHMARK_DEFINE_F(SearchYggWBSuperBalSPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWBSuperBalSPBSTFixture, BM_BST_Search)
 
@@ -258,17 +258,17 @@ BENCHMARK_DEFINE_F(SearchYggWB32SPBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		// TODO shuffling?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggWB32SPBSTFixture, BM_BST_Search)
 
@@ -283,15 +283,15 @@ BENCHMARK_DEFINE_F(SearchYggZBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggZBSTFixture, BM_BST_Search)
 
@@ -307,15 +307,15 @@ BENCHMARK_DEFINE_F(SearchYggZBSTFixtureHUL, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggZBSTFixtureHUL, BM_BST_Search)
 
@@ -330,18 +330,90 @@ BENCHMARK_DEFINE_F(SearchYggZBSTFixtureHash, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchYggZBSTFixtureHash, BM_BST_Search)
 
+/*
+ * Ygg's B-Tree Index, 16 keys per node
+ */
+using SearchYggBTree16BSTFixture =
+    BSTFixture<YggBTreeIndexInterface<BTree16TreeOptions>, SearchExperiment,
+               BSTSearchOptions>;
+BENCHMARK_DEFINE_F(SearchYggBTree16BSTFixture, BM_BST_Search)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto val : this->experiment_values) {
+			auto node = this->t.find(val);
+			benchmark::DoNotOptimize(node);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(SearchYggBTree16BSTFixture, BM_BST_Search)
+
+/*
+ * Ygg's B-Tree Index, 32 keys per node
+ */
+using SearchYggBTree32BSTFixture =
+    BSTFixture<YggBTreeIndexInterface<BTree32TreeOptions>, SearchExperiment,
+               BSTSearchOptions>;
+BENCHMARK_DEFINE_F(SearchYggBTree32BSTFixture, BM_BST_Search)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto val : this->experiment_values) {
+			auto node = this->t.find(val);
+			benchmark::DoNotOptimize(node);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(SearchYggBTree32BSTFixture, BM_BST_Search)
+
+/*
+ * Ygg's B-Tree Index, 64 keys per node
+ */
+using SearchYggBTree64BSTFixture =
+    BSTFixture<YggBTreeIndexInterface<BTree64TreeOptions>, SearchExperiment,
+               BSTSearchOptions>;
+BENCHMARK_DEFINE_F(SearchYggBTree64BSTFixture, BM_BST_Search)
+(benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		this->counters.start();
+		for (auto val : this->experiment_values) {
+			auto node = this->t.find(val);
+			benchmark::DoNotOptimize(node);
+		}
+		this->counters.stop();
+		state.SetIterationTime(c.get());
+	}
+	this->counters.report_and_reset(state);
+}
+REGISTER(SearchYggBTree64BSTFixture, BM_BST_Search)
+
 /*
  * Boost::Intrusive::Set
  */
@@ -353,15 +425,15 @@ BENCHMARK_DEFINE_F(SearchBISetBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchBISetBSTFixture, BM_BST_Search)
 
@@ -376,15 +448,15 @@ BENCHMARK_DEFINE_F(SearchStdSetBSTFixture, BM_BST_Search)
 	Clock c;
 	for (auto _ : state) {
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto val : this->experiment_values) {
 			auto node = this->t.find(val);
 			benchmark::DoNotOptimize(node);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 	}
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 }
 REGISTER(SearchStdSetBSTFixture, BM_BST_Search)
 
@@ -17,11 +17,11 @@ BENCHMARK_DEFINE_F(DeleteRBDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -30,7 +30,7 @@ BENCHMARK_DEFINE_F(DeleteRBDSTFixture, BM_DST_Deletion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -52,11 +52,11 @@ BENCHMARK_DEFINE_F(DeleteZHDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -66,7 +66,7 @@ BENCHMARK_DEFINE_F(DeleteZHDSTFixture, BM_DST_Deletion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -89,11 +89,11 @@ BENCHMARK_DEFINE_F(DeleteZHSDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -103,7 +103,7 @@ BENCHMARK_DEFINE_F(DeleteZHSDSTFixture, BM_DST_Deletion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -122,11 +122,11 @@ BENCHMARK_DEFINE_F(DeleteZRDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -137,7 +137,7 @@ BENCHMARK_DEFINE_F(DeleteZRDSTFixture, BM_DST_Deletion)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -159,11 +159,11 @@ BENCHMARK_DEFINE_F(Delete32WBDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -172,7 +172,7 @@ BENCHMARK_DEFINE_F(Delete32WBDSTFixture, BM_DST_Deletion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -194,11 +194,11 @@ BENCHMARK_DEFINE_F(DeleteBalWBDSTFixture, BM_DST_Deletion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -207,7 +207,7 @@ BENCHMARK_DEFINE_F(DeleteBalWBDSTFixture, BM_DST_Deletion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 
@@ -17,11 +17,11 @@ BENCHMARK_DEFINE_F(InsertRBDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -30,7 +30,7 @@ BENCHMARK_DEFINE_F(InsertRBDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(InsertRBDSTFixture, BM_DST_Insertion)
@@ -53,11 +53,11 @@ BENCHMARK_DEFINE_F(InsertZHDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -67,7 +67,7 @@ BENCHMARK_DEFINE_F(InsertZHDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(InsertZHDSTFixture, BM_DST_Insertion)
@@ -91,11 +91,11 @@ BENCHMARK_DEFINE_F(InsertZHSDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -105,7 +105,7 @@ BENCHMARK_DEFINE_F(InsertZHSDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(InsertZHSDSTFixture, BM_DST_Insertion)
@@ -126,7 +126,7 @@ BENCHMARK_DEFINE_F(InsertZRDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 
 			// To also measure the overhead of randomly generating the ranks, we have
@@ -136,7 +136,7 @@ BENCHMARK_DEFINE_F(InsertZRDSTFixture, BM_DST_Insertion)
 
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -146,7 +146,7 @@ BENCHMARK_DEFINE_F(InsertZRDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(InsertZRDSTFixture, BM_DST_Insertion)
@@ -169,11 +169,11 @@ BENCHMARK_DEFINE_F(Insert32WBDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -182,7 +182,7 @@ BENCHMARK_DEFINE_F(Insert32WBDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(Insert32WBDSTFixture, BM_DST_Insertion)
@@ -205,11 +205,11 @@ BENCHMARK_DEFINE_F(InsertBalWBDSTFixture, BM_DST_Insertion)
 	for (auto _ : state) {
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto & n : this->experiment_nodes) {
 			this->t.insert(n);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		PointerCountCallback::stop();
 		state.SetIterationTime(c.get());
 
@@ -218,7 +218,7 @@ BENCHMARK_DEFINE_F(InsertBalWBDSTFixture, BM_DST_Insertion)
 		}
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(InsertBalWBDSTFixture, BM_DST_Insertion)
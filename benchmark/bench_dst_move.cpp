@@ -16,7 +16,7 @@ BENCHMARK_DEFINE_F(MoveRBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -25,7 +25,7 @@ BENCHMARK_DEFINE_F(MoveRBDSTFixture, BM_DST_Move)(benchmark::State & state)
 			this->fixed_nodes[i].value = value; // TODO don't do this?
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -41,7 +41,7 @@ BENCHMARK_DEFINE_F(MoveRBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(MoveRBDSTFixture, BM_DST_Move)
@@ -64,7 +64,7 @@ BENCHMARK_DEFINE_F(MoveZHDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -73,7 +73,7 @@ BENCHMARK_DEFINE_F(MoveZHDSTFixture, BM_DST_Move)(benchmark::State & state)
 			this->fixed_nodes[i].value = value; // TODO don't do this?
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -91,7 +91,7 @@ BENCHMARK_DEFINE_F(MoveZHDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(MoveZHDSTFixture, BM_DST_Move)
@@ -115,7 +115,7 @@ BENCHMARK_DEFINE_F(MoveZHSDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -124,7 +124,7 @@ BENCHMARK_DEFINE_F(MoveZHSDSTFixture, BM_DST_Move)(benchmark::State & state)
 			this->fixed_nodes[i].value = value; // TODO don't do this?
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -142,7 +142,7 @@ BENCHMARK_DEFINE_F(MoveZHSDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(MoveZHSDSTFixture, BM_DST_Move)
@@ -163,7 +163,7 @@ BENCHMARK_DEFINE_F(MoveZRDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -178,7 +178,7 @@ BENCHMARK_DEFINE_F(MoveZRDSTFixture, BM_DST_Move)(benchmark::State & state)
 
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -196,7 +196,7 @@ BENCHMARK_DEFINE_F(MoveZRDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(MoveZRDSTFixture, BM_DST_Move)
@@ -219,7 +219,7 @@ BENCHMARK_DEFINE_F(Move32WBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -228,7 +228,7 @@ BENCHMARK_DEFINE_F(Move32WBDSTFixture, BM_DST_Move)(benchmark::State & state)
 			this->fixed_nodes[i].value = value; // TODO don't do this?
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -244,7 +244,7 @@ BENCHMARK_DEFINE_F(Move32WBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(Move32WBDSTFixture, BM_DST_Move)
@@ -267,7 +267,7 @@ BENCHMARK_DEFINE_F(MoveBalWBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		size_t j = 0;
 		PointerCountCallback::start();
 		c.start();
-		this->papi.start();
+		this->counters.start();
 		for (auto i : this->experiment_indices) {
 			this->t.remove(this->fixed_nodes[i]);
 			auto [upper, lower, value] = this->experiment_values[j++];
@@ -276,7 +276,7 @@ BENCHMARK_DEFINE_F(MoveBalWBDSTFixture, BM_DST_Move)(benchmark::State & state)
 			this->fixed_nodes[i].value = value; // TODO don't do this?
 			this->t.insert(this->fixed_nodes[i]);
 		}
-		this->papi.stop();
+		this->counters.stop();
 		state.SetIterationTime(c.get());
 		PointerCountCallback::stop();
 
@@ -292,7 +292,7 @@ BENCHMARK_DEFINE_F(MoveBalWBDSTFixture, BM_DST_Move)(benchmark::State & state)
 		// TODO shuffling here?
 	}
 
-	this->papi.report_and_reset(state);
+	this->counters.report_and_reset(state);
 	PointerCountCallback::report(state);
 }
 REGISTER(MoveBalWBDSTFixture, BM_DST_Move)
@@ -0,0 +1,134 @@
+/*
+ * Compares searching a red-black tree with searching an Eytzinger snapshot
+ * of the same tree, for 1M to 100M keys.
+ *
+ * Both benchmarks look up the same sequence of uniformly chosen keys, all of
+ * which are present in the tree.
+ */
+
+#include "../src/rbtree.hpp"
+
+#include <benchmark/benchmark.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+constexpr size_t QUERY_COUNT = 1000000;
+constexpr unsigned int BASE_SEED = 42;
+
+class Node : public ygg::RBTreeNodeBase<Node, ygg::DefaultOptions> {
+public:
+	int key;
+
+	bool
+	operator<(const Node & other) const
+	{
+		return this->key < other.key;
+	}
+};
+
+bool
+operator<(const Node & lhs, int rhs)
+{
+	return lhs.key < rhs;
+}
+bool
+operator<(int lhs, const Node & rhs)
+{
+	return lhs < rhs.key;
+}
+
+class KeyExtractor {
+public:
+	using key_type = int;
+
+	static int
+	get_key(const Node & n)
+	{
+		return n.key;
+	}
+};
+
+using Tree = ygg::RBTree<Node, ygg::RBDefaultNodeTraits, ygg::DefaultOptions>;
+using Snapshot = ygg::EytzingerSnapshot<Node, int>;
+
+/*
+ * The tree, its snapshot and the queries for one size. Building a tree of
+ * 100M nodes takes a while, so it is only done once per size.
+ */
+class Subject {
+public:
+	explicit Subject(size_t size) : nodes(size)
+	{
+		std::mt19937 rng(BASE_SEED);
+		std::uniform_int_distribution<int> dist(0,
+		                                        std::numeric_limits<int>::max());
+		for (auto & n : this->nodes) {
+			n.key = dist(rng);
+			this->t.insert(n);
+		}
+		this->snapshot = this->t.freeze_eytzinger<KeyExtractor>();
+
+		for (size_t i = 0; i < QUERY_COUNT; ++i) {
+			this->queries.push_back(this->nodes[rng() % size].key);
+		}
+	}
+
+	std::vector<Node> nodes;
+	Tree t;
+	Snapshot snapshot;
+	std::vector<int> queries;
+};
+
+Subject &
+get_subject(size_t size)
+{
+	// Keep only the most recently used size alive
+	static std::unique_ptr<Subject> subject;
+	if ((subject == nullptr) || (subject->nodes.size() != size)) {
+		subject.reset();
+		subject = std::make_unique<Subject>(size);
+	}
+	return *subject;
+}
+
+static void
+BM_Eytzinger_TreeFind(benchmark::State & state)
+{
+	Subject & subject = get_subject(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		for (int q : subject.queries) {
+			benchmark::DoNotOptimize(&*subject.t.find(q));
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+	                        static_cast<int64_t>(QUERY_COUNT));
+}
+BENCHMARK(BM_Eytzinger_TreeFind)
+    ->RangeMultiplier(10)
+    ->Range(1000000, 100000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void
+BM_Eytzinger_SnapshotFind(benchmark::State & state)
+{
+	Subject & subject = get_subject(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		for (int q : subject.queries) {
+			benchmark::DoNotOptimize(subject.snapshot.find(q));
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+	                        static_cast<int64_t>(QUERY_COUNT));
+}
+BENCHMARK(BM_Eytzinger_SnapshotFind)
+    ->RangeMultiplier(10)
+    ->Range(1000000, 100000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
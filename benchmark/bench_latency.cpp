@@ -0,0 +1,214 @@
+/*
+ * Per-operation latencies of BST and DST operations.
+ *
+ * The benchmarks in bench_bst_*.cpp and bench_dst_*.cpp only measure the time
+ * of a whole batch of operations, which hides the cost of single expensive
+ * operations (e.g., rebuilding subtrees in the Energy-Balanced Tree). Here,
+ * every single operation is timed with the CPU's time stamp counter and
+ * recorded in a histogram. Percentiles up to p99.99 and the maximum are
+ * reported as user counters, and written to the CSV file given by
+ * --latency_csv, which scripts/plot.py can plot.
+ *
+ * The iteration times include the overhead of reading the time stamp counter,
+ * use the run_all benchmarks for mean times.
+ */
+#ifndef BENCH_LATENCY_HPP
+#define BENCH_LATENCY_HPP
+
+#include "common_bst.hpp"
+#include "common_dst.hpp"
+
+#include <type_traits>
+
+// Same data as in bench_bst_insert.cpp, bench_bst_delete.cpp and
+// bench_bst_search.cpp
+struct BSTInsertLatencyOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = DYN_GENERATOR;
+	constexpr static bool need_nodes = true;
+	using NodeRandomizer = DYN_GENERATOR;
+};
+
+struct BSTDeleteLatencyOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = DYN_GENERATOR;
+	constexpr static bool need_node_pointers = true;
+	using NodePointerRandomizer = NodePointerRandomizerFor<MainRandomizer>;
+
+	constexpr static bool distinct = true;
+	constexpr static bool values_from_fixed = true;
+};
+
+struct BSTSearchLatencyOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = UseUniform;
+	constexpr static bool need_values = true;
+	using ValueRandomizer = DYN_GENERATOR;
+	constexpr static bool values_from_fixed = true;
+};
+
+template <class Fixture, class Node>
+void
+remove_node(Fixture & f, Node & n)
+{
+	if constexpr (std::is_same_v<typename Fixture::NodeInterface,
+	                             BoostSetInterface>) {
+		f.t.erase(n);
+	} else {
+		f.t.remove(n);
+	}
+}
+
+/*
+ * The measurements, shared by all trees
+ */
+template <class Fixture>
+void
+measure_insertion(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		for (auto & n : f.experiment_nodes) {
+			f.latencies.start();
+			f.t.insert(n);
+			f.latencies.stop();
+		}
+		state.SetIterationTime(c.get());
+
+		for (auto & n : f.experiment_nodes) {
+			remove_node(f, n);
+		}
+	}
+
+	f.latencies.report_and_reset(state);
+}
+
+template <class Fixture>
+void
+measure_bst_deletion(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		for (auto n : f.experiment_node_pointers) {
+			f.latencies.start();
+			remove_node(f, *n);
+			f.latencies.stop();
+		}
+		state.SetIterationTime(c.get());
+
+		for (auto n : f.experiment_node_pointers) {
+			f.t.insert(*n);
+		}
+	}
+
+	f.latencies.report_and_reset(state);
+}
+
+template <class Fixture>
+void
+measure_bst_search(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		for (auto val : f.experiment_values) {
+			f.latencies.start();
+			auto node = f.t.find(val);
+			benchmark::DoNotOptimize(node);
+			f.latencies.stop();
+		}
+		state.SetIterationTime(c.get());
+	}
+
+	f.latencies.report_and_reset(state);
+}
+
+template <class Fixture>
+void
+measure_dst_deletion(Fixture & f, benchmark::State & state)
+{
+	Clock c;
+	for (auto _ : state) {
+		c.start();
+		for (auto i : f.experiment_indices) {
+			f.latencies.start();
+			f.t.remove(f.fixed_nodes[i]);
+			f.latencies.stop();
+		}
+		state.SetIterationTime(c.get());
+
+		for (auto i : f.experiment_indices) {
+			f.t.insert(f.fixed_nodes[i]);
+		}
+	}
+
+	f.latencies.report_and_reset(state);
+}
+
+#define LATENCY_BENCHMARK(Fixture, Method, measure)                            \
+	BENCHMARK_DEFINE_F(Fixture, Method)                                          \
+	(benchmark::State & state) { measure(*this, state); }                        \
+	REGISTER(Fixture, Method)
+
+/*
+ * BST: Insertion, deletion and search for every tree
+ */
+#define BST_LATENCY_BENCHMARKS(Name, Interface)                                \
+	using InsertLatency##Name##BSTFixture =                                      \
+	    BSTFixture<Interface, InsertExperiment, BSTInsertLatencyOptions>;        \
+	LATENCY_BENCHMARK(InsertLatency##Name##BSTFixture, BM_BST_Insertion,         \
+	                  measure_insertion)                                         \
+	using DeleteLatency##Name##BSTFixture =                                      \
+	    BSTFixture<Interface, DeleteExperiment, BSTDeleteLatencyOptions>;        \
+	LATENCY_BENCHMARK(DeleteLatency##Name##BSTFixture, BM_BST_Deletion,          \
+	                  measure_bst_deletion)                                      \
+	using SearchLatency##Name##BSTFixture =                                      \
+	    BSTFixture<Interface, SearchExperiment, BSTSearchLatencyOptions>;        \
+	LATENCY_BENCHMARK(SearchLatency##Name##BSTFixture, BM_BST_Search,            \
+	                  measure_bst_search)
+
+BST_LATENCY_BENCHMARKS(YggRB, YggRBTreeInterface<BasicTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggRBSP, YggRBTreeInterface<RBSinglePassTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggWBTP, YggWBTreeInterface<WBTTwopassTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggWBSP, YggWBTreeInterface<WBTSinglepassTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggE, YggEnergyTreeInterface<BasicTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggZ, YggZTreeInterface<ZRandomTreeOptions>)
+BST_LATENCY_BENCHMARKS(YggBTree, YggBTreeIndexInterface<BTree32TreeOptions>)
+BST_LATENCY_BENCHMARKS(BISet, BoostSetInterface)
+
+/*
+ * DST: Insertion and deletion for every tree
+ */
+#define DST_LATENCY_BENCHMARKS(Name, Interface)                                \
+	using InsertLatency##Name##DSTFixture =                                      \
+	    DSTFixture<Interface, InsertExperiment, true, false, false, false>;      \
+	LATENCY_BENCHMARK(InsertLatency##Name##DSTFixture, BM_DST_Insertion,         \
+	                  measure_insertion)                                         \
+	using DeleteLatency##Name##DSTFixture =                                      \
+	    DSTFixture<Interface, DeleteExperiment, false, false, true, false>;      \
+	LATENCY_BENCHMARK(DeleteLatency##Name##DSTFixture, BM_DST_Deletion,          \
+	                  measure_dst_deletion)
+
+using ZHLatencyDSTInterface =
+    ZDSTInterface<BasicDSTTreeOptions,
+                  ygg::TreeFlags::ZTREE_RANK_HASH_UNIVERSALIZE_COEFFICIENT<
+                      16186402584962403883ul>,
+                  ygg::TreeFlags::ZTREE_USE_HASH>;
+using WB32LatencyDSTInterface =
+    WBDSTInterface<BasicDSTTreeOptions, ygg::TreeFlags::WBT_DELTA_NUMERATOR<3>,
+                   ygg::TreeFlags::WBT_DELTA_DENOMINATOR<1>,
+                   ygg::TreeFlags::WBT_GAMMA_NUMERATOR<2>,
+                   ygg::TreeFlags::WBT_GAMMA_DENOMINATOR<1>,
+                   ygg::TreeFlags::WBT_SINGLE_PASS>;
+
+DST_LATENCY_BENCHMARKS(RB, RBDSTInterface<BasicDSTTreeOptions>)
+DST_LATENCY_BENCHMARKS(ZH, ZHLatencyDSTInterface)
+DST_LATENCY_BENCHMARKS(WB32, WB32LatencyDSTInterface)
+
+#ifndef NOMAIN
+#include "main.hpp"
+#endif
+
+#endif
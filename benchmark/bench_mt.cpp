@@ -0,0 +1,541 @@
+/*
+ * YCSB-style multi-threaded throughput benchmarks.
+ *
+ * Every benchmark runs one of the workload mixes below with 1 to N threads
+ * (N being the number of hardware threads), all working on one shared
+ * structure that contains BASE_SIZE nodes. Keys are drawn from the Uniform,
+ * Zipf and Skewed generators in random.hpp, which select a node of the base
+ * set, whose key is then used. Hot keys are thus spread over the key space,
+ * just as with YCSB's hashed zipfian distribution.
+ *
+ * The single-threaded trees are protected by locks, either by a single lock
+ * around the whole tree or by splitting the keys into SHARD_COUNT shards (by
+ * hash), each of which is a tree with its own lock. The Concurrent Zip Tree is
+ * run without any locks. Its direct baseline is the Zip Tree behind a single
+ * lock, which is therefore also run on a write-only workload.
+ *
+ * Next to the throughput, every benchmark reports the latency percentiles of
+ * single operations (in nanoseconds) as well as the scaling efficiency, i.e.,
+ * the throughput divided by the number of threads times the single-threaded
+ * throughput.
+ */
+
+#include "../src/concurrent_ziptree.hpp"
+#include "common_bst.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+constexpr size_t BASE_SIZE = 1000000;
+constexpr size_t BATCH_SIZE = 1000;
+// Number of pre-generated operations every thread cycles through
+constexpr size_t OPERATION_COUNT = 100000;
+// Number of nodes every thread owns for writing. Half of them are in the tree.
+constexpr size_t WRITE_NODES = 1000;
+constexpr size_t MAX_SCAN_LENGTH = 100;
+constexpr size_t SHARD_COUNT = 16;
+constexpr unsigned int BASE_SEED = 42;
+
+std::atomic<unsigned int> next_seed(BASE_SEED + 1);
+
+/*
+ * Workload mixes. A write removes one of the thread's own nodes from the tree
+ * and inserts another one.
+ */
+// YCSB workload A: update heavy
+struct WorkloadA
+{
+	static constexpr unsigned int write_percent = 50;
+	static constexpr bool scans = false;
+};
+// YCSB workload B: read mostly
+struct WorkloadB
+{
+	static constexpr unsigned int write_percent = 5;
+	static constexpr bool scans = false;
+};
+// YCSB workload E: short ranges. Scans are up to MAX_SCAN_LENGTH long.
+struct WorkloadE
+{
+	static constexpr unsigned int write_percent = 5;
+	static constexpr bool scans = true;
+};
+// Not part of YCSB: Nothing but insertions and removals
+struct WorkloadW
+{
+	static constexpr unsigned int write_percent = 100;
+	static constexpr bool scans = false;
+};
+
+/*
+ * Single-threaded trees, protected by locks. With shards > 1, every key is
+ * assigned to one of the shards by its hash. Scans must then visit every
+ * shard and merge the results.
+ */
+template <class Interface, size_t shards, class Mutex>
+class LockedSubject {
+public:
+	using Node = typename Interface::Node;
+	using Tree = typename Interface::Tree;
+	static constexpr bool supports_scan = true;
+
+	LockedSubject()
+	{
+		std::mt19937 rng(BASE_SEED);
+		std::uniform_int_distribution<int> dist(0,
+		                                        std::numeric_limits<int>::max());
+		this->base.reserve(BASE_SIZE);
+		for (size_t i = 0; i < BASE_SIZE; ++i) {
+			this->base.push_back(Interface::create_node(dist(rng)));
+		}
+		for (auto & n : this->base) {
+			Interface::insert(this->shard_of(Interface::get_value(n)).t, n);
+		}
+	}
+
+	static Node
+	create_node(int key)
+	{
+		return Interface::create_node(key);
+	}
+
+	int
+	key_at(size_t index) const
+	{
+		return Interface::get_value(this->base[index]);
+	}
+
+	class Worker {
+	public:
+		explicit Worker(LockedSubject & s_in) : s(s_in)
+		{
+			this->gathered.reserve(shards * MAX_SCAN_LENGTH);
+		}
+
+		void
+		insert(Node & n)
+		{
+			Shard & shard = this->s.shard_of(Interface::get_value(n));
+			std::lock_guard<Mutex> lock(shard.m);
+			Interface::insert(shard.t, n);
+		}
+
+		void
+		remove(Node & n)
+		{
+			Shard & shard = this->s.shard_of(Interface::get_value(n));
+			std::lock_guard<Mutex> lock(shard.m);
+			shard.t.remove(n);
+		}
+
+		bool
+		find(int key)
+		{
+			Shard & shard = this->s.shard_of(key);
+			ReadLock lock(shard.m);
+			return shard.t.find(key) != shard.t.end();
+		}
+
+		// Returns the sum of the (at most) length smallest keys not less than key
+		int64_t
+		scan(int key, size_t length)
+		{
+			this->gathered.clear();
+			for (Shard & shard : this->s.shard_array) {
+				ReadLock lock(shard.m);
+				auto it = shard.t.lower_bound(key);
+				for (size_t i = 0; (i < length) && (it != shard.t.end()); ++i, ++it) {
+					this->gathered.push_back(Interface::get_value(*it));
+				}
+			}
+
+			if (this->gathered.size() > length) {
+				std::nth_element(this->gathered.begin(),
+				                 this->gathered.begin() +
+				                     static_cast<std::ptrdiff_t>(length),
+				                 this->gathered.end());
+				this->gathered.resize(length);
+			}
+
+			int64_t sum = 0;
+			for (int value : this->gathered) {
+				sum += value;
+			}
+			return sum;
+		}
+
+	private:
+		LockedSubject & s;
+		std::vector<int> gathered;
+	};
+
+	std::vector<Node> base;
+
+private:
+	// Readers share the lock if the mutex allows it
+	using ReadLock = std::conditional_t<std::is_same_v<Mutex, std::shared_mutex>,
+	                                    std::shared_lock<Mutex>,
+	                                    std::unique_lock<Mutex>>;
+
+	struct alignas(64) Shard
+	{
+		Mutex m;
+		Tree t;
+	};
+
+	Shard &
+	shard_of(int key)
+	{
+		if constexpr (shards == 1) {
+			(void)key;
+			return this->shard_array[0];
+		} else {
+			uint64_t h = static_cast<uint64_t>(static_cast<unsigned int>(key)) *
+			             0x9E3779B97F4A7C15ull;
+			return this->shard_array[static_cast<size_t>(h >> 32) % shards];
+		}
+	}
+
+	std::array<Shard, shards> shard_array;
+};
+
+/*
+ * The Concurrent Zip Tree. It has no range queries, thus it does not take part
+ * in the scan workload.
+ */
+class ConcurrentNode;
+using ConcurrentNodeOptions = ygg::TreeOptions<
+    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+    ygg::TreeFlags::ZTREE_RANK_HASH_MIX,
+    ygg::TreeFlags::ZTREE_HASHER_TYPE<ygg::ZTreeAddressHasher<ConcurrentNode>>>;
+
+class ConcurrentNode
+    : public ygg::ConcurrentZTreeNodeBase<ConcurrentNode,
+                                         ConcurrentNodeOptions> {
+public:
+	int key;
+
+	bool
+	operator<(const ConcurrentNode & other) const
+	{
+		return this->key < other.key;
+	}
+};
+
+bool
+operator<(const ConcurrentNode & lhs, int rhs)
+{
+	return lhs.key < rhs;
+}
+bool
+operator<(int lhs, const ConcurrentNode & rhs)
+{
+	return lhs < rhs.key;
+}
+
+class ConcurrentSubject {
+public:
+	using Node = ConcurrentNode;
+	using Tree =
+	    ygg::ConcurrentZTree<Node, ygg::ConcurrentZTreeDefaultNodeTraits<Node>,
+	                         ConcurrentNodeOptions>;
+	static constexpr bool supports_scan = false;
+
+	ConcurrentSubject() : base(BASE_SIZE)
+	{
+		std::mt19937 rng(BASE_SEED);
+		std::uniform_int_distribution<int> dist(0,
+		                                        std::numeric_limits<int>::max());
+		for (auto & n : this->base) {
+			n.key = dist(rng);
+		}
+		for (auto & n : this->base) {
+			this->t.insert(n);
+		}
+	}
+
+	static Node
+	create_node(int key)
+	{
+		Node n;
+		n.key = key;
+		return n;
+	}
+
+	int
+	key_at(size_t index) const
+	{
+		return this->base[index].key;
+	}
+
+	class Worker {
+	public:
+		explicit Worker(ConcurrentSubject & s_in)
+		    : s(s_in), handle(s_in.t.register_thread())
+		{}
+
+		void
+		insert(Node & n)
+		{
+			this->s.t.insert(n);
+		}
+
+		void
+		remove(Node & n)
+		{
+			this->s.t.remove(n, this->handle);
+		}
+
+		bool
+		find(int key)
+		{
+			auto guard = this->handle.pin();
+			return this->s.t.find(key) != nullptr;
+		}
+
+		int64_t
+		scan(int, size_t)
+		{
+			return 0;
+		}
+
+	private:
+		ConcurrentSubject & s;
+		Tree::ThreadHandle handle;
+	};
+
+	std::vector<Node> base;
+
+private:
+	Tree t;
+};
+
+template <class Subject>
+Subject &
+get_subject()
+{
+	// Shared by all threads of all runs. Every run leaves the tree as it found
+	// it.
+	static Subject subject;
+	return subject;
+}
+
+/*
+ * State that the threads of one run share for computing the statistics
+ */
+struct RunStats
+{
+	std::mutex m;
+	LatencyHistogram latencies;
+	std::atomic<int> merged{0};
+	// Throughput of the last single-threaded run, for the scaling efficiency
+	double single_thread_throughput = 0;
+};
+
+template <class Subject, class Workload, class Distribution>
+RunStats &
+get_run_stats()
+{
+	static RunStats stats;
+	return stats;
+}
+
+struct Operation
+{
+	enum class Kind { READ, SCAN, WRITE };
+	Kind kind;
+	int key;
+	unsigned int length;
+};
+
+template <class Subject, class Workload, class Distribution>
+static void
+BM_MT_Mix(benchmark::State & state)
+{
+	static_assert(Subject::supports_scan || !Workload::scans,
+	              "The subject can not run scans");
+	using Node = typename Subject::Node;
+
+	Subject & subject = get_subject<Subject>();
+	RunStats & stats = get_run_stats<Subject, Workload, Distribution>();
+	typename Subject::Worker worker(subject);
+
+	unsigned int seed = next_seed++;
+	auto rnd = Distribution::create(seed);
+	std::mt19937 rng(seed);
+	auto draw_key = [&]() {
+		size_t index = static_cast<size_t>(rnd.generate(0, BASE_SIZE)) % BASE_SIZE;
+		return subject.key_at(index);
+	};
+
+	// Generate all operations up front, such that the measurement does not
+	// include the random number generators.
+	std::vector<Operation> operations;
+	operations.reserve(OPERATION_COUNT);
+	for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+		Operation op;
+		if (rng() % 100 < Workload::write_percent) {
+			op.kind = Operation::Kind::WRITE;
+		} else if (Workload::scans) {
+			op.kind = Operation::Kind::SCAN;
+		} else {
+			op.kind = Operation::Kind::READ;
+		}
+		op.key = draw_key();
+		op.length = static_cast<unsigned int>(rng() % MAX_SCAN_LENGTH) + 1;
+		operations.push_back(op);
+	}
+
+	// Keys of nodes are never changed while they might be in use by concurrent
+	// readers. Instead, a write removes the oldest of the own nodes in the tree
+	// and inserts the oldest one that is not.
+	std::vector<Node> own;
+	own.reserve(WRITE_NODES);
+	for (size_t i = 0; i < WRITE_NODES; ++i) {
+		own.push_back(Subject::create_node(draw_key()));
+	}
+	for (size_t i = 0; i < WRITE_NODES / 2; ++i) {
+		worker.insert(own[i]);
+	}
+	size_t next_removed = 0;
+	size_t next_inserted = WRITE_NODES / 2;
+
+	if (state.thread_index() == 0) {
+		stats.latencies.clear();
+		stats.merged = 0;
+	}
+
+	LatencyHistogram latencies;
+	size_t op_index = 0;
+	int64_t result = 0;
+
+	auto started_at = std::chrono::steady_clock::now();
+	for (auto _ : state) {
+		for (size_t i = 0; i < BATCH_SIZE; ++i) {
+			const Operation & op = operations[op_index];
+			op_index = (op_index + 1) % OPERATION_COUNT;
+
+			auto op_started_at = std::chrono::steady_clock::now();
+			switch (op.kind) {
+			case Operation::Kind::READ:
+				result += worker.find(op.key);
+				break;
+			case Operation::Kind::SCAN:
+				result += worker.scan(op.key, op.length);
+				break;
+			case Operation::Kind::WRITE:
+				worker.remove(own[next_removed]);
+				worker.insert(own[next_inserted]);
+				next_removed = (next_removed + 1) % WRITE_NODES;
+				next_inserted = (next_inserted + 1) % WRITE_NODES;
+				break;
+			}
+			auto op_stopped_at = std::chrono::steady_clock::now();
+
+			latencies.record(static_cast<uint64_t>(
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(
+			        op_stopped_at - op_started_at)
+			        .count()));
+		}
+	}
+	auto stopped_at = std::chrono::steady_clock::now();
+	benchmark::DoNotOptimize(result);
+
+	{
+		std::lock_guard<std::mutex> lock(stats.m);
+		stats.latencies.merge(latencies);
+	}
+	stats.merged++;
+
+	// Thread 0 reports for all threads. The counters of all threads are summed
+	// up, so all others must leave them empty.
+	if (state.thread_index() == 0) {
+		while (stats.merged.load() < state.threads()) {
+			std::this_thread::yield();
+		}
+
+		double seconds = std::chrono::duration<double>(stopped_at - started_at)
+		                     .count();
+		double throughput =
+		    static_cast<double>(stats.latencies.count()) / seconds;
+		if (state.threads() == 1) {
+			stats.single_thread_throughput = throughput;
+		}
+
+		state.counters["ops/s"] = throughput;
+		state.counters["p50_ns"] =
+		    static_cast<double>(stats.latencies.percentile(0.5));
+		state.counters["p99_ns"] =
+		    static_cast<double>(stats.latencies.percentile(0.99));
+		state.counters["p999_ns"] =
+		    static_cast<double>(stats.latencies.percentile(0.999));
+		if (stats.single_thread_throughput > 0) {
+			state.counters["efficiency"] =
+			    throughput / (static_cast<double>(state.threads()) *
+			                  stats.single_thread_throughput);
+		}
+	}
+
+	for (size_t i = 0; i < WRITE_NODES / 2; ++i) {
+		worker.remove(own[(next_removed + i) % WRITE_NODES]);
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+	                        static_cast<int64_t>(BATCH_SIZE));
+}
+
+/*
+ * Subjects
+ */
+using RBInterface = YggRBTreeInterface<BasicTreeOptions>;
+using WBInterface = YggWBTreeInterface<WBTSinglepassTreeOptions>;
+using ZInterface = YggZTreeInterface<ZRandomTreeOptions>;
+using BTreeInterface = YggBTreeIndexInterface<BTree32TreeOptions>;
+
+using RBGlobalLock = LockedSubject<RBInterface, 1, std::mutex>;
+using RBGlobalRWLock = LockedSubject<RBInterface, 1, std::shared_mutex>;
+using RBSharded = LockedSubject<RBInterface, SHARD_COUNT, std::mutex>;
+using RBShardedRW = LockedSubject<RBInterface, SHARD_COUNT, std::shared_mutex>;
+using WBSharded = LockedSubject<WBInterface, SHARD_COUNT, std::mutex>;
+using ZGlobalLock = LockedSubject<ZInterface, 1, std::mutex>;
+using ZSharded = LockedSubject<ZInterface, SHARD_COUNT, std::mutex>;
+using BTreeSharded = LockedSubject<BTreeInterface, SHARD_COUNT, std::mutex>;
+
+#define REGISTER_MIX(SUBJECT, WORKLOAD, DISTRIBUTION)                          \
+	BENCHMARK_TEMPLATE(BM_MT_Mix, SUBJECT, WORKLOAD, DISTRIBUTION)               \
+	    ->ThreadRange(1, static_cast<int>(std::max(                             \
+	                         1u, std::thread::hardware_concurrency())))         \
+	    ->UseRealTime()
+
+#define REGISTER_DISTRIBUTIONS(SUBJECT, WORKLOAD)                              \
+	REGISTER_MIX(SUBJECT, WORKLOAD, UseUniform);                                 \
+	REGISTER_MIX(SUBJECT, WORKLOAD, UseZipf);                                    \
+	REGISTER_MIX(SUBJECT, WORKLOAD, UseSkewed)
+
+#define REGISTER_SUBJECT(SUBJECT)                                              \
+	REGISTER_DISTRIBUTIONS(SUBJECT, WorkloadB);                                  \
+	REGISTER_DISTRIBUTIONS(SUBJECT, WorkloadA);                                  \
+	REGISTER_DISTRIBUTIONS(SUBJECT, WorkloadE)
+
+REGISTER_SUBJECT(RBGlobalLock);
+REGISTER_SUBJECT(RBGlobalRWLock);
+REGISTER_SUBJECT(RBSharded);
+REGISTER_SUBJECT(RBShardedRW);
+REGISTER_SUBJECT(WBSharded);
+REGISTER_SUBJECT(ZGlobalLock);
+REGISTER_SUBJECT(ZSharded);
+REGISTER_SUBJECT(BTreeSharded);
+REGISTER_DISTRIBUTIONS(ZGlobalLock, WorkloadW);
+
+REGISTER_DISTRIBUTIONS(ConcurrentSubject, WorkloadB);
+REGISTER_DISTRIBUTIONS(ConcurrentSubject, WorkloadA);
+REGISTER_DISTRIBUTIONS(ConcurrentSubject, WorkloadW);
+
+BENCHMARK_MAIN();
@@ -4,18 +4,37 @@
 #include "benchmark_config.hpp"
 
 #include <algorithm>
+#include <array>
 #include <benchmark/benchmark.h>
 #include <boost/intrusive/set.hpp>
 #include <chrono>
+#include <cstdint>
 #include <draup.hpp>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 #ifdef USEPAPI
 #include <papi.h>
 #endif
 
+#ifdef USEPERF
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Draup Registration
 #define REGISTER(BaseClass, Method)                                            \
 	DRAUP_REGISTER(BaseClass##_##Method##_Benchmark)
@@ -31,9 +50,23 @@ constexpr auto insert_experiment_c = BOOST_HANA_STRING("Insert");
 using InsertExperiment = decltype(insert_experiment_c);
 constexpr auto search_experiment_c = BOOST_HANA_STRING("Search");
 using SearchExperiment = decltype(search_experiment_c);
+constexpr auto scan_experiment_c = BOOST_HANA_STRING("Scan");
+using ScanExperiment = decltype(scan_experiment_c);
+constexpr auto reverse_scan_experiment_c = BOOST_HANA_STRING("ReverseScan");
+using ReverseScanExperiment = decltype(reverse_scan_experiment_c);
+constexpr auto range_query_10_experiment_c = BOOST_HANA_STRING("RangeQuery10");
+using RangeQuery10Experiment = decltype(range_query_10_experiment_c);
+constexpr auto range_query_100_experiment_c =
+    BOOST_HANA_STRING("RangeQuery100");
+using RangeQuery100Experiment = decltype(range_query_100_experiment_c);
+constexpr auto range_query_1000_experiment_c =
+    BOOST_HANA_STRING("RangeQuery1000");
+using RangeQuery1000Experiment = decltype(range_query_1000_experiment_c);
 
 std::vector<std::string> PAPI_MEASUREMENTS;
 bool PAPI_STATS_WRITTEN;
+std::vector<std::string> PERF_MEASUREMENTS;
+std::string LATENCY_CSV;
 
 class Clock {
 public:
@@ -119,6 +152,24 @@ public:
 		PointerCountCallback::running = false;
 	}
 
+	// Number of pointer reads since the last reset()
+	static size_t
+	get_total_gets()
+	{
+		return PointerCountCallback::get_left_c +
+		       PointerCountCallback::get_right_c +
+		       PointerCountCallback::get_parent_c;
+	}
+
+	// Number of pointer writes since the last reset()
+	static size_t
+	get_total_sets()
+	{
+		return PointerCountCallback::set_left_c +
+		       PointerCountCallback::set_right_c +
+		       PointerCountCallback::set_parent_c;
+	}
+
 	static void
 	report(::benchmark::State & state)
 	{
@@ -255,6 +306,14 @@ public:
 #endif
 	}
 
+	// PAPI counts are reported per iteration, thus <operations> is ignored
+	void
+	report_and_reset(::benchmark::State & state, size_t operations)
+	{
+		(void)operations;
+		this->report_and_reset(state);
+	}
+
 	void
 	report_and_reset(::benchmark::State & state)
 	{
@@ -279,4 +338,482 @@ private:
 #endif
 };
 
+#ifdef USEPERF
+/*
+ * Hardware counters via Linux' perf_event_open, i.e., without libPAPI. The
+ * events can be selected with --perf (see main.hpp), the default being all
+ * PERF_EVENTS.
+ */
+struct PerfEvent
+{
+	const char * name;
+	uint32_t type;
+	uint64_t config;
+};
+
+constexpr uint64_t
+perf_read_miss_config(uint64_t cache)
+{
+	return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+	       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const PerfEvent PERF_EVENTS[] = {
+    {"CACHE_MISSES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"LLC_MISSES", PERF_TYPE_HW_CACHE,
+     perf_read_miss_config(PERF_COUNT_HW_CACHE_LL)},
+    {"DTLB_MISSES", PERF_TYPE_HW_CACHE,
+     perf_read_miss_config(PERF_COUNT_HW_CACHE_DTLB)},
+    {"BRANCH_MISSES", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"INSTRUCTIONS", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS}};
+
+/*
+ * The counters of this thread. They are opened once and shared by all
+ * fixtures, since the benchmarks run one after the other. All events form one
+ * group, i.e., the kernel schedules them onto the PMU together, and they all
+ * count the same instructions.
+ */
+class PerfCounterGroup {
+public:
+	static PerfCounterGroup &
+	get()
+	{
+		static PerfCounterGroup group;
+		return group;
+	}
+
+	const std::vector<std::string> &
+	get_names() const
+	{
+		return this->names;
+	}
+
+	void
+	start()
+	{
+		if (this->fds.empty()) {
+			return;
+		}
+		ioctl(this->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(this->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+
+	// Adds the counts since start() to accu
+	void
+	stop(std::vector<double> & accu)
+	{
+		if (this->fds.empty()) {
+			return;
+		}
+		ioctl(this->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		// Layout: nr, time_enabled, time_running, value[nr]
+		auto bytes = static_cast<ssize_t>(this->buffer.size() * sizeof(uint64_t));
+		if (read(this->fds[0], this->buffer.data(),
+		         this->buffer.size() * sizeof(uint64_t)) != bytes) {
+			return;
+		}
+
+		// If the PMU had to be multiplexed, extrapolate
+		double scale = 1.0;
+		if ((this->buffer[2] > 0) && (this->buffer[2] < this->buffer[1])) {
+			scale = static_cast<double>(this->buffer[1]) /
+			        static_cast<double>(this->buffer[2]);
+		}
+		for (size_t i = 0; i < this->fds.size(); ++i) {
+			accu[i] += static_cast<double>(this->buffer[3 + i]) * scale;
+		}
+	}
+
+	PerfCounterGroup(const PerfCounterGroup &) = delete;
+	PerfCounterGroup & operator=(const PerfCounterGroup &) = delete;
+
+private:
+	PerfCounterGroup()
+	{
+		for (const PerfEvent & event : PERF_EVENTS) {
+			if (!PERF_MEASUREMENTS.empty() &&
+			    (std::find(PERF_MEASUREMENTS.begin(), PERF_MEASUREMENTS.end(),
+			               event.name) == PERF_MEASUREMENTS.end())) {
+				continue;
+			}
+
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = event.type;
+			attr.config = event.config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+			                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			int group_fd = this->fds.empty() ? -1 : this->fds[0];
+			int fd = static_cast<int>(
+			    syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+			if (fd < 0) {
+				int error = errno;
+				std::cout << "!! perf event " << event.name
+				          << " not available: " << strerror(error) << "\n";
+				if ((error == EACCES) || (error == EPERM)) {
+					std::cout << "!! You most probably need to set "
+					             "/proc/sys/kernel/perf_event_paranoid to 2 or "
+					             "lower.\n";
+				}
+				continue;
+			}
+
+			std::cout << "## Registering perf event " << event.name << "\n";
+			this->fds.push_back(fd);
+			this->names.emplace_back(event.name);
+		}
+
+		for (const std::string & requested : PERF_MEASUREMENTS) {
+			if (std::none_of(std::begin(PERF_EVENTS), std::end(PERF_EVENTS),
+			                 [&](const PerfEvent & event) {
+				                 return requested == event.name;
+			                 })) {
+				std::cerr << "perf event " << requested << " not found!\n";
+				exit(-1);
+			}
+		}
+
+		this->buffer.resize(3 + this->fds.size());
+	}
+
+	~PerfCounterGroup()
+	{
+		for (int fd : this->fds) {
+			close(fd);
+		}
+	}
+
+	std::vector<int> fds;
+	std::vector<std::string> names;
+	std::vector<uint64_t> buffer;
+};
+
+class PerfMeasurements {
+public:
+	void
+	initialize()
+	{
+		this->event_count_accu.assign(
+		    PerfCounterGroup::get().get_names().size(), 0.0);
+	}
+
+	void
+	start()
+	{
+		PerfCounterGroup::get().start();
+	}
+
+	void
+	stop()
+	{
+		PerfCounterGroup::get().stop(this->event_count_accu);
+	}
+
+	// Counts are reported per operation, of which every iteration performs
+	// <operations>.
+	void
+	report_and_reset(::benchmark::State & state, size_t operations)
+	{
+		const auto & names = PerfCounterGroup::get().get_names();
+		double divisor = static_cast<double>(std::max(size_t{1}, operations));
+		for (size_t i = 0; i < names.size(); ++i) {
+			state.counters[names[i]] = ::benchmark::Counter(
+			    this->event_count_accu[i] / divisor,
+			    ::benchmark::Counter::Flags::kAvgIterations);
+		}
+		std::fill(this->event_count_accu.begin(), this->event_count_accu.end(),
+		          0.0);
+	}
+
+	// Most of the fixtures' benchmarks perform state.range(1) operations per
+	// iteration (see BuildRange()).
+	void
+	report_and_reset(::benchmark::State & state)
+	{
+		this->report_and_reset(
+		    state, static_cast<size_t>(std::max(int64_t{0}, state.range(1))));
+	}
+
+private:
+	std::vector<double> event_count_accu;
+};
+
+using HardwareCounters = PerfMeasurements;
+#else
+using HardwareCounters = PapiMeasurements;
+#endif
+
+/*
+ * Latency histogram with logarithmic buckets, each power of two being split
+ * into SUB_BUCKETS linear buckets (as in HdrHistogram). The relative error is
+ * thus below 1 / SUB_BUCKETS. The maximum is tracked exactly.
+ */
+class LatencyHistogram {
+public:
+	LatencyHistogram() : counts{}, total(0), max(0) {}
+
+	void
+	record(uint64_t value)
+	{
+		this->counts[bucket_of(value)]++;
+		this->total++;
+		this->max = std::max(this->max, value);
+	}
+
+	void
+	merge(const LatencyHistogram & other)
+	{
+		for (size_t i = 0; i < BUCKETS; ++i) {
+			this->counts[i] += other.counts[i];
+		}
+		this->total += other.total;
+		this->max = std::max(this->max, other.max);
+	}
+
+	void
+	clear()
+	{
+		this->counts.fill(0);
+		this->total = 0;
+		this->max = 0;
+	}
+
+	uint64_t
+	count() const
+	{
+		return this->total;
+	}
+
+	uint64_t
+	get_max() const
+	{
+		return this->max;
+	}
+
+	// Returns the (lower end of the) bucket that contains the given quantile
+	uint64_t
+	percentile(double quantile) const
+	{
+		uint64_t rank = static_cast<uint64_t>(quantile *
+		                                      static_cast<double>(this->total));
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BUCKETS; ++i) {
+			seen += this->counts[i];
+			if (seen > rank) {
+				return lower_end_of(i);
+			}
+		}
+		return lower_end_of(BUCKETS - 1);
+	}
+
+private:
+	static constexpr size_t SUB_BITS = 5;
+	static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BITS;
+	static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+
+	static size_t
+	bucket_of(uint64_t value)
+	{
+		if (value < SUB_BUCKETS) {
+			return static_cast<size_t>(value);
+		}
+		size_t magnitude =
+		    static_cast<size_t>(63 - __builtin_clzll(value)) - SUB_BITS;
+		size_t sub = static_cast<size_t>(value >> magnitude) - SUB_BUCKETS;
+		return std::min((magnitude + 1) * SUB_BUCKETS + sub, BUCKETS - 1);
+	}
+
+	static uint64_t
+	lower_end_of(size_t bucket)
+	{
+		if (bucket < SUB_BUCKETS) {
+			return bucket;
+		}
+		size_t magnitude = bucket / SUB_BUCKETS - 1;
+		uint64_t sub = bucket % SUB_BUCKETS;
+		return (SUB_BUCKETS + sub) << magnitude;
+	}
+
+	std::array<uint64_t, BUCKETS> counts;
+	uint64_t total;
+	uint64_t max;
+};
+
+/*
+ * Fine-grained timestamps for timing single operations. On x86, this reads
+ * the time stamp counter, fenced such that the timed instructions can not be
+ * moved across it. Ticks are converted to nanoseconds by comparing the counter
+ * to std::chrono::steady_clock once.
+ */
+class CycleClock {
+public:
+	static uint64_t
+	now()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		_mm_lfence();
+		uint64_t ticks = __rdtsc();
+		_mm_lfence();
+		return ticks;
+#else
+		return static_cast<uint64_t>(
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(
+		        std::chrono::steady_clock::now().time_since_epoch())
+		        .count());
+#endif
+	}
+
+	static double
+	get_ns_per_tick()
+	{
+		static double ns_per_tick = calibrate();
+		return ns_per_tick;
+	}
+
+	// The ticks that two back-to-back calls to now() take
+	static uint64_t
+	get_overhead()
+	{
+		static uint64_t overhead = measure_overhead();
+		return overhead;
+	}
+
+private:
+	static double
+	calibrate()
+	{
+		auto started_at = std::chrono::steady_clock::now();
+		uint64_t started_ticks = now();
+		while (std::chrono::steady_clock::now() - started_at <
+		       std::chrono::milliseconds(50)) {
+		}
+		uint64_t stopped_ticks = now();
+		auto stopped_at = std::chrono::steady_clock::now();
+
+		double ns = static_cast<double>(
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(stopped_at -
+		                                                         started_at)
+		        .count());
+		return ns / static_cast<double>(stopped_ticks - started_ticks);
+	}
+
+	static uint64_t
+	measure_overhead()
+	{
+		uint64_t overhead = std::numeric_limits<uint64_t>::max();
+		for (size_t i = 0; i < 1000; ++i) {
+			uint64_t started = now();
+			overhead = std::min(overhead, now() - started);
+		}
+		return overhead;
+	}
+};
+
+/*
+ * Records the latency of every single operation in a histogram. Reports the
+ * percentiles as user counters and, if --latency_csv is given (see main.hpp),
+ * also appends them to that CSV file.
+ */
+class LatencyRecorder {
+public:
+	void
+	initialize(std::string name_in)
+	{
+		this->name = std::move(name_in);
+		this->ticks.clear();
+		// Calibrate now rather than during the first measurement
+		CycleClock::get_ns_per_tick();
+		CycleClock::get_overhead();
+	}
+
+	void
+	start()
+	{
+		this->started = CycleClock::now();
+	}
+
+	void
+	stop()
+	{
+		uint64_t elapsed = CycleClock::now() - this->started;
+		uint64_t overhead = CycleClock::get_overhead();
+		this->ticks.record(elapsed > overhead ? elapsed - overhead : 0);
+	}
+
+	void
+	report_and_reset(::benchmark::State & state)
+	{
+		if (this->ticks.count() == 0) {
+			return;
+		}
+
+		const std::pair<const char *, double> percentiles[] = {
+		    {"p50_ns", 0.5},    {"p90_ns", 0.9},       {"p99_ns", 0.99},
+		    {"p999_ns", 0.999}, {"p9999_ns", 0.9999}};
+		std::vector<double> values;
+		for (const auto & [counter_name, quantile] : percentiles) {
+			values.push_back(to_ns(this->ticks.percentile(quantile)));
+			state.counters[counter_name] = values.back();
+		}
+		values.push_back(to_ns(this->ticks.get_max()));
+		state.counters["max_ns"] = values.back();
+
+		if (!LATENCY_CSV.empty()) {
+			std::ostringstream key;
+			key << this->name << "," << state.range(0) << "," << state.range(1)
+			    << "," << state.range(2);
+			std::ostringstream row;
+			row << key.str() << "," << this->ticks.count();
+			for (double value : values) {
+				row << "," << value;
+			}
+			write_csv_row(key.str(), row.str());
+		}
+
+		this->ticks.clear();
+	}
+
+private:
+	static double
+	to_ns(uint64_t ticks)
+	{
+		return static_cast<double>(ticks) * CycleClock::get_ns_per_tick();
+	}
+
+	// Google Benchmark runs every benchmark multiple times to determine the
+	// number of iterations. Only the last run of every configuration is kept,
+	// thus the file is rewritten after every run.
+	static void
+	write_csv_row(const std::string & key, std::string row)
+	{
+		static std::vector<std::pair<std::string, std::string>> rows;
+
+		auto it =
+		    std::find_if(rows.begin(), rows.end(),
+		                 [&](const auto & entry) { return entry.first == key; });
+		if (it != rows.end()) {
+			it->second = std::move(row);
+		} else {
+			rows.emplace_back(key, std::move(row));
+		}
+
+		std::ofstream out(LATENCY_CSV);
+		out << "name,base_size,experiment_size,seed,count,p50_ns,p90_ns,p99_ns,"
+		       "p999_ns,p9999_ns,max_ns\n";
+		for (const auto & entry : rows) {
+			out << entry.second << "\n";
+		}
+	}
+
+	std::string name;
+	LatencyHistogram ticks;
+	uint64_t started;
+};
+
 #endif
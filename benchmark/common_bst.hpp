@@ -14,6 +14,7 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -21,6 +22,11 @@
 #include <papi.h>
 #endif
 
+#ifdef USEPOOL
+#include "../src/node_pool.hpp"
+#include <boost/iterator/indirect_iterator.hpp>
+#endif
+
 #ifdef USEZIPF
 #define DYN_GENERATOR UseZipf
 #define PREFIX "<ZIPF>"
@@ -29,6 +35,14 @@
 #define DYN_GENERATOR UseSkewed
 #define PREFIX "<SKEWED>"
 #else
+#ifdef USESLIDING
+#define DYN_GENERATOR UseSlidingWindow
+#define PREFIX "<SLIDING>"
+#else
+#ifdef USEHOTSET
+#define DYN_GENERATOR UseHotSet
+#define PREFIX "<HOTSET>"
+#else
 #define DYN_GENERATOR UseUniform
 
 #ifdef PRESORT
@@ -38,6 +52,8 @@
 #endif
 #endif
 #endif
+#endif
+#endif
 
 struct UseNone
 {
@@ -87,10 +103,56 @@ struct UseSkewed
 	}
 };
 
-template <class T, class Compare = decltype(std::less<T>{})>
+// Ascending keys, like the timestamps of a time series
+struct UseSlidingWindow
+{
+	static constexpr bool enable = true;
+	using Randomizer = SlidingWindowDistr;
+	static constexpr int min = std::numeric_limits<int>::min();
+	static constexpr int max = std::numeric_limits<int>::max();
+
+	static Randomizer
+	create(long unsigned int seed)
+	{
+		return SlidingWindowDistr(seed, size_t{1} << 26, 16);
+	}
+};
+
+// 90% of the keys come from a hot range that moves every 1000 keys
+struct UseHotSet
+{
+	static constexpr bool enable = true;
+	using Randomizer = HotSetDistr;
+	static constexpr int min = std::numeric_limits<int>::min();
+	static constexpr int max = std::numeric_limits<int>::max();
+
+	static Randomizer
+	create(long unsigned int seed)
+	{
+		return HotSetDistr(seed, 0.01, 0.9, 1000);
+	}
+};
+
+// Selects node pointers in the order in which the nodes were inserted, i.e.,
+// oldest first. Only valid as NodePointerRandomizer.
+struct UseInsertionOrder
+{
+	static constexpr bool enable = true;
+};
+
+/* The node pointers to remove (or move) for a given main randomizer. A sliding
+ * window removes its oldest nodes, everything else removes uniformly random
+ * nodes. */
+template <class MainRandomizer>
+using NodePointerRandomizerFor =
+    std::conditional_t<std::is_same_v<MainRandomizer, UseSlidingWindow>,
+                       UseInsertionOrder, UseUniform>;
+
+template <class Container,
+          class Compare = std::less<typename Container::value_type>>
 void
-presort(std::vector<T> & v, size_t shuffle_count, size_t seed,
-        Compare cmp = std::less<T>{})
+presort(Container & v, size_t shuffle_count, size_t seed,
+        Compare cmp = Compare{})
 {
 	std::mt19937 rng(seed);
 
@@ -100,13 +162,80 @@ presort(std::vector<T> & v, size_t shuffle_count, size_t seed,
 	std::iota(indices.begin(), indices.end(), size_t{0});
 	std::shuffle(indices.begin(), indices.end(), rng);
 
-	T first_element = std::move(v[indices[0]]);
+	typename Container::value_type first_element = std::move(v[indices[0]]);
 	for (size_t i = 1; i < shuffle_count; ++i) {
 		v[indices[i - 1]] = std::move(v[indices[i]]);
 	}
 	v[indices[shuffle_count - 1]] = std::move(first_element);
 }
 
+#ifdef USEPOOL
+/*
+ * A vector-like container whose elements are allocated from a ygg::NodePool
+ * instead of being stored in one contiguous array.
+ */
+template <class T>
+class PooledNodeVector {
+public:
+	using value_type = T;
+	using iterator =
+	    boost::indirect_iterator<typename std::vector<T *>::iterator>;
+
+	PooledNodeVector() = default;
+	PooledNodeVector(const PooledNodeVector & other) = delete;
+	~PooledNodeVector() { this->clear(); }
+
+	void
+	push_back(T && element)
+	{
+		this->elements.push_back(this->pool.allocate(std::move(element)));
+	}
+
+	void
+	clear()
+	{
+		for (T * element : this->elements) {
+			this->pool.deallocate(element);
+		}
+		this->elements.clear();
+	}
+
+	size_t
+	size() const
+	{
+		return this->elements.size();
+	}
+
+	T &
+	operator[](size_t i)
+	{
+		return *this->elements[i];
+	}
+
+	iterator
+	begin()
+	{
+		return iterator(this->elements.begin());
+	}
+
+	iterator
+	end()
+	{
+		return iterator(this->elements.end());
+	}
+
+private:
+	ygg::NodePool<T> pool;
+	std::vector<T *> elements;
+};
+
+template <class T>
+using NodeVector = PooledNodeVector<T>;
+#else
+template <class T>
+using NodeVector = std::vector<T>;
+#endif
+
 struct DefaultBenchmarkOptions
 {
 	constexpr static bool distinct = false; // sets everything to be distinct
@@ -161,7 +290,8 @@ public:
 	initialize(size_t fixed_count, size_t experiment_count, int seed)
 	{
 		Interface::clear(this->t);
-		this->papi.initialize();
+		this->counters.initialize();
+		this->latencies.initialize(get_name());
 
 		this->rng = std::mt19937(static_cast<unsigned long>(seed));
 
@@ -248,37 +378,8 @@ public:
 		}
 
 		if constexpr (Options::need_node_pointers) {
-			auto rnd = Options::NodePointerRandomizer::create(rng());
-			std::unordered_set<size_t> seen_indices;
-			this->experiment_node_pointers.clear();
-
-			for (size_t i = 0; i < experiment_count; ++i) {
-				size_t rnd_index = static_cast<size_t>(
-				    rnd.generate(0, static_cast<int>(this->fixed_nodes.size())));
-				if (Options::distinct || Options::node_pointers_distinct) {
-					while (seen_indices.find(rnd_index) != seen_indices.end()) {
-						rnd_index = static_cast<size_t>(
-						    rnd.generate(0, static_cast<int>(this->fixed_nodes.size())));
-						assert(rnd_index < this->fixed_nodes.size());
-					}
-
-					seen_indices.insert(rnd_index);
-				}
-				auto node_ptr = &this->fixed_nodes[rnd_index];
-				this->experiment_node_pointers.push_back(node_ptr);
-			}
-
-			if constexpr (Options::pointers_presort) {
-				size_t presort_count = static_cast<size_t>(std::floor(
-				    static_cast<double>(this->experiment_node_pointers.size()) *
-				    Options::pointers_presort_fraction));
-				presort(this->experiment_node_pointers, presort_count, this->rng(),
-				        [](const typename Interface::Node * lhs,
-				           const typename Interface::Node * rhs) {
-					        return Interface::get_value(*lhs) <
-					               Interface::get_value(*rhs);
-				        });
-			}
+			this->create_node_pointers<typename Options::NodePointerRandomizer>(
+			    experiment_count);
 		}
 
 		if constexpr (Options::need_values) {
@@ -347,6 +448,56 @@ public:
 		}
 	}
 
+	template <class NodePointerRandomizer>
+	void
+	create_node_pointers(size_t experiment_count)
+	{
+		this->experiment_node_pointers.clear();
+
+		if constexpr (std::is_same_v<NodePointerRandomizer, UseInsertionOrder>) {
+			// Otherwise, the same node would have to be picked twice
+			assert(!(Options::distinct || Options::node_pointers_distinct) ||
+			       (experiment_count <= this->fixed_nodes.size()));
+
+			// The fixed nodes were inserted in order, oldest first
+			for (size_t i = 0; i < experiment_count; ++i) {
+				this->experiment_node_pointers.push_back(
+				    &this->fixed_nodes[i % this->fixed_nodes.size()]);
+			}
+		} else {
+			auto rnd = NodePointerRandomizer::create(this->rng());
+			std::unordered_set<size_t> seen_indices;
+
+			for (size_t i = 0; i < experiment_count; ++i) {
+				size_t rnd_index = static_cast<size_t>(
+				    rnd.generate(0, static_cast<int>(this->fixed_nodes.size())));
+				if (Options::distinct || Options::node_pointers_distinct) {
+					while (seen_indices.find(rnd_index) != seen_indices.end()) {
+						rnd_index = static_cast<size_t>(
+						    rnd.generate(0, static_cast<int>(this->fixed_nodes.size())));
+						assert(rnd_index < this->fixed_nodes.size());
+					}
+
+					seen_indices.insert(rnd_index);
+				}
+				auto node_ptr = &this->fixed_nodes[rnd_index];
+				this->experiment_node_pointers.push_back(node_ptr);
+			}
+
+			if constexpr (Options::pointers_presort) {
+				size_t presort_count = static_cast<size_t>(std::floor(
+				    static_cast<double>(this->experiment_node_pointers.size()) *
+				    Options::pointers_presort_fraction));
+				presort(this->experiment_node_pointers, presort_count, this->rng(),
+				        [](const typename Interface::Node * lhs,
+				           const typename Interface::Node * rhs) {
+					        return Interface::get_value(*lhs) <
+					               Interface::get_value(*rhs);
+				        });
+			}
+		}
+	}
+
 	void
 	TearDown(const ::benchmark::State & state)
 	{
@@ -355,15 +506,16 @@ public:
 	}
 
 	std::vector<int> fixed_values;
-	std::vector<typename Interface::Node> fixed_nodes;
+	NodeVector<typename Interface::Node> fixed_nodes;
 
-	std::vector<typename Interface::Node> experiment_nodes;
+	NodeVector<typename Interface::Node> experiment_nodes;
 	std::vector<int> experiment_values;
 	std::vector<typename Interface::Node *> experiment_node_pointers;
 
 	typename Interface::Tree t;
 
-	PapiMeasurements papi;
+	HardwareCounters counters;
+	LatencyRecorder latencies;
 	std::mt19937 rng;
 };
 
@@ -441,7 +593,14 @@ public:
 			pf = ",pf";
 		}
 
-		return std::string("RBTree[") + avc + cc + pf + std::string("]");
+		std::string sp = "";
+#ifndef NO_RBT_SINGLE_PASS
+		if constexpr (MyTreeOptions::rbt_single_pass) {
+			sp = ",sp";
+		}
+#endif
+
+		return std::string("RBTree[") + avc + cc + pf + sp + std::string("]");
 	}
 
 	static int
@@ -719,8 +878,18 @@ public:
 		if (MyTreeOptions::ztree_universalize_multiply) {
 			universalize = ",UM";
 		}
+#ifndef NO_ZTREE_RANK_HASH_MIX
+		if (MyTreeOptions::ztree_rank_hash_mix) {
+			universalize += ",MIX";
+		}
+#endif
 
-		return "ZipTree[" + randomness + universalize + "]";
+		std::string stored = "";
+		if (MyTreeOptions::ztree_use_hash && MyTreeOptions::ztree_store_rank) {
+			stored = ",S";
+		}
+
+		return "ZipTree[" + randomness + universalize + stored + "]";
 	}
 
 	static void
@@ -735,6 +904,12 @@ public:
 		return n.get_value();
 	}
 
+	static void
+	set_value(Node & n, int val)
+	{
+		n.set_value(val);
+	}
+
 	static Node
 	create_node(int val)
 	{
@@ -760,6 +935,86 @@ struct hash<ZipNode<T>>
 };
 } // namespace std
 
+/*
+ * B-Tree Index Interface
+ */
+#ifndef NO_BTREE_INDEX
+class BTNode {
+private:
+	int value;
+
+public:
+	BTNode(int value_in) : value(value_in){};
+
+	void
+	set_value(int new_value)
+	{
+		this->value = new_value;
+	}
+
+	int
+	get_value() const
+	{
+		return this->value;
+	}
+};
+
+class BTNodeTraits : public ygg::BTreeIndexNodeTraits<BTNode> {
+public:
+	using key_type = int;
+
+	static int
+	get_key(const BTNode & n)
+	{
+		return n.get_value();
+	}
+};
+
+template <class MyTreeOptions>
+class YggBTreeIndexInterface {
+public:
+	using Node = BTNode;
+	using Tree = ygg::BTreeIndex<Node, BTNodeTraits, MyTreeOptions>;
+
+	static void
+	insert(Tree & t, Node & n)
+	{
+		t.insert(n);
+	}
+
+	static std::string
+	get_name()
+	{
+		return std::string("BTreeIndex[") +
+		       std::to_string(MyTreeOptions::btree_node_keys) + std::string("]");
+	}
+
+	static int
+	get_value(const Node & n)
+	{
+		return n.get_value();
+	}
+
+	static void
+	set_value(Node & n, int val)
+	{
+		n.set_value(val);
+	}
+
+	static Node
+	create_node(int val)
+	{
+		return Node(val);
+	}
+
+	static void
+	clear(Tree & t)
+	{
+		t.clear();
+	}
+};
+#endif // NO_BTREE_INDEX
+
 /*
  * Boost::Intrusive::Set Interface
  */
@@ -879,6 +1134,10 @@ using RBColorCompressTreeOptions =
     ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::COMPRESS_COLOR>;
 using RBPrefetchTreeOptions =
     ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::MICRO_PREFETCH>;
+#ifndef NO_RBT_SINGLE_PASS
+using RBSinglePassTreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::RBT_SINGLE_PASS>;
+#endif
 
 /* Variants of the zip tree */
 using ZRandomTreeOptions =
@@ -890,6 +1149,28 @@ using ZUnivHashTreeOptions =
     ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
                      ygg::TreeFlags::ZTREE_RANK_HASH_UNIVERSALIZE_COEFFICIENT<
                          9859957398433823229ul>>;
+#ifndef NO_ZTREE_RANK_HASH_MIX
+using ZMixHashTreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+                     ygg::TreeFlags::ZTREE_RANK_HASH_MIX>;
+using ZMixHashStoredTreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+                     ygg::TreeFlags::ZTREE_RANK_HASH_MIX,
+                     ygg::TreeFlags::ZTREE_RANK_TYPE<std::uint8_t>>;
+#endif
+
+/* Variants of the B-tree index */
+#ifndef NO_BTREE_INDEX
+using BTree16TreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::BTREE_NODE_KEYS<16>>;
+using BTree32TreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::BTREE_NODE_KEYS<32>>;
+using BTree64TreeOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::BTREE_NODE_KEYS<64>>;
+#endif
 
 /* Variants of the weight-balanced tree */
 using WBTTwopassTreeOptions = ygg::TreeOptions<ygg::TreeFlags::MULTIPLE>;
@@ -40,11 +40,20 @@ public:
 	void
 	SetUp(const ::benchmark::State & state)
 	{
-		this->papi.initialize();
-
 		size_t fixed_count = static_cast<size_t>(state.range(0));
 		size_t experiment_count = static_cast<size_t>(state.range(1));
 		int seed = static_cast<int>(state.range(2));
+
+		this->initialize(fixed_count, experiment_count, seed);
+	}
+
+	void
+	initialize(size_t fixed_count, size_t experiment_count, int seed)
+	{
+		Interface::clear(this->t);
+		this->counters.initialize();
+		this->latencies.initialize(get_name());
+
 		this->rng = std::mt19937(static_cast<unsigned long>(seed));
 
 		std::uniform_int_distribution<> point_distr(
@@ -147,7 +156,8 @@ public:
 
 	typename Interface::Tree t;
 
-	PapiMeasurements papi;
+	HardwareCounters counters;
+	LatencyRecorder latencies;
 };
 
 // TODO try with max combiner!
@@ -0,0 +1,325 @@
+/*
+ * Memory footprint of the different tree configurations.
+ *
+ * For every configuration, this reports the size of the node base class that
+ * the tree adds to each node, the size of the tree object itself, the resident
+ * memory used by n nodes and the average number of nodes visited and distinct
+ * cache lines touched per find().
+ *
+ * Cache lines are recorded with a BENCHMARK_POINTER_GET_CALLBACK that is passed
+ * the address of every node whose pointers are read. A visited node counts all
+ * cache lines it spans.
+ *
+ * Usage: footprint [node count] [query count] [seed] [output csv]
+ */
+
+#include "common_bst.hpp"
+#include "common_dst.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <random>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+class CacheLineRecorder {
+public:
+	static void
+	get_left(const void * node)
+	{
+		CacheLineRecorder::record(node);
+	}
+	static void
+	get_right(const void * node)
+	{
+		CacheLineRecorder::record(node);
+	}
+	static void
+	get_parent(const void * node)
+	{
+		CacheLineRecorder::record(node);
+	}
+
+	static void
+	record(const void * node)
+	{
+		if (CacheLineRecorder::running) {
+			CacheLineRecorder::visited.push_back(node);
+		}
+	}
+
+	static bool running;
+	static std::vector<const void *> visited;
+};
+bool CacheLineRecorder::running = false;
+std::vector<const void *> CacheLineRecorder::visited;
+
+using RecordingFlag =
+    ygg::TreeFlags::BENCHMARK_POINTER_GET_CALLBACK<CacheLineRecorder>;
+
+// Resident set size of this process, in bytes
+size_t
+get_resident_bytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t total = 0;
+	size_t resident = 0;
+	statm >> total >> resident;
+	return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+struct FootprintResult
+{
+	std::string name;
+	size_t base_size;
+	size_t node_size;
+	size_t tree_size;
+	size_t resident_bytes;
+	double nodes_per_find;
+	double lines_per_find;
+};
+
+/* The nodes are stored contiguously, as in the other benchmarks. The storage is
+ * large enough to be allocated by mmap, thus the resident memory is returned to
+ * the system once a configuration is done. */
+template <class Interface, class NodeBase>
+FootprintResult
+measure_bst(std::string suffix, size_t count, size_t queries,
+            std::mt19937 & rng)
+{
+	using Node = typename Interface::Node;
+	using Tree = typename Interface::Tree;
+
+	FootprintResult result;
+	result.name = Interface::get_name() + suffix;
+	result.base_size = sizeof(NodeBase);
+	result.node_size = sizeof(Node);
+	result.tree_size = sizeof(Tree);
+
+	std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+
+	size_t resident_before = get_resident_bytes();
+	std::vector<Node> nodes;
+	nodes.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		nodes.push_back(Interface::create_node(dist(rng)));
+	}
+
+	Tree t;
+	for (auto & n : nodes) {
+		Interface::insert(t, n);
+	}
+	result.resident_bytes = get_resident_bytes() - resident_before;
+
+	std::uniform_int_distribution<size_t> query_dist(0, count - 1);
+	size_t visited_sum = 0;
+	size_t lines_sum = 0;
+	std::set<const void *> visited;
+	std::set<uintptr_t> lines;
+	for (size_t i = 0; i < queries; ++i) {
+		int query = Interface::get_value(nodes[query_dist(rng)]);
+
+		CacheLineRecorder::visited.clear();
+		CacheLineRecorder::running = true;
+		auto it = t.find(query);
+		CacheLineRecorder::running = false;
+
+		// The found node's key is read, but none of its pointers
+		if (it != t.end()) {
+			CacheLineRecorder::visited.push_back(&*it);
+		}
+
+		visited.clear();
+		lines.clear();
+		for (const void * node : CacheLineRecorder::visited) {
+			if (!visited.insert(node).second) {
+				continue;
+			}
+			auto address = reinterpret_cast<uintptr_t>(node);
+			for (uintptr_t line = address / CACHE_LINE_SIZE;
+			     line <= (address + sizeof(Node) - 1) / CACHE_LINE_SIZE; ++line) {
+				lines.insert(line);
+			}
+		}
+
+		visited_sum += visited.size();
+		lines_sum += lines.size();
+	}
+
+	result.nodes_per_find =
+	    static_cast<double>(visited_sum) / static_cast<double>(queries);
+	result.lines_per_find =
+	    static_cast<double>(lines_sum) / static_cast<double>(queries);
+
+	return result;
+}
+
+/* The dynamic segment tree does not offer find(), only the sizes are reported.
+ * Every node contains two inner nodes, one for each interval border. */
+template <class Interface>
+FootprintResult
+measure_dst()
+{
+	using Node = typename Interface::Node;
+
+	FootprintResult result;
+	result.name = std::string("DST:") + Interface::get_name();
+	result.base_size = 2 * sizeof(typename Node::InnerNode);
+	result.node_size = sizeof(Node);
+	result.tree_size = sizeof(typename Interface::Tree);
+	result.resident_bytes = 0;
+	result.nodes_per_find = 0;
+	result.lines_per_find = 0;
+
+	return result;
+}
+
+/*
+ * The configurations
+ */
+using RBFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, RecordingFlag>;
+using RBCCFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::COMPRESS_COLOR,
+                     RecordingFlag>;
+using RBCTSFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::CONSTANT_TIME_SIZE, RecordingFlag>;
+using WBTPFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, RecordingFlag>;
+using WBSPFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::WBT_SINGLE_PASS,
+                     RecordingFlag>;
+using ZRank8FootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::ZTREE_RANK_TYPE<std::uint8_t>,
+                     RecordingFlag>;
+using ZRank64FootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE,
+                     ygg::TreeFlags::ZTREE_RANK_TYPE<std::uint64_t>,
+                     RecordingFlag>;
+using ZHashFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+                     RecordingFlag>;
+using ZHashStoredFootprintOptions =
+    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+                     ygg::TreeFlags::ZTREE_RANK_TYPE<std::uint8_t>,
+                     RecordingFlag>;
+
+using ZHFootprintDSTInterface =
+    ZDSTInterface<BasicDSTTreeOptions, ygg::TreeFlags::ZTREE_USE_HASH>;
+
+template <class Options>
+using RBBase = ygg::RBTreeNodeBase<RBNode<Options>, Options>;
+template <class Options>
+using WBBase = ygg::WBTreeNodeBase<WBNode<Options>, Options>;
+template <class Options>
+using ZBase = ygg::ZTreeNodeBase<ZipNode<Options>, Options>;
+
+void
+print_result(const FootprintResult & r, size_t count, std::ostream & os)
+{
+	std::cout << std::left << std::setw(34) << r.name << std::right
+	          << std::setw(6) << r.base_size << std::setw(6) << r.node_size
+	          << std::setw(6) << r.tree_size << std::setw(14) << r.resident_bytes
+	          << std::setw(10) << std::fixed << std::setprecision(2)
+	          << r.nodes_per_find << std::setw(10) << r.lines_per_find << "\n";
+
+	os << r.name << "," << r.base_size << "," << r.node_size << ","
+	   << r.tree_size << "," << count << "," << r.resident_bytes << ","
+	   << r.nodes_per_find << "," << r.lines_per_find << "\n";
+}
+
+int
+main(int argc, char ** argv)
+{
+	size_t count = 1000000;
+	size_t queries = 10000;
+	unsigned long seed = 4;
+	std::string output = "footprint.csv";
+
+	if (argc > 1) {
+		count = static_cast<size_t>(std::atol(argv[1]));
+	}
+	if (argc > 2) {
+		queries = static_cast<size_t>(std::atol(argv[2]));
+	}
+	if (argc > 3) {
+		seed = static_cast<unsigned long>(std::atol(argv[3]));
+	}
+	if (argc > 4) {
+		output = argv[4];
+	}
+
+	if (count == 0 || queries == 0) {
+		std::cerr << "Usage: " << argv[0]
+		          << " [node count] [query count] [seed] [output csv]\n";
+		exit(-1);
+	}
+
+#ifdef __GLIBC__
+	// Otherwise, glibc raises the threshold after the first configuration and
+	// reuses the memory that is already resident.
+	mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+#endif
+
+	std::mt19937 rng(static_cast<std::mt19937::result_type>(seed));
+	std::vector<FootprintResult> results;
+
+	results.push_back(
+	    measure_bst<YggRBTreeInterface<RBFootprintOptions>,
+	                RBBase<RBFootprintOptions>>("", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggRBTreeInterface<RBCCFootprintOptions>,
+	                RBBase<RBCCFootprintOptions>>("", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggRBTreeInterface<RBCTSFootprintOptions>,
+	                RBBase<RBCTSFootprintOptions>>("[cts]", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggWBTreeInterface<WBTPFootprintOptions>,
+	                WBBase<WBTPFootprintOptions>>("", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggWBTreeInterface<WBSPFootprintOptions>,
+	                WBBase<WBSPFootprintOptions>>("", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggZTreeInterface<ZRank8FootprintOptions>,
+	                ZBase<ZRank8FootprintOptions>>("[8]", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggZTreeInterface<ZRank64FootprintOptions>,
+	                ZBase<ZRank64FootprintOptions>>("[64]", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggZTreeInterface<ZHashFootprintOptions>,
+	                ZBase<ZHashFootprintOptions>>("", count, queries, rng));
+	results.push_back(
+	    measure_bst<YggZTreeInterface<ZHashStoredFootprintOptions>,
+	                ZBase<ZHashStoredFootprintOptions>>("[8]", count, queries,
+	                                                    rng));
+
+	results.push_back(measure_dst<RBDSTInterface<BasicDSTTreeOptions>>());
+	results.push_back(measure_dst<ZHFootprintDSTInterface>());
+	results.push_back(measure_dst<WBDSTInterface<BasicDSTTreeOptions>>());
+
+	std::ofstream os(output);
+	os << "name,base_size,node_size,tree_size,count,resident_bytes,nodes_per_"
+	      "find,lines_per_find\n";
+
+	std::cout << std::left << std::setw(34) << "Configuration" << std::right
+	          << std::setw(6) << "Base" << std::setw(6) << "Node" << std::setw(6)
+	          << "Tree" << std::setw(14) << "Resident" << std::setw(10)
+	          << "Nodes" << std::setw(10) << "Lines"
+	          << "\n";
+	for (const auto & r : results) {
+		print_result(r, count, os);
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Writes the compact trace of a workload from workload.hpp, to be replayed by
+ * the replay benchmark.
+ *
+ * Usage: generate_workload <sliding|hotset> <u32|u64|string> <operations>
+ *                          <size> <output> [seed]
+ *
+ * For the sliding window, <size> is the size of the window and <operations>
+ * the number of insertions. For the hot set, <size> is the number of entries
+ * and <operations> the number of replacements.
+ */
+
+#include "workload.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+template <class KeyT>
+void
+write_workload(const std::string & workload, size_t operations, size_t size,
+               const std::string & output, unsigned long seed)
+{
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<KeyT>;
+	typename BSS::CompactWriter writer(output);
+
+	if (workload == "sliding") {
+		// One event per microsecond, recorded up to 50 microseconds late
+		SlidingWindowWorkload<KeyT> generator(size, 0.5, 1000, 50000, seed);
+		generator.generate(operations, writer);
+	} else {
+		// 90% of new keys come from 1% of the key space, which moves every
+		// 10000 keys
+		HotSetWorkload<KeyT> generator(size, 0.01, 0.9, 10000, 0.5, seed);
+		generator.generate(operations, writer);
+	}
+}
+
+int
+main(int argc, char ** argv)
+{
+	if (argc < 6) {
+		std::cerr << "Usage: " << argv[0]
+		          << " <sliding|hotset> <u32|u64|string> <operations> <size> "
+		             "<output> [seed]\n";
+		exit(-1);
+	}
+
+	std::string workload = argv[1];
+	std::string key_type = argv[2];
+	size_t operations = static_cast<size_t>(std::atol(argv[3]));
+	size_t size = static_cast<size_t>(std::atol(argv[4]));
+	std::string output = argv[5];
+	unsigned long seed = 4;
+	if (argc > 6) {
+		seed = static_cast<unsigned long>(std::atol(argv[6]));
+	}
+
+	if (((workload != "sliding") && (workload != "hotset")) || (size == 0)) {
+		std::cerr << "Unknown workload or empty size.\n";
+		exit(-1);
+	}
+
+	if (key_type == "u32") {
+		write_workload<unsigned int>(workload, operations, size, output, seed);
+	} else if (key_type == "u64") {
+		write_workload<std::uint64_t>(workload, operations, size, output, seed);
+	} else if (key_type == "string") {
+		write_workload<WorkloadStringKey>(workload, operations, size, output,
+		                                  seed);
+	} else {
+		std::cerr << "Unknown key type " << key_type << "\n";
+		exit(-1);
+	}
+
+	return 0;
+}
@@ -85,6 +85,21 @@ main(int argc, char ** argv)
 				tok = strtok(NULL, ",");
 			}
 
+			i += 1;
+			remaining_argc -= 2;
+		} else if (strncmp(argv[i], "--perf", strlen("--perf")) == 0) {
+			char * tok = strtok(argv[i + 1], ",");
+
+			while (tok != NULL) {
+				PERF_MEASUREMENTS.emplace_back(tok);
+				tok = strtok(NULL, ",");
+			}
+
+			i += 1;
+			remaining_argc -= 2;
+		} else if (strncmp(argv[i], "--latency_csv", strlen("--latency_csv")) ==
+		           0) {
+			LATENCY_CSV = argv[i + 1];
 			i += 1;
 			remaining_argc -= 2;
 		} else if (strncmp(argv[i], "--doublings", strlen("--doublings")) == 0) {
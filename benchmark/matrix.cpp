@@ -0,0 +1,628 @@
+/*
+ * The BST benchmark matrix in a single binary.
+ *
+ * The run_all targets fix the key distribution and the counters at compile
+ * time, such that every combination is a binary of its own. Here, the cross
+ * product of operations, trees, key distributions and counters is expanded at
+ * compile time from the type lists below, and the configurations to run are
+ * selected at runtime.
+ *
+ * Every configuration is run for all base sizes and seeds. These jobs are
+ * independent of each other and each runs in a freshly forked worker process,
+ * which is pinned to a core of its own. The workers are processes rather
+ * than threads since the key generators and pointer counters have static
+ * state, which must not carry over from one job to the next. At most one
+ * worker runs per available core, larger values for --jobs are clamped.
+ *
+ * Configurations are named "BST :: <Operation> :: <Tree> :: <Distribution> ::
+ * <Counters>". With the Pointers counters, the trees also count how many
+ * pointers they read and write per operation, which slows them down.
+ *
+ * Usage: matrix [--list] [--filter <regex>] [--jobs <n>] [--base-size <n>]
+ *               [--doublings <n>] [--experiment-size <n>] [--seeds <n>]
+ *               [--iterations <n>] [--csv <file>]
+ */
+
+#include "paired.hpp"
+
+#include "common_bst.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <poll.h>
+#include <regex>
+#include <sched.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+template <class... Ts>
+struct TypeList
+{
+};
+
+/*
+ * Trees. The counters may add flags to the tree options. Trees that are not
+ * countable are only measured with the Time counters.
+ */
+struct RBTreeEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggRBTreeInterface<
+	    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, Flags...>>;
+};
+
+struct RBTreeSPEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggRBTreeInterface<ygg::TreeOptions<
+	    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::RBT_SINGLE_PASS, Flags...>>;
+};
+
+struct WBTreeTPEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggWBTreeInterface<
+	    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, Flags...>>;
+};
+
+struct WBTreeSPEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggWBTreeInterface<ygg::TreeOptions<
+	    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::WBT_SINGLE_PASS, Flags...>>;
+};
+
+// The energy-balanced tree does not use the pointer callbacks
+struct EnergyTreeEntry
+{
+	static constexpr bool countable = false;
+	template <class... Flags>
+	using Interface = YggEnergyTreeInterface<
+	    ygg::TreeOptions<ygg::TreeFlags::MULTIPLE, Flags...>>;
+};
+
+struct ZTreeRandomEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggZTreeInterface<ygg::TreeOptions<
+	    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_RANK_TYPE<std::uint8_t>,
+	    Flags...>>;
+};
+
+struct ZTreeMixHashEntry
+{
+	static constexpr bool countable = true;
+	template <class... Flags>
+	using Interface = YggZTreeInterface<ygg::TreeOptions<
+	    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::ZTREE_USE_HASH,
+	    ygg::TreeFlags::ZTREE_RANK_HASH_MIX, Flags...>>;
+};
+
+// Neither does the B-tree
+struct BTree32Entry
+{
+	static constexpr bool countable = false;
+	template <class... Flags>
+	using Interface = YggBTreeIndexInterface<ygg::TreeOptions<
+	    ygg::TreeFlags::MULTIPLE, ygg::TreeFlags::BTREE_NODE_KEYS<32>, Flags...>>;
+};
+
+/*
+ * Operations
+ */
+struct InsertOperation
+{
+	using Experiment = InsertExperiment;
+	template <class Distribution>
+	using Options = TrialInsertOptions<Distribution>;
+	using Executor = InsertExecutor;
+};
+
+struct DeleteOperation
+{
+	using Experiment = DeleteExperiment;
+	template <class Distribution>
+	using Options = TrialDeleteOptions<Distribution>;
+	using Executor = DeleteExecutor;
+};
+
+struct SearchOperation
+{
+	using Experiment = SearchExperiment;
+	template <class Distribution>
+	using Options = TrialSearchOptions<Distribution>;
+	using Executor = SearchExecutor;
+};
+
+/*
+ * Counters
+ */
+struct TimeCounters
+{
+	static constexpr const char * name = "Time";
+	static constexpr bool count_pointers = false;
+	template <class Entry>
+	using Interface = typename Entry::template Interface<>;
+};
+
+struct PointerCounters
+{
+	static constexpr const char * name = "Pointers";
+	static constexpr bool count_pointers = true;
+	template <class Entry>
+	using Interface = typename Entry::template Interface<
+	    ygg::TreeFlags::BENCHMARK_POINTER_GET_CALLBACK<PointerCountCallback>,
+	    ygg::TreeFlags::BENCHMARK_POINTER_SET_CALLBACK<PointerCountCallback>>;
+};
+
+/*
+ * The matrix
+ */
+using Operations = TypeList<InsertOperation, DeleteOperation, SearchOperation>;
+using Trees = TypeList<RBTreeEntry, RBTreeSPEntry, WBTreeTPEntry, WBTreeSPEntry,
+                       EnergyTreeEntry, ZTreeRandomEntry, ZTreeMixHashEntry,
+                       BTree32Entry>;
+using Distributions = TypeList<UseUniform, UseZipf, UseSkewed,
+                               UseSlidingWindow, UseHotSet>;
+using Counters = TypeList<TimeCounters, PointerCounters>;
+
+// All values are per operation
+struct JobResult
+{
+	double nanoseconds;
+	double pointer_gets;
+	double pointer_sets;
+};
+
+struct Configuration
+{
+	std::string name;
+	std::function<JobResult(size_t, size_t, int, size_t)> run;
+};
+
+template <class Operation, class Entry, class Distribution, class Counter>
+void
+add_configuration(std::vector<Configuration> & configurations)
+{
+	if constexpr (!Counter::count_pointers || Entry::countable) {
+		using Interface = typename Counter::template Interface<Entry>;
+		using Fixture =
+		    BSTFixture<Interface, typename Operation::Experiment,
+		               typename Operation::template Options<Distribution>>;
+		using Executor = typename Operation::Executor;
+
+		std::string name = Fixture::get_name() + " :: " +
+		                   Distribution::create(0).get_name() + " :: " +
+		                   Counter::name;
+
+		configurations.push_back(
+		    {name, [](size_t base_size, size_t experiment_size, int seed,
+		              size_t inner_iterations) {
+			     // Fixtures can be large, keep them off the stack
+			     auto f = std::make_unique<TrialFixture<Fixture>>();
+			     f->initialize(base_size, experiment_size, seed);
+
+			     double operations =
+			         static_cast<double>(inner_iterations * experiment_size);
+			     JobResult result{
+			         f->template run<Executor>(inner_iterations) / operations, 0,
+			         0};
+
+			     if constexpr (Counter::count_pointers) {
+				     PointerCountCallback::reset();
+				     PointerCountCallback::start();
+				     Executor::run(*f);
+				     PointerCountCallback::stop();
+				     Executor::revert(*f);
+
+				     result.pointer_gets =
+				         static_cast<double>(PointerCountCallback::get_total_gets()) /
+				         static_cast<double>(experiment_size);
+				     result.pointer_sets =
+				         static_cast<double>(PointerCountCallback::get_total_sets()) /
+				         static_cast<double>(experiment_size);
+			     }
+
+			     return result;
+		     }});
+	}
+}
+
+template <class Operation, class Entry, class Distribution, class... Cs>
+void
+add_counters(std::vector<Configuration> & configurations, TypeList<Cs...>)
+{
+	(add_configuration<Operation, Entry, Distribution, Cs>(configurations), ...);
+}
+
+template <class Operation, class Entry, class... Ds>
+void
+add_distributions(std::vector<Configuration> & configurations, TypeList<Ds...>)
+{
+	(add_counters<Operation, Entry, Ds>(configurations, Counters{}), ...);
+}
+
+template <class Operation, class... Es>
+void
+add_trees(std::vector<Configuration> & configurations, TypeList<Es...>)
+{
+	(add_distributions<Operation, Es>(configurations, Distributions{}), ...);
+}
+
+template <class... Os>
+void
+add_operations(std::vector<Configuration> & configurations, TypeList<Os...>)
+{
+	(add_trees<Os>(configurations, Trees{}), ...);
+}
+
+/*
+ * Running the jobs
+ */
+struct Job
+{
+	size_t configuration;
+	size_t base_size;
+	int seed;
+};
+
+struct Settings
+{
+	size_t base_size = 2048;
+	size_t doublings = 10;
+	size_t experiment_size = 1000;
+	size_t seed_count = 2;
+	size_t inner_iterations = 10;
+	size_t worker_count = 0;
+	std::string filter = "";
+	std::string csv = "";
+	bool list = false;
+};
+
+struct Worker
+{
+	pid_t pid;
+	FILE * from_worker;
+	int core;
+};
+
+// The cores this process may run on
+std::vector<int>
+get_cores()
+{
+	std::vector<int> cores;
+#ifdef __linux__
+	cpu_set_t set;
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+			if (CPU_ISSET(cpu, &set)) {
+				cores.push_back(cpu);
+			}
+		}
+	}
+#endif
+	return cores;
+}
+
+void
+pin_to_core(int core)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		std::cerr << "Could not pin worker to core " << core << "\n";
+	}
+#else
+	(void)core;
+#endif
+}
+
+/* Runs a single job and answers with a line containing the job index and its
+ * results. */
+[[noreturn]] void
+run_worker(const std::vector<Configuration> & configurations,
+           const std::vector<Job> & jobs, const Settings & settings,
+           size_t index, FILE * out)
+{
+	const Job & job = jobs[index];
+	JobResult result = configurations[job.configuration].run(
+	    job.base_size, settings.experiment_size, job.seed,
+	    settings.inner_iterations);
+	fprintf(out, "%zu %.17g %.17g %.17g\n", index, result.nanoseconds,
+	        result.pointer_gets, result.pointer_sets);
+	fflush(out);
+
+	// Do not run any destructors or flush any buffers of the parent
+	_exit(0);
+}
+
+/* Every job gets a fresh process, such that the static state of the key
+ * generators (e.g. the sliding window clocks) and the pointer counters does
+ * not carry over from one job to the next. */
+Worker
+start_worker(const std::vector<Configuration> & configurations,
+             const std::vector<Job> & jobs, const Settings & settings,
+             size_t index, int core)
+{
+	int from_worker[2];
+	if (pipe(from_worker) != 0) {
+		std::cerr << "Could not create pipes for the workers\n";
+		exit(-1);
+	}
+
+	// Otherwise, buffered output would be written twice
+	std::cout.flush();
+	std::cerr.flush();
+	fflush(nullptr);
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		std::cerr << "Could not start a worker\n";
+		exit(-1);
+	}
+
+	if (pid == 0) {
+		close(from_worker[0]);
+		if (core >= 0) {
+			pin_to_core(core);
+		}
+		run_worker(configurations, jobs, settings, index,
+		           fdopen(from_worker[1], "w"));
+	}
+
+	close(from_worker[1]);
+	return {pid, fdopen(from_worker[0], "r"), core};
+}
+
+void
+finish_worker(Worker & worker)
+{
+	fclose(worker.from_worker);
+	waitpid(worker.pid, nullptr, 0);
+}
+
+std::vector<JobResult>
+run_jobs(const std::vector<Configuration> & configurations,
+         const std::vector<Job> & jobs, const Settings & settings)
+{
+	std::vector<int> cores = get_cores();
+	size_t worker_count = settings.worker_count;
+	if (worker_count == 0) {
+		worker_count = cores.empty() ? std::thread::hardware_concurrency()
+		                             : cores.size();
+	}
+	// More workers than cores would have to share cores, which skews timings
+	if (!cores.empty() && (worker_count > cores.size())) {
+		std::cerr << "Only " << cores.size() << " cores are available, using "
+		          << cores.size() << " workers instead of " << worker_count
+		          << "\n";
+		worker_count = cores.size();
+	}
+	worker_count = std::max(size_t{1}, std::min(worker_count, jobs.size()));
+
+	std::cerr << "Running " << jobs.size() << " jobs on " << worker_count
+	          << " workers...\n";
+
+	std::vector<Worker> workers;
+	size_t next = 0;
+	for (size_t i = 0; i < worker_count; ++i) {
+		int core = cores.empty() ? -1 : cores[i];
+		workers.push_back(start_worker(configurations, jobs, settings, next++,
+		                               core));
+	}
+
+	std::vector<JobResult> results(jobs.size());
+	std::vector<pollfd> fds(workers.size());
+	for (size_t i = 0; i < workers.size(); ++i) {
+		fds[i].fd = fileno(workers[i].from_worker);
+		fds[i].events = POLLIN;
+	}
+
+	size_t done = 0;
+	while (done < jobs.size()) {
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			continue;
+		}
+
+		for (size_t i = 0; i < workers.size(); ++i) {
+			if ((fds[i].fd < 0) || ((fds[i].revents & (POLLIN | POLLHUP)) == 0)) {
+				continue;
+			}
+
+			size_t index;
+			JobResult result;
+			if (fscanf(workers[i].from_worker, "%zu %lg %lg %lg", &index,
+			           &result.nanoseconds, &result.pointer_gets,
+			           &result.pointer_sets) != 4) {
+				std::cerr << "Worker " << i << " terminated unexpectedly\n";
+				exit(-1);
+			}
+			finish_worker(workers[i]);
+			results[index] = result;
+			done++;
+			std::cerr << "[" << done << "/" << jobs.size() << "] "
+			          << configurations[jobs[index].configuration].name << " @ "
+			          << jobs[index].base_size << "\n";
+
+			if (next < jobs.size()) {
+				workers[i] = start_worker(configurations, jobs, settings, next++,
+				                          workers[i].core);
+				fds[i].fd = fileno(workers[i].from_worker);
+			} else {
+				fds[i].fd = -1;
+			}
+		}
+	}
+
+	return results;
+}
+
+void
+print_results(const std::vector<Configuration> & configurations,
+              const std::vector<Job> & jobs,
+              const std::vector<JobResult> & results)
+{
+	// Averaged over the seeds
+	std::map<std::pair<size_t, size_t>, std::pair<JobResult, size_t>> sums;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		auto & sum = sums[{jobs[i].configuration, jobs[i].base_size}];
+		sum.first.nanoseconds += results[i].nanoseconds;
+		sum.first.pointer_gets += results[i].pointer_gets;
+		sum.first.pointer_sets += results[i].pointer_sets;
+		sum.second++;
+	}
+
+	size_t width = 0;
+	for (const auto & c : configurations) {
+		width = std::max(width, c.name.size());
+	}
+
+	std::cout << std::left << std::setw(static_cast<int>(width))
+	          << "Configuration" << std::right << std::setw(10) << "Size"
+	          << std::setw(12) << "ns/op" << std::setw(12) << "gets/op"
+	          << std::setw(12) << "sets/op"
+	          << "\n";
+	for (const auto & [key, sum] : sums) {
+		double count = static_cast<double>(sum.second);
+		std::cout << std::left << std::setw(static_cast<int>(width))
+		          << configurations[key.first].name << std::right << std::setw(10)
+		          << key.second << std::fixed << std::setprecision(2)
+		          << std::setw(12) << sum.first.nanoseconds / count
+		          << std::setw(12) << sum.first.pointer_gets / count
+		          << std::setw(12) << sum.first.pointer_sets / count << "\n";
+	}
+}
+
+void
+write_csv(const std::string & filename,
+          const std::vector<Configuration> & configurations,
+          const std::vector<Job> & jobs, const std::vector<JobResult> & results)
+{
+	std::ofstream os(filename);
+	os << "name,base_size,seed,ns_per_op,gets_per_op,sets_per_op\n";
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		os << configurations[jobs[i].configuration].name << ","
+		   << jobs[i].base_size << "," << jobs[i].seed << ","
+		   << results[i].nanoseconds << "," << results[i].pointer_gets << ","
+		   << results[i].pointer_sets << "\n";
+	}
+}
+
+[[noreturn]] void
+usage(const char * name)
+{
+	std::cerr << "Usage: " << name
+	          << " [--list] [--filter <regex>] [--jobs <n>] [--base-size <n>]\n"
+	          << "       [--doublings <n>] [--experiment-size <n>]\n"
+	          << "       [--seeds <n>] [--iterations <n>] [--csv <file>]\n";
+	exit(-1);
+}
+
+Settings
+parse_settings(int argc, char ** argv)
+{
+	Settings settings;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--list") {
+			settings.list = true;
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			usage(argv[0]);
+		}
+		std::string value = argv[++i];
+		if (arg == "--filter") {
+			settings.filter = value;
+		} else if (arg == "--csv") {
+			settings.csv = value;
+		} else if (arg == "--jobs") {
+			settings.worker_count = static_cast<size_t>(std::atol(value.c_str()));
+		} else if (arg == "--base-size") {
+			settings.base_size = static_cast<size_t>(std::atol(value.c_str()));
+		} else if (arg == "--doublings") {
+			settings.doublings = static_cast<size_t>(std::atol(value.c_str()));
+		} else if (arg == "--experiment-size") {
+			settings.experiment_size = static_cast<size_t>(std::atol(value.c_str()));
+		} else if (arg == "--seeds") {
+			settings.seed_count = static_cast<size_t>(std::atol(value.c_str()));
+		} else if (arg == "--iterations") {
+			settings.inner_iterations =
+			    static_cast<size_t>(std::atol(value.c_str()));
+		} else {
+			usage(argv[0]);
+		}
+	}
+
+	if ((settings.base_size == 0) || (settings.experiment_size == 0) ||
+	    (settings.inner_iterations == 0)) {
+		usage(argv[0]);
+	}
+
+	return settings;
+}
+
+int
+main(int argc, char ** argv)
+{
+	Settings settings = parse_settings(argc, argv);
+
+	std::vector<Configuration> configurations;
+	add_operations(configurations, Operations{});
+
+	std::regex filter(settings.filter);
+	std::vector<size_t> selected;
+	for (size_t i = 0; i < configurations.size(); ++i) {
+		if (std::regex_search(configurations[i].name, filter)) {
+			selected.push_back(i);
+		}
+	}
+
+	if (settings.list) {
+		for (size_t i : selected) {
+			std::cout << configurations[i].name << "\n";
+		}
+		return 0;
+	}
+
+	std::vector<Job> jobs;
+	for (size_t doubling = 0; doubling < settings.doublings; ++doubling) {
+		for (size_t i : selected) {
+			for (size_t seed = 0; seed < settings.seed_count; ++seed) {
+				jobs.push_back({i, settings.base_size << doubling,
+				                static_cast<int>(4 + seed)});
+			}
+		}
+	}
+	if (jobs.empty()) {
+		std::cerr << "No configurations selected.\n";
+		return -1;
+	}
+
+	std::vector<JobResult> results = run_jobs(configurations, jobs, settings);
+
+	print_results(configurations, jobs, results);
+	if (!settings.csv.empty()) {
+		write_csv(settings.csv, configurations, jobs, results);
+	}
+
+	return 0;
+}
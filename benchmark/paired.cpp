@@ -52,79 +52,6 @@ struct BSTMoveOptions : public DefaultBenchmarkOptions
 #endif
 };
 
-struct MoveExecutor
-{
-	template <class Fixture>
-	static void
-	run(Fixture & f)
-	{
-		for (size_t i = 0; i < f.experiment_node_pointers.size(); i++) {
-			auto * n = f.experiment_node_pointers[i];
-			auto new_val = f.experiment_values[i];
-
-			f.t.remove(*n);
-			n->set_value(new_val);
-			f.t.insert(*n);
-		}
-	}
-
-	template <class Fixture>
-	static void
-	revert(Fixture & f)
-	{
-		for (size_t i = 0; i < f.experiment_node_pointers.size(); i++) {
-			auto * n = f.experiment_node_pointers[i];
-			auto old_val = f.fixed_values[i];
-
-			f.t.remove(*n);
-			n->set_value(old_val);
-			f.t.insert(*n);
-		}
-	}
-};
-
-struct InsertExecutor
-{
-	template <class Fixture>
-	static void
-	run(Fixture & f)
-	{
-		for (auto & n : f.experiment_nodes) {
-			f.t.insert(n);
-		}
-	}
-
-	template <class Fixture>
-	static void
-	revert(Fixture & f)
-	{
-		for (auto & n : f.experiment_nodes) {
-			f.t.remove(n);
-		}
-	}
-};
-
-struct EraseExecutor
-{
-	template <class Fixture>
-	static void
-	run(Fixture & f)
-	{
-		for (auto n : f.experiment_node_pointers) {
-			f.t.erase(n->get_value());
-		}
-	}
-
-	template <class Fixture>
-	static void
-	revert(Fixture & f)
-	{
-		for (auto & n : f.experiment_node_pointers) {
-			f.t.insert(*n);
-		}
-	}
-};
-
 template <class Executor, class Options, class Experiment, class OuterInterface,
           class... InnerInterfaces>
 void
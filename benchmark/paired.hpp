@@ -16,6 +16,214 @@ struct Result
 	double cohens_d;
 };
 
+/*
+ * Executors run an experiment on a fixture and revert its changes afterwards
+ */
+struct MoveExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (size_t i = 0; i < f.experiment_node_pointers.size(); i++) {
+			auto * n = f.experiment_node_pointers[i];
+			auto new_val = f.experiment_values[i];
+
+			f.t.remove(*n);
+			n->set_value(new_val);
+			f.t.insert(*n);
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		for (size_t i = 0; i < f.experiment_node_pointers.size(); i++) {
+			auto * n = f.experiment_node_pointers[i];
+			auto old_val = f.fixed_values[i];
+
+			f.t.remove(*n);
+			n->set_value(old_val);
+			f.t.insert(*n);
+		}
+	}
+};
+
+struct InsertExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (auto & n : f.experiment_nodes) {
+			f.t.insert(n);
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		for (auto & n : f.experiment_nodes) {
+			f.t.remove(n);
+		}
+	}
+};
+
+struct EraseExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (auto n : f.experiment_node_pointers) {
+			f.t.erase(n->get_value());
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		for (auto & n : f.experiment_node_pointers) {
+			f.t.insert(*n);
+		}
+	}
+};
+
+struct DeleteExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (auto n : f.experiment_node_pointers) {
+			f.t.remove(*n);
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		for (auto n : f.experiment_node_pointers) {
+			f.t.insert(*n);
+		}
+	}
+};
+
+struct SearchExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (auto val : f.experiment_values) {
+			auto it = f.t.find(val);
+			benchmark::DoNotOptimize(it);
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		(void)f;
+	}
+};
+
+struct DSTDeleteExecutor
+{
+	template <class Fixture>
+	static void
+	run(Fixture & f)
+	{
+		for (auto i : f.experiment_indices) {
+			f.t.remove(f.fixed_nodes[i]);
+		}
+	}
+
+	template <class Fixture>
+	static void
+	revert(Fixture & f)
+	{
+		for (auto i : f.experiment_indices) {
+			f.t.insert(f.fixed_nodes[i]);
+		}
+	}
+};
+
+/*
+ * Options for the BST experiments of trials, for each key distribution
+ */
+template <class Distribution>
+struct TrialInsertOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = Distribution;
+	constexpr static bool need_nodes = true;
+	using NodeRandomizer = Distribution;
+};
+
+template <class Distribution>
+struct TrialDeleteOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = Distribution;
+	constexpr static bool need_node_pointers = true;
+	using NodePointerRandomizer = NodePointerRandomizerFor<Distribution>;
+
+	constexpr static bool distinct = true;
+	constexpr static bool values_from_fixed = true;
+};
+
+template <class Distribution>
+struct TrialSearchOptions : public DefaultBenchmarkOptions
+{
+	using MainRandomizer = UseUniform;
+	constexpr static bool need_values = true;
+	using ValueRandomizer = Distribution;
+	constexpr static bool values_from_fixed = true;
+};
+
+/*
+ * Runs the experiment of a benchmark fixture outside of Google Benchmark. A
+ * trial runs the Executor inner_iterations times, reverting its changes after
+ * every run, and returns the summed up duration in nanoseconds.
+ */
+template <class Base>
+class TrialFixture : public Base {
+public:
+	virtual void BenchmarkCase(
+	    ::benchmark::State &){}; // Artiface from re-using GBenchmark code
+
+	template <class Executor>
+	double
+	run(size_t inner_iterations) noexcept
+	{
+		double duration_sum = 0;
+		for (size_t i = 0; i < inner_iterations; ++i) {
+			// Clobber memory
+			asm volatile("" : : : "memory");
+			auto started_at = std::chrono::high_resolution_clock::now();
+			Executor::run(*this);
+			auto finished_at = std::chrono::high_resolution_clock::now();
+			// Pretend we need the tree's data as input.
+			asm volatile(""
+			             :
+			             : "g"(&this->t), "g"(this->fixed_nodes.data()),
+			               "g"(this->experiment_nodes.data())
+			             : "memory");
+
+			auto duration = finished_at - started_at;
+			duration_sum += static_cast<double>(
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+			        .count());
+			Executor::revert(*this);
+		}
+		return duration_sum;
+	}
+};
+
 template <class InterfaceA, class InterfaceB, class Experiment, class Options>
 class PairedTester {
 public:
@@ -89,43 +297,8 @@ public:
 	}
 
 private:
-	template <class Base>
-	class Wrapper : public Base {
-	public:
-		virtual void BenchmarkCase(
-		    ::benchmark::State &){}; // Artiface from re-using GBenchmark code
-
-		template <class Executor>
-		double
-		run(size_t inner_iterations) noexcept
-		{
-			double duration_sum = 0;
-			for (size_t i = 0; i < inner_iterations; ++i) {
-				// Clobber memory
-				asm volatile("" : : : "memory");
-				auto started_at = std::chrono::high_resolution_clock::now();
-				Executor::run(*this);
-				auto finished_at = std::chrono::high_resolution_clock::now();
-				// Pretend we need the tree's data as input.
-				asm volatile(""
-				             :
-				             : "g"(&this->t), "g"(this->fixed_nodes.data()),
-				               "g"(this->experiment_nodes.data()),
-				               "g"(this->experiment_node_pointers.data())
-				             : "memory");
-
-				auto duration = finished_at - started_at;
-				duration_sum += static_cast<double>(
-				    std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
-				        .count());
-				Executor::revert(*this);
-			}
-			return duration_sum;
-		}
-	};
-
-	Wrapper<BSTFixture<InterfaceA, Experiment, Options>> A;
-	Wrapper<BSTFixture<InterfaceB, Experiment, Options>> B;
+	TrialFixture<BSTFixture<InterfaceA, Experiment, Options>> A;
+	TrialFixture<BSTFixture<InterfaceB, Experiment, Options>> B;
 
 	std::vector<std::pair<double, double>> results;
 };
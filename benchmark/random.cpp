@@ -1,5 +1,6 @@
 #include "random.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <map>
@@ -31,6 +32,18 @@ MaekinenSkewedDistr::get_name() const noexcept
 	return "Skewed";
 }
 
+const char *
+SlidingWindowDistr::get_name() const noexcept
+{
+	return "SlidingWindow";
+}
+
+const char *
+HotSetDistr::get_name() const noexcept
+{
+	return "HotSet";
+}
+
 int
 ZipfDistr::get_default_max() const noexcept
 {
@@ -49,16 +62,29 @@ MaekinenSkewedDistr::get_default_max() const noexcept
 	return std::numeric_limits<int>::max();
 }
 
+int
+SlidingWindowDistr::get_default_max() const noexcept
+{
+	return std::numeric_limits<int>::max();
+}
+
+int
+HotSetDistr::get_default_max() const noexcept
+{
+	return std::numeric_limits<int>::max();
+}
+
 ZipfDistr::ZipfSampler &
 ZipfDistr::get_sampler(int min, int max)
 {
 	static std::map<std::pair<size_t, double>, ZipfSampler> samplers;
 
-	std::pair<size_t, double> key{max - min, this->exponent};
+	// max - min does not necessarily fit into an int
+	size_t number_of_elements =
+	    static_cast<size_t>(static_cast<long long>(max) - min);
+	std::pair<size_t, double> key{number_of_elements, this->exponent};
 	if (samplers.find(key) == samplers.end()) {
-		samplers.insert(
-		    {key, ZipfSampler(this->exponent, static_cast<size_t>(max - min),
-		                      this->rng)});
+		samplers.insert({key, ZipfSampler(this->exponent, number_of_elements)});
 	}
 
 	return samplers.at(key);
@@ -69,12 +95,11 @@ ZipfDistr::ZipfDistr(unsigned long seed, double exponent_in)
 {}
 
 ZipfDistr::ZipfSampler::ZipfSampler(double exponent_in,
-                                    size_t number_of_elements_in,
-                                    std::mt19937 & rng_in)
+                                    size_t number_of_elements_in)
     : exponent(exponent_in), number_of_elements(number_of_elements_in),
-      rng(rng_in), h_integral_x1(h_integral(1.5) - 1.0),
-      h_integral_number_of_elements(static_cast<double>(number_of_elements_in) +
-                                    0.5),
+      h_integral_x1(h_integral(1.5) - 1.0),
+      h_integral_number_of_elements(
+          h_integral(static_cast<double>(number_of_elements_in) + 0.5)),
       s(2.0 - h_integral_inverse(h_integral(2.5) - h(2.0)))
 {}
 
@@ -124,27 +149,28 @@ ZipfDistr::ZipfSampler::helper2(double x) const noexcept
 	}
 }
 
-int
-ZipfDistr::ZipfSampler::generate()
+size_t
+ZipfDistr::ZipfSampler::generate(std::mt19937 & rng)
 {
 	std::uniform_real_distribution<double> udistr(0.0, 1.0);
 	while (true) {
-		double u =
-		    this->h_integral_number_of_elements +
-		    udistr(this->rng) * (h_integral_x1 - h_integral_number_of_elements);
+		double u = this->h_integral_number_of_elements +
+		           udistr(rng) * (h_integral_x1 - h_integral_number_of_elements);
 		double x = h_integral_inverse(u);
-		int k = static_cast<int>(x + 0.5);
 
 		// Fix numerical inaccuracies
-		if (k < 1) {
+		size_t k;
+		if (x + 0.5 < 1.0) {
 			k = 1;
-		} else if (static_cast<size_t>(k) > this->number_of_elements) {
-			k = static_cast<int>(
-			    this->number_of_elements); // TODO assert that they are not too many
+		} else if (x + 0.5 >= static_cast<double>(this->number_of_elements)) {
+			k = this->number_of_elements;
+		} else {
+			k = static_cast<size_t>(x + 0.5);
 		}
 
 		// Accept k based on the right probabilities
-		if (k - x <= s || u >= h_integral(k + 0.5) - h(k)) {
+		double k_d = static_cast<double>(k);
+		if (k_d - x <= s || u >= h_integral(k_d + 0.5) - h(k_d)) {
 			return k;
 		}
 	}
@@ -153,8 +179,10 @@ ZipfDistr::ZipfSampler::generate()
 int
 ZipfDistr::generate(int min, int max)
 {
-	auto sampler = this->get_sampler(min, max);
-	return sampler.generate();
+	// The samplers are shared between all instances, the random numbers are
+	// not. Rank 1 is the most frequent key, which is min.
+	size_t rank = this->get_sampler(min, max).generate(this->rng);
+	return static_cast<int>(min + static_cast<long long>(rank - 1));
 }
 
 UniformDistr::UniformDistr(unsigned long seed) : Randomizer(seed) {}
@@ -209,3 +237,66 @@ MaekinenSkewedDistr::generate(int min, int max)
 		}
 	}
 }
+
+SlidingWindowDistr::SlidingWindowDistr(unsigned long seed, size_t window_in,
+                                       size_t disorder_in)
+    : Randomizer(seed), window(window_in), disorder(disorder_in)
+{}
+
+size_t &
+SlidingWindowDistr::get_clock(int min, int max)
+{
+	static std::map<std::pair<int, int>, size_t> clocks;
+	return clocks[{min, max}];
+}
+
+int
+SlidingWindowDistr::generate(int min, int max)
+{
+	size_t range = static_cast<size_t>(static_cast<long long>(max) -
+	                                   static_cast<long long>(min));
+	size_t step = std::max(size_t{1}, range / this->window);
+
+	size_t position = this->get_clock(min, max)++;
+	if (this->disorder > 0) {
+		std::uniform_int_distribution<size_t> distr(0, this->disorder);
+		position -= std::min(position, distr(this->rng));
+	}
+
+	return static_cast<int>(static_cast<long long>(min) +
+	                        static_cast<long long>(
+	                            ((position % this->window) * step) % range));
+}
+
+HotSetDistr::HotSetDistr(unsigned long seed, double hot_fraction_in,
+                         double hot_probability_in, size_t shift_interval_in)
+    : Randomizer(seed), hot_fraction(hot_fraction_in),
+      hot_probability(hot_probability_in), shift_interval(shift_interval_in),
+      counter(0), hot_start(0)
+{}
+
+int
+HotSetDistr::generate(int min, int max)
+{
+	std::uniform_real_distribution<double> udistr(0.0, 1.0);
+
+	if (this->counter % this->shift_interval == 0) {
+		this->hot_start = udistr(this->rng) * (1.0 - this->hot_fraction);
+	}
+	this->counter++;
+
+	long long range =
+	    static_cast<long long>(max) - static_cast<long long>(min);
+	long long left = static_cast<long long>(min);
+	long long right = static_cast<long long>(max);
+	if (udistr(this->rng) < this->hot_probability) {
+		left += static_cast<long long>(
+		    std::floor(this->hot_start * static_cast<double>(range)));
+		right = left + std::max(1ll, static_cast<long long>(std::floor(
+		                                 this->hot_fraction *
+		                                 static_cast<double>(range))));
+	}
+
+	std::uniform_int_distribution<long long> distr(left, right - 1);
+	return static_cast<int>(distr(this->rng));
+}
@@ -44,14 +44,14 @@ public:
 private:
 	class ZipfSampler {
 	public:
-		ZipfSampler(double exponent, size_t number_of_elements, std::mt19937 & rng);
+		ZipfSampler(double exponent, size_t number_of_elements);
 
-		int generate();
+		// Returns a rank between 1 and number_of_elements
+		size_t generate(std::mt19937 & rng);
 
 	private:
 		const double exponent;
 		const size_t number_of_elements;
-		std::mt19937 & rng;
 
 		/* Computed constants */
 		double h_integral_x1; // h_integral(1.5) - 1
@@ -101,4 +101,60 @@ public:
 	virtual const char * get_name() const noexcept override;
 };
 
+/*
+ * Keys of a time series: The i-th generated key is the i-th of `window` evenly
+ * spaced points in [min, max). Keys thus arrive in ascending order, like
+ * timestamps. Every key may be delayed by up to `disorder` positions, which
+ * models events that arrive late.
+ *
+ * Like a clock, the position is shared by all generators that draw from the
+ * same range, for the lifetime of the process. Nodes created after the tree has
+ * been filled thus receive the newest keys. If the range is smaller than the
+ * window, consecutive keys are consecutive numbers.
+ *
+ * The range holds only `window` distinct keys. After `window` keys have been
+ * drawn from a range, the clock wraps around and the keys start over at min,
+ * i.e., they are no longer ascending. With the window of UseSlidingWindow
+ * (2^26 keys), a process must draw less than that many keys per range.
+ */
+class SlidingWindowDistr : public Randomizer {
+public:
+	SlidingWindowDistr(unsigned long seed, size_t window, size_t disorder = 0);
+	virtual ~SlidingWindowDistr() = default;
+
+	virtual int generate(int min, int max) override;
+	virtual int get_default_max() const noexcept override;
+	virtual const char * get_name() const noexcept override;
+
+private:
+	size_t & get_clock(int min, int max);
+	size_t window;
+	size_t disorder;
+};
+
+/*
+ * A hot set that moves: With probability `hot_probability`, keys are drawn
+ * uniformly from the hot range, which spans `hot_fraction` of [min, max).
+ * All other keys are drawn uniformly from [min, max). Every `shift_interval`
+ * keys, the hot range moves to a new random position.
+ */
+class HotSetDistr : public Randomizer {
+public:
+	HotSetDistr(unsigned long seed, double hot_fraction, double hot_probability,
+	            size_t shift_interval);
+	virtual ~HotSetDistr() = default;
+
+	virtual int generate(int min, int max) override;
+	virtual int get_default_max() const noexcept override;
+	virtual const char * get_name() const noexcept override;
+
+private:
+	double hot_fraction;
+	double hot_probability;
+	size_t shift_interval;
+	size_t counter;
+	// Start of the hot range, relative to the size of [min, max)
+	double hot_start;
+};
+
 #endif
@@ -0,0 +1,191 @@
+/*
+ * Worker for the performance regression harness in scripts/regress.py.
+ *
+ * The harness compiles this file against the library of two different
+ * revisions and runs both binaries side by side. This binary knows the
+ * configurations (tree, operation and key distribution) and runs single
+ * trials of them, the harness interleaves the trials of both binaries and
+ * does the statistics.
+ *
+ * Usage: regress --list
+ *        regress <base size> <experiment size> <inner iterations>
+ *
+ * With --list, the names of all configurations are printed, one per line.
+ * Otherwise, every line read from stdin must contain a configuration index (as
+ * in the output of --list) and a seed. The trial's mean duration per inner
+ * iteration, in nanoseconds, is printed in response.
+ *
+ * Older revisions of the library lack some of the trees and options. For
+ * these, the harness defines NO_RBT_SINGLE_PASS, NO_ZTREE_RANK_HASH_MIX or
+ * NO_BTREE_INDEX, which leave out the configurations that need them. Since
+ * the harness only compares configurations that both builds know, these are
+ * then skipped.
+ */
+
+#include "paired.hpp"
+
+#include "common_bst.hpp"
+#include "common_dst.hpp"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Configuration
+{
+	std::string name;
+	std::function<double(size_t, size_t, int, size_t)> run;
+};
+
+template <class Fixture, class Executor>
+Configuration
+make_configuration(std::string name)
+{
+	return {name, [](size_t base_size, size_t experiment_size, int seed,
+	                 size_t inner_iterations) {
+		        // Fixtures can be large, keep them off the stack
+		        auto f = std::make_unique<TrialFixture<Fixture>>();
+		        f->initialize(base_size, experiment_size, seed);
+		        return f->template run<Executor>(inner_iterations) /
+		               static_cast<double>(inner_iterations);
+	        }};
+}
+
+template <class Interface, class Distribution>
+void
+add_bst_configurations(std::vector<Configuration> & configurations,
+                       std::string distribution)
+{
+	using InsertFixture =
+	    BSTFixture<Interface, InsertExperiment,
+	               TrialInsertOptions<Distribution>>;
+	using DeleteFixture =
+	    BSTFixture<Interface, DeleteExperiment,
+	               TrialDeleteOptions<Distribution>>;
+	using SearchFixture =
+	    BSTFixture<Interface, SearchExperiment,
+	               TrialSearchOptions<Distribution>>;
+
+	configurations.push_back(make_configuration<InsertFixture, InsertExecutor>(
+	    InsertFixture::get_name() + " :: " + distribution));
+	configurations.push_back(make_configuration<DeleteFixture, DeleteExecutor>(
+	    DeleteFixture::get_name() + " :: " + distribution));
+	configurations.push_back(make_configuration<SearchFixture, SearchExecutor>(
+	    SearchFixture::get_name() + " :: " + distribution));
+}
+
+template <class Interface>
+void
+add_bst_configurations(std::vector<Configuration> & configurations)
+{
+	add_bst_configurations<Interface, UseUniform>(configurations, "Uniform");
+	add_bst_configurations<Interface, UseZipf>(configurations, "Zipf");
+	add_bst_configurations<Interface, UseSkewed>(configurations, "Skewed");
+}
+
+// The DST fixture only generates uniformly distributed intervals
+template <class Interface>
+void
+add_dst_configurations(std::vector<Configuration> & configurations)
+{
+	using InsertFixture =
+	    DSTFixture<Interface, InsertExperiment, true, false, false, false>;
+	using DeleteFixture =
+	    DSTFixture<Interface, DeleteExperiment, false, false, true, false>;
+
+	configurations.push_back(make_configuration<InsertFixture, InsertExecutor>(
+	    InsertFixture::get_name() + " :: Uniform"));
+	configurations.push_back(
+	    make_configuration<DeleteFixture, DSTDeleteExecutor>(
+	        DeleteFixture::get_name() + " :: Uniform"));
+}
+
+using ZHRegressDSTInterface =
+    ZDSTInterface<BasicDSTTreeOptions,
+                  ygg::TreeFlags::ZTREE_RANK_HASH_UNIVERSALIZE_COEFFICIENT<
+                      16186402584962403883ul>,
+                  ygg::TreeFlags::ZTREE_USE_HASH>;
+using WB32RegressDSTInterface =
+    WBDSTInterface<BasicDSTTreeOptions, ygg::TreeFlags::WBT_DELTA_NUMERATOR<3>,
+                   ygg::TreeFlags::WBT_DELTA_DENOMINATOR<1>,
+                   ygg::TreeFlags::WBT_GAMMA_NUMERATOR<2>,
+                   ygg::TreeFlags::WBT_GAMMA_DENOMINATOR<1>,
+                   ygg::TreeFlags::WBT_SINGLE_PASS>;
+
+std::vector<Configuration>
+get_configurations()
+{
+	std::vector<Configuration> configurations;
+
+	add_bst_configurations<YggRBTreeInterface<BasicTreeOptions>>(configurations);
+#ifndef NO_RBT_SINGLE_PASS
+	add_bst_configurations<YggRBTreeInterface<RBSinglePassTreeOptions>>(
+	    configurations);
+#endif
+	add_bst_configurations<YggWBTreeInterface<WBTTwopassTreeOptions>>(
+	    configurations);
+	add_bst_configurations<YggWBTreeInterface<WBTSinglepassTreeOptions>>(
+	    configurations);
+	add_bst_configurations<YggEnergyTreeInterface<BasicTreeOptions>>(
+	    configurations);
+	add_bst_configurations<YggZTreeInterface<ZRandomTreeOptions>>(
+	    configurations);
+#ifndef NO_ZTREE_RANK_HASH_MIX
+	add_bst_configurations<YggZTreeInterface<ZMixHashTreeOptions>>(
+	    configurations);
+#endif
+#ifndef NO_BTREE_INDEX
+	add_bst_configurations<YggBTreeIndexInterface<BTree32TreeOptions>>(
+	    configurations);
+#endif
+
+	add_dst_configurations<RBDSTInterface<BasicDSTTreeOptions>>(configurations);
+	add_dst_configurations<ZHRegressDSTInterface>(configurations);
+	add_dst_configurations<WB32RegressDSTInterface>(configurations);
+
+	return configurations;
+}
+
+int
+main(int argc, char ** argv)
+{
+	auto configurations = get_configurations();
+
+	if ((argc == 2) && (std::string(argv[1]) == "--list")) {
+		for (const auto & c : configurations) {
+			std::cout << c.name << "\n";
+		}
+		return 0;
+	}
+
+	if (argc != 4) {
+		std::cerr << "Usage: " << argv[0] << " --list\n"
+		          << "       " << argv[0]
+		          << " <base size> <experiment size> <inner iterations>\n";
+		exit(-1);
+	}
+
+	size_t base_size = static_cast<size_t>(std::atol(argv[1]));
+	size_t experiment_size = static_cast<size_t>(std::atol(argv[2]));
+	size_t inner_iterations = static_cast<size_t>(std::atol(argv[3]));
+
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		std::istringstream command(line);
+		size_t index;
+		int seed;
+		if (!(command >> index >> seed) || (index >= configurations.size())) {
+			std::cerr << "Invalid command: " << line << "\n";
+			return -1;
+		}
+
+		double duration = configurations[index].run(base_size, experiment_size,
+		                                            seed, inner_iterations);
+		std::cout << duration << std::endl;
+	}
+
+	return 0;
+}
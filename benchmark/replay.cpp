@@ -0,0 +1,299 @@
+/*
+ * Replays a compact operation trace against the trees from common_bst.hpp.
+ *
+ * Traces recorded with YGG_STORE_SEQUENCE must first be converted using
+ * 'translate_sequence <in> <out> --compact'. The compact trace is then
+ * memory-mapped, and its fixed-width records are fed into the trees directly,
+ * without any parsing or copying.
+ *
+ * Traces with 64-bit or string keys, as written by generate_workload, are
+ * replayed against trees over these key types.
+ *
+ * Usage: replay <trace> <benchmark name> <output prefix> [repetitions]
+ */
+
+#include "../src/benchmark_sequence.hpp"
+#include "common_bst.hpp"
+#include "workload.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * Trees over arbitrary keys. The interfaces of common_bst.hpp only support int
+ * keys, which would change the order of 64-bit keys.
+ */
+template <class KeyT, class Options,
+          template <class, class, class> class NodeBase,
+          template <class, class, class, class, class> class TreeBase,
+          class NodeTraits>
+class KeyedTreeInterface {
+public:
+	class Node : public NodeBase<Node, Options, int> {
+	public:
+		KeyT key;
+
+		bool
+		operator<(const Node & other) const
+		{
+			return this->key < other.key;
+		}
+
+		friend bool
+		operator<(const Node & lhs, const KeyT & rhs)
+		{
+			return lhs.key < rhs;
+		}
+
+		friend bool
+		operator<(const KeyT & lhs, const Node & rhs)
+		{
+			return lhs < rhs.key;
+		}
+	};
+
+	using Tree =
+	    TreeBase<Node, NodeTraits, Options, int, ygg::utilities::flexible_less>;
+	using Value = KeyT;
+
+	static Node
+	create_node(KeyT key)
+	{
+		Node n;
+		n.key = key;
+		return n;
+	}
+
+	static void
+	set_value(Node & n, KeyT key)
+	{
+		n.key = key;
+	}
+
+	static void
+	insert(Tree & t, Node & n)
+	{
+		t.insert(n);
+	}
+};
+
+template <class KeyT>
+using KeyedRBInterface =
+    KeyedTreeInterface<KeyT, BasicTreeOptions, ygg::RBTreeNodeBase, ygg::RBTree,
+                       ygg::RBDefaultNodeTraits>;
+template <class KeyT>
+using KeyedRBSPInterface =
+    KeyedTreeInterface<KeyT, RBSinglePassTreeOptions, ygg::RBTreeNodeBase,
+                       ygg::RBTree, ygg::RBDefaultNodeTraits>;
+template <class KeyT>
+using KeyedWBTPInterface =
+    KeyedTreeInterface<KeyT, WBTTwopassTreeOptions, ygg::WBTreeNodeBase,
+                       ygg::WBTree, ygg::WBDefaultNodeTraits>;
+template <class KeyT>
+using KeyedWBSPInterface =
+    KeyedTreeInterface<KeyT, WBTSinglepassTreeOptions, ygg::WBTreeNodeBase,
+                       ygg::WBTree, ygg::WBDefaultNodeTraits>;
+
+template <class Interface, class BSS, class Value>
+class TraceReplayer {
+public:
+	using Node = typename Interface::Node;
+	using Tree = typename Interface::Tree;
+
+	TraceReplayer(const typename BSS::MappedReader & reader_in,
+	              std::string name_in,
+	              std::string benchmark_name_in, size_t repetitions_in,
+	              std::ostream & out_in)
+	    : reader(reader_in), name(name_in), benchmark_name(benchmark_name_in),
+	      repetitions(repetitions_in), out(out_in)
+	{
+		// Node ids are dense, 0 denotes operations without a node
+		this->nodes.reserve(this->reader.get_max_id() + 1);
+		for (size_t i = 0; i <= this->reader.get_max_id(); ++i) {
+			this->nodes.push_back(Interface::create_node(Value{}));
+		}
+
+		this->run();
+	}
+
+private:
+	void
+	run()
+	{
+		for (size_t iteration = 0; iteration < this->repetitions; ++iteration) {
+			std::cerr << this->name << ": "
+			          << (this->repetitions - iteration)
+			          << " iterations remaining...\n";
+
+			Tree t;
+			size_t insert_count = 0;
+			size_t delete_count = 0;
+			size_t erase_count = 0;
+			size_t search_count = 0;
+			size_t bound_count = 0;
+
+			auto started_at = std::chrono::high_resolution_clock::now();
+
+			for (const auto & record : this->reader) {
+				Node & n = this->nodes[record.get_id()];
+
+				/* For the int interfaces, keys are converted to int values. This
+				 * changes the order of keys beyond INT_MAX, but every key is converted
+				 * the same way, so the trace stays consistent. */
+				switch (record.get_type()) {
+				case BSS::Type::INSERT:
+					Interface::set_value(n, static_cast<Value>(record.key));
+					Interface::insert(t, n);
+					insert_count++;
+					break;
+				case BSS::Type::DELETE:
+					t.remove(n);
+					delete_count++;
+					break;
+				case BSS::Type::ERASE: {
+					auto it = t.find(static_cast<Value>(record.key));
+					if (it != t.end()) {
+						t.remove(*it);
+					}
+					erase_count++;
+				} break;
+				case BSS::Type::SEARCH: {
+					auto it = t.find(static_cast<Value>(record.search_key));
+					benchmark::DoNotOptimize(it);
+					search_count++;
+				} break;
+				case BSS::Type::LBOUND: {
+					auto it = t.lower_bound(static_cast<Value>(record.search_key));
+					benchmark::DoNotOptimize(it);
+					bound_count++;
+				} break;
+				case BSS::Type::UBOUND: {
+					auto it = t.upper_bound(static_cast<Value>(record.search_key));
+					benchmark::DoNotOptimize(it);
+					bound_count++;
+				} break;
+				default:
+					break;
+				}
+			}
+
+			auto stopped_at = std::chrono::high_resolution_clock::now();
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			                   stopped_at - started_at)
+			                   .count();
+
+			this->out << this->benchmark_name << "," << this->name << ","
+			          << iteration << "," << elapsed << "," << insert_count
+			          << "," << erase_count << "," << delete_count << ","
+			          << search_count << "," << bound_count << "\n";
+		}
+	}
+
+	const typename BSS::MappedReader & reader;
+	std::string name;
+	std::string benchmark_name;
+	size_t repetitions;
+	std::ostream & out;
+
+	std::vector<Node> nodes;
+};
+
+template <class Interface>
+void
+replay_int(const ygg::utilities::BenchmarkSequenceStorage<
+               unsigned int>::MappedReader & reader,
+           std::string benchmark_name, size_t repetitions, std::ostream & out)
+{
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<unsigned int>;
+	TraceReplayer<Interface, BSS, int>(reader, Interface::get_name(),
+	                                   benchmark_name, repetitions, out);
+}
+
+template <class KeyT>
+void
+replay_keyed(std::string filename, std::string benchmark_name,
+             size_t repetitions, std::ostream & out)
+{
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<KeyT>;
+	typename BSS::MappedReader reader(filename);
+	std::cerr << "Replaying " << reader.size() << " operations on "
+	          << reader.get_max_id() << " nodes.\n";
+
+	// Named like the int interfaces with the same options
+	TraceReplayer<KeyedRBInterface<KeyT>, BSS, KeyT>(
+	    reader, YggRBTreeInterface<BasicTreeOptions>::get_name(), benchmark_name,
+	    repetitions, out);
+	TraceReplayer<KeyedRBSPInterface<KeyT>, BSS, KeyT>(
+	    reader, YggRBTreeInterface<RBSinglePassTreeOptions>::get_name(),
+	    benchmark_name, repetitions, out);
+	TraceReplayer<KeyedWBTPInterface<KeyT>, BSS, KeyT>(
+	    reader, YggWBTreeInterface<WBTTwopassTreeOptions>::get_name(),
+	    benchmark_name, repetitions, out);
+	TraceReplayer<KeyedWBSPInterface<KeyT>, BSS, KeyT>(
+	    reader, YggWBTreeInterface<WBTSinglepassTreeOptions>::get_name(),
+	    benchmark_name, repetitions, out);
+}
+
+int
+main(int argc, char ** argv)
+{
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0]
+		          << " <trace> <benchmark name> <output prefix> [repetitions]\n";
+		exit(-1);
+	}
+
+	size_t repetitions = 10;
+	if (argc == 5) {
+		repetitions = static_cast<size_t>(std::atoi(argv[4]));
+	}
+
+	std::string output_timing = std::string(argv[3]) + "_timing.csv";
+	std::ofstream out(output_timing);
+	out << "name,algorithm,iteration,elapsed,n_insert,n_erase,n_delete,n_"
+	       "search,n_bound\n";
+
+	// The key type is determined by trying to open the trace with each of them
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<unsigned int>;
+	try {
+		BSS::MappedReader reader(argv[1]);
+		std::cerr << "Replaying " << reader.size() << " operations on "
+		          << reader.get_max_id() << " nodes.\n";
+
+		replay_int<YggRBTreeInterface<BasicTreeOptions>>(reader, argv[2],
+		                                                 repetitions, out);
+		replay_int<YggRBTreeInterface<RBSinglePassTreeOptions>>(
+		    reader, argv[2], repetitions, out);
+		replay_int<YggWBTreeInterface<WBTTwopassTreeOptions>>(reader, argv[2],
+		                                                      repetitions, out);
+		replay_int<YggWBTreeInterface<WBTSinglepassTreeOptions>>(
+		    reader, argv[2], repetitions, out);
+		replay_int<YggZTreeInterface<ZRandomTreeOptions>>(reader, argv[2],
+		                                                  repetitions, out);
+		replay_int<YggBTreeIndexInterface<BTree32TreeOptions>>(
+		    reader, argv[2], repetitions, out);
+		return 0;
+	} catch (BSS::WrongTypeException &) {
+	}
+
+	try {
+		replay_keyed<std::uint64_t>(argv[1], argv[2], repetitions, out);
+		return 0;
+	} catch (ygg::utilities::BenchmarkSequenceStorage<
+	         std::uint64_t>::WrongTypeException &) {
+	}
+
+	try {
+		replay_keyed<WorkloadStringKey>(argv[1], argv[2], repetitions, out);
+		return 0;
+	} catch (ygg::utilities::BenchmarkSequenceStorage<
+	         WorkloadStringKey>::WrongTypeException &) {
+	}
+
+	std::cerr << "Unsupported key type in " << argv[1] << "\n";
+	return -1;
+}
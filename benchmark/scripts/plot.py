@@ -181,18 +181,64 @@ class DataReader(object):
         return db
 
 
+class LatencyReader(object):
+    """Reads the CSV files written by bench_latency's --latency_csv"""
+    name_re = re.compile(
+        r'(?P<group>[^\s]+) :: (?P<experiment>[^\s]+) :: (?P<algorithm>[^[]+)(\[(?P<algopts>[^\]]*)\])?')
+    latency_columns = ['p50_ns', 'p90_ns', 'p99_ns', 'p999_ns', 'p9999_ns',
+                       'max_ns']
+
+    def __init__(self, csv_data):
+        self._data = []
+        self._csv_data = csv_data
+
+        self._process()
+
+    def _process(self):
+        for _, row in self._csv_data.iterrows():
+            m = LatencyReader.name_re.match(row['name'])
+            if not m:
+                print("Could not parse experiment name:")
+                print(row['name'])
+                exit(-1)
+
+            d = {
+                'base_size': float(row['base_size']),
+                'experiment_size': float(row['experiment_size']),
+                'count': float(row['count']),
+                'group': m.group('group'),
+                'experiment': m.group('experiment'),
+                'algorithm': m.group('algorithm'),
+                'algopts': m.group('algopts'),
+                'full_algo': "{} [{}]".format(m.group('algorithm'),
+                                              m.groupdict().get('algopts', 'foo'))
+            }
+            for column in LatencyReader.latency_columns:
+                d[column] = float(row[column])
+
+            self._data.append(d)
+
+    def get(self):
+        db = tinydb.TinyDB(storage=tinydb.storages.MemoryStorage)
+        for entry in self._data:
+            db.insert(entry)
+        return db
+
+
 if __name__ == '__main__':
     data_filename = sys.argv[1]
     cfg_filename = sys.argv[2]
     output_dir = sys.argv[3]
 
-    with open(data_filename, 'r') as json_file:
-        json_data = json.load(json_file)
-
     with open(cfg_filename, 'r') as cfg_file:
         cfg = json.load(cfg_file)
 
-    reader = DataReader(json_data)
+    if data_filename.endswith('.csv'):
+        reader = LatencyReader(pd.read_csv(data_filename))
+    else:
+        with open(data_filename, 'r') as json_file:
+            json_data = json.load(json_file)
+        reader = DataReader(json_data)
     data = reader.get()
     for plot_cfg in cfg:
         p = ExperimentPlotter(output_dir, data, plot_cfg)
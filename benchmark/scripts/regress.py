@@ -0,0 +1,303 @@
+"""
+Compares the performance of two builds of the library.
+
+Both builds run the configurations of benchmark/regress.cpp. Their trials are
+interleaved and paired: Trial i of both builds uses the same seed, and the
+build that runs first alternates between trials. For every configuration, the
+ratio of the candidate's to the baseline's duration is reported as a geometric
+mean with a bootstrapped confidence interval, together with the p-value of a
+two-sided sign test.
+
+A configuration fails if the candidate is slower than the baseline by more
+than the threshold, and the confidence interval lies completely above 1. The
+script exits with status 1 if any configuration fails.
+
+Builds are given either as git revisions or as ready regress binaries. For a
+revision, the library (src/) of that revision is combined with the benchmark
+harness of the current working tree, such that both builds measure exactly
+the same code apart from the library itself. Configurations that need a tree
+or an option the library of a revision does not have yet (see FEATURES) are
+left out of that build, and thus not compared. The oldest revision that can
+be built this way is 95a35bf, the first one in the history.
+
+Example:
+  python3 benchmark/scripts/regress.py --baseline v1.0 --candidate HEAD \
+      --filter 'RBTree' --csv regress.csv
+"""
+
+import argparse
+import math
+import os
+import os.path
+import random
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+
+REPO_ROOT = os.path.abspath(
+    os.path.join(os.path.dirname(__file__), '..', '..'))
+
+
+class Worker(object):
+    def __init__(self, binary, base_size, experiment_size, inner_iterations):
+        self._names = subprocess.run(
+            [binary, '--list'], check=True, capture_output=True,
+            text=True).stdout.splitlines()
+        self._indices = {name: i for i, name in enumerate(self._names)}
+        self._process = subprocess.Popen(
+            [binary, str(base_size), str(experiment_size),
+             str(inner_iterations)],
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True)
+
+    def names(self):
+        return self._names
+
+    def run(self, name, seed):
+        self._process.stdin.write(f"{self._indices[name]} {seed}\n")
+        self._process.stdin.flush()
+        line = self._process.stdout.readline()
+        if not line:
+            raise RuntimeError("Worker terminated unexpectedly")
+        return float(line)
+
+    def close(self):
+        self._process.stdin.close()
+        self._process.wait()
+
+
+# Library features that the harness can do without. For each, the define that
+# leaves out the configurations needing it, and a file and pattern that are
+# only found in revisions that have it.
+FEATURES = [
+    ('NO_RBT_SINGLE_PASS', 'options.hpp', r'class RBT_SINGLE_PASS\b'),
+    ('NO_ZTREE_RANK_HASH_MIX', 'options.hpp', r'class ZTREE_RANK_HASH_MIX\b'),
+    ('NO_BTREE_INDEX', 'btree_index.hpp', r'class BTreeIndex\b'),
+]
+
+
+def missing_features(src_dir):
+    """Returns the defines for the features the library in src_dir lacks."""
+    defines = []
+    for define, filename, pattern in FEATURES:
+        path = os.path.join(src_dir, filename)
+        found = False
+        if os.path.exists(path):
+            with open(path) as source:
+                found = re.search(pattern, source.read()) is not None
+        if not found:
+            defines.append(define)
+    return defines
+
+
+def build(revision, work_dir, args):
+    """Builds the regress worker with the library of the given revision."""
+    tree = os.path.join(work_dir, re.sub(r'[^A-Za-z0-9_.-]', '_', revision))
+    os.makedirs(tree)
+
+    archive = subprocess.run(
+        ['git', '-C', REPO_ROOT, 'archive', revision, 'src'], check=True,
+        capture_output=True).stdout
+    subprocess.run(['tar', '-x', '-C', tree], input=archive, check=True)
+    shutil.copytree(os.path.join(REPO_ROOT, 'benchmark'),
+                    os.path.join(tree, 'benchmark'),
+                    ignore=shutil.ignore_patterns('build*', '*.csv', '*.json'))
+
+    defines = missing_features(os.path.join(tree, 'src'))
+    if defines:
+        print(f"{revision} lacks some features, building with "
+              f"{' '.join(defines)}", file=sys.stderr)
+
+    bench_dir = os.path.join(tree, 'benchmark')
+    binary = os.path.join(tree, 'regress')
+    command = ([args.cxx, '-std=c++17'] + shlex.split(args.cxxflags) +
+               ['-D' + define for define in defines] +
+               ['-I', bench_dir, '-I', os.path.join(bench_dir, 'draup'),
+                os.path.join(bench_dir, 'regress.cpp'),
+                os.path.join(bench_dir, 'random.cpp'), '-o', binary] +
+               shlex.split(args.ldflags))
+
+    print(f"Building {revision}...", file=sys.stderr)
+    subprocess.run(command, check=True)
+    return binary
+
+
+def geometric_mean(values):
+    return math.exp(sum(math.log(v) for v in values) / len(values))
+
+
+def bootstrap_interval(ratios, confidence, resamples, rng):
+    means = sorted(
+        geometric_mean(rng.choices(ratios, k=len(ratios)))
+        for _ in range(resamples))
+    tail = (1 - confidence) / 2
+    low = means[int(math.floor(tail * (resamples - 1)))]
+    high = means[int(math.ceil((1 - tail) * (resamples - 1)))]
+    return low, high
+
+
+def sign_test(ratios):
+    """Two-sided sign test of the hypothesis that both builds are equal."""
+    slower = sum(1 for r in ratios if r > 1)
+    faster = sum(1 for r in ratios if r < 1)
+    n = slower + faster
+    if n == 0:
+        return 1.0
+    k = min(slower, faster)
+    p = sum(math.comb(n, i) for i in range(k + 1)) / 2**n
+    return min(1.0, 2 * p)
+
+
+def evaluate(name, pairs, args, rng):
+    ratios = [candidate / baseline for baseline, candidate in pairs]
+    ratio = geometric_mean(ratios)
+    low, high = bootstrap_interval(ratios, args.confidence,
+                                   args.resamples, rng)
+    p_value = sign_test(ratios)
+
+    if ratio > 1 + args.threshold and low > 1:
+        verdict = 'FAIL'
+    elif ratio < 1 - args.threshold and high < 1:
+        verdict = 'FASTER'
+    else:
+        verdict = 'PASS'
+
+    return {
+        'name': name,
+        'trials': len(pairs),
+        'baseline_ns': geometric_mean([p[0] for p in pairs]),
+        'candidate_ns': geometric_mean([p[1] for p in pairs]),
+        'ratio': ratio,
+        'ci_low': low,
+        'ci_high': high,
+        'p_value': p_value,
+        'verdict': verdict,
+    }
+
+
+def print_table(results, confidence):
+    width = max(len(r['name']) for r in results)
+    ci = f"{int(confidence * 100)}% CI"
+    print(f"{'Configuration':<{width}}  {'Baseline':>12}  {'Candidate':>12}"
+          f"  {'Ratio':>7}  {ci:>17}  {'p':>8}  Verdict")
+    for r in results:
+        interval = f"[{r['ci_low']:.3f}, {r['ci_high']:.3f}]"
+        print(f"{r['name']:<{width}}  {r['baseline_ns']:>12.0f}"
+              f"  {r['candidate_ns']:>12.0f}  {r['ratio']:>7.3f}"
+              f"  {interval:>17}  {r['p_value']:>8.2g}  {r['verdict']}")
+
+
+def write_csv(results, filename):
+    fields = ['name', 'trials', 'baseline_ns', 'candidate_ns', 'ratio',
+              'ci_low', 'ci_high', 'p_value', 'verdict']
+    with open(filename, 'w') as csv_file:
+        csv_file.write(','.join(fields) + '\n')
+        for r in results:
+            csv_file.write(','.join(str(r[f]) for f in fields) + '\n')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    baseline = parser.add_mutually_exclusive_group(required=True)
+    baseline.add_argument('--baseline', help='git revision of the baseline')
+    baseline.add_argument('--baseline-binary',
+                          help='regress binary of the baseline')
+    candidate = parser.add_mutually_exclusive_group(required=True)
+    candidate.add_argument('--candidate', help='git revision of the candidate')
+    candidate.add_argument('--candidate-binary',
+                           help='regress binary of the candidate')
+
+    parser.add_argument('--trials', type=int, default=30,
+                        help='paired trials per configuration')
+    parser.add_argument('--base-size', type=int, default=100000)
+    parser.add_argument('--experiment-size', type=int, default=1000)
+    parser.add_argument('--inner-iterations', type=int, default=20)
+    parser.add_argument('--seed', type=int, default=42)
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='tolerated slowdown, e.g. 0.05 for 5%%')
+    parser.add_argument('--confidence', type=float, default=0.95)
+    parser.add_argument('--resamples', type=int, default=2000,
+                        help='bootstrap resamples for the intervals')
+    parser.add_argument('--filter', default='',
+                        help='only run configurations matching this regex')
+    parser.add_argument('--csv', help='also write the results to this file')
+
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+    parser.add_argument('--cxxflags',
+                        default=os.environ.get('CXXFLAGS',
+                                               '-O3 -march=native -DNDEBUG'))
+    parser.add_argument('--ldflags',
+                        default=os.environ.get('LDFLAGS',
+                                               '-lbenchmark -lpthread'))
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    work_dir = tempfile.mkdtemp(prefix='ygg-regress-')
+    try:
+        baseline_binary = args.baseline_binary or build(
+            args.baseline, os.path.join(work_dir, 'baseline'), args)
+        candidate_binary = args.candidate_binary or build(
+            args.candidate, os.path.join(work_dir, 'candidate'), args)
+
+        workers = [
+            Worker(binary, args.base_size, args.experiment_size,
+                   args.inner_iterations)
+            for binary in (baseline_binary, candidate_binary)
+        ]
+
+        candidate_names = set(workers[1].names())
+        names = [n for n in workers[0].names()
+                 if n in candidate_names and re.search(args.filter, n)]
+        skipped = sorted(
+            n for n in set(workers[0].names()) ^ candidate_names
+            if re.search(args.filter, n))
+        for name in skipped:
+            print(f"Skipping {name}, only one build has it.", file=sys.stderr)
+        if not names:
+            print("No common configurations to compare.", file=sys.stderr)
+            return 2
+
+        # Trials are the outer loop, such that drifts (e.g., thermal
+        # throttling) affect all configurations alike.
+        pairs = {name: [] for name in names}
+        for trial in range(args.trials):
+            print(f"Trial {trial + 1}/{args.trials}...", file=sys.stderr)
+            seed = args.seed + trial
+            for name in names:
+                if trial % 2 == 0:
+                    baseline = workers[0].run(name, seed)
+                    candidate = workers[1].run(name, seed)
+                else:
+                    candidate = workers[1].run(name, seed)
+                    baseline = workers[0].run(name, seed)
+                pairs[name].append((baseline, candidate))
+
+        for worker in workers:
+            worker.close()
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+    rng = random.Random(args.seed)
+    results = [evaluate(name, pairs[name], args, rng) for name in names]
+
+    print_table(results, args.confidence)
+    if args.csv:
+        write_csv(results, args.csv)
+
+    failed = [r for r in results if r['verdict'] == 'FAIL']
+    if failed:
+        print(f"{len(failed)} of {len(results)} configurations regressed by "
+              f"more than {args.threshold * 100:.1f}%.", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -1,19 +1,30 @@
 #include "../src/benchmark_sequence.hpp"
 
+#include <optional>
 #include <ostream>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 
 int
 main(int argc, char ** argv)
 {
-	if (argc != 3) {
+	// With --compact, the output is written in the compact format that can be
+	// replayed by the replay benchmark.
+	bool compact = (argc == 4) && (std::string(argv[3]) == "--compact");
+	if ((argc != 3) && !compact) {
 		return -1;
 	}
 
 	using BSS = ygg::utilities::BenchmarkSequenceStorage<unsigned int>;
 	auto reader = BSS::Reader(argv[1]);
-	auto writer = BSS(argv[2]);
+	std::optional<BSS> writer;
+	std::optional<BSS::CompactWriter> compact_writer;
+	if (compact) {
+		compact_writer.emplace(argv[2]);
+	} else {
+		writer.emplace(argv[2]);
+	}
 
 	std::unordered_map<const void *, size_t> node_map;
 
@@ -45,24 +56,35 @@ main(int argc, char ** argv)
 				translated_id = reinterpret_cast<const void *>(0);
 			}
 
+			if (compact) {
+				size_t dense_id = reinterpret_cast<size_t>(translated_id);
+				if (entry.key.index() == 0) {
+					compact_writer->write(entry.type, dense_id, std::get<0>(entry.key));
+				} else {
+					compact_writer->write_search(entry.type, dense_id,
+					                             std::get<1>(entry.key));
+				}
+				continue;
+			}
+
 			switch (entry.type) {
 			case BSS::Type::INSERT:
-				writer.register_insert(translated_id, std::get<0>(entry.key));
+				writer->register_insert(translated_id, std::get<0>(entry.key));
 				break;
 			case BSS::Type::ERASE:
-				writer.register_erase(translated_id, std::get<0>(entry.key));
+				writer->register_erase(translated_id, std::get<0>(entry.key));
 				break;
 			case BSS::Type::DELETE:
-				writer.register_delete(translated_id, std::get<0>(entry.key));
+				writer->register_delete(translated_id, std::get<0>(entry.key));
 				break;
 			case BSS::Type::SEARCH:
-				writer.register_search(translated_id, std::get<1>(entry.key));
+				writer->register_search(translated_id, std::get<1>(entry.key));
 				break;
 			case BSS::Type::LBOUND:
-				writer.register_lbound(translated_id, std::get<1>(entry.key));
+				writer->register_lbound(translated_id, std::get<1>(entry.key));
 				break;
 			case BSS::Type::UBOUND:
-				writer.register_ubound(translated_id, std::get<1>(entry.key));
+				writer->register_ubound(translated_id, std::get<1>(entry.key));
 				break;
 			default:
 				break;
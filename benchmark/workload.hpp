@@ -0,0 +1,266 @@
+/*
+ * Generators for operation traces that resemble production workloads.
+ *
+ * The generators write compact traces (see BenchmarkSequenceStorage), which
+ * can be replayed by the replay benchmark. Keys are generated as 64-bit
+ * numbers and converted to the trace's key type by make_key(), so the same
+ * workload can be written with 32-bit, 64-bit or string keys.
+ *
+ * SlidingWindowWorkload: A time series. The newest entry is inserted with the
+ *   current timestamp, and once the window is full, the oldest entry is
+ *   deleted. Searches look up recent entries.
+ *
+ * HotSetWorkload: The tree keeps its size while random entries are replaced by
+ *   new ones. New keys mostly come from a hot range of the key space, which
+ *   moves from time to time. Searches mostly look up recently inserted keys.
+ */
+#ifndef BENCH_WORKLOAD_HPP
+#define BENCH_WORKLOAD_HPP
+
+#include "../src/benchmark_sequence.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A string key of fixed length. Compact traces require trivially copyable
+ * keys, thus the characters are stored inline. Keys are compared
+ * lexicographically.
+ */
+template <size_t length>
+struct StringKey
+{
+	std::array<char, length> chars;
+
+	bool
+	operator<(const StringKey & other) const noexcept
+	{
+		return std::memcmp(this->chars.data(), other.chars.data(), length) < 0;
+	}
+
+	bool
+	operator==(const StringKey & other) const noexcept
+	{
+		return std::memcmp(this->chars.data(), other.chars.data(), length) == 0;
+	}
+
+	std::string
+	to_string() const
+	{
+		return std::string(this->chars.data(), length);
+	}
+};
+
+// "key:" followed by 20 decimal digits, which is enough for any 64-bit number
+using WorkloadStringKey = StringKey<24>;
+
+/*
+ * Converts a generated 64-bit key to the key type of a trace. The workloads
+ * generate integral keys within the range of the key type. String keys are
+ * zero-padded decimals, such that they sort in the same order as the numbers.
+ */
+template <class KeyT>
+KeyT
+make_key(std::uint64_t raw)
+{
+	if constexpr (std::is_integral_v<KeyT>) {
+		return static_cast<KeyT>(raw);
+	} else {
+		KeyT key;
+		constexpr char prefix[] = "key:";
+		constexpr size_t prefix_length = sizeof(prefix) - 1;
+		static_assert(sizeof(key.chars) == prefix_length + 20,
+		              "String keys must have room for 20 digits.");
+
+		std::memcpy(key.chars.data(), prefix, prefix_length);
+		for (size_t i = key.chars.size(); i > prefix_length; --i) {
+			key.chars[i - 1] = static_cast<char>('0' + (raw % 10));
+			raw /= 10;
+		}
+		return key;
+	}
+}
+
+/*
+ * Timestamps in nanoseconds. Events occur every `interval` nanoseconds, but
+ * are recorded up to `jitter` nanoseconds late.
+ */
+class TimestampGenerator {
+public:
+	// 2020-09-13 12:26:40 UTC, in nanoseconds since the epoch
+	static constexpr std::uint64_t EPOCH = 1600000000000000000ull;
+
+	TimestampGenerator(std::uint64_t interval_in, std::uint64_t jitter_in)
+	    : interval(interval_in), jitter(jitter_in), now(EPOCH)
+	{}
+
+	std::uint64_t
+	next(std::mt19937_64 & rng)
+	{
+		this->now += this->interval;
+		if (this->jitter == 0) {
+			return this->now;
+		}
+		std::uniform_int_distribution<std::uint64_t> distr(0, this->jitter);
+		return this->now + distr(rng);
+	}
+
+private:
+	std::uint64_t interval;
+	std::uint64_t jitter;
+	std::uint64_t now;
+};
+
+template <class KeyT>
+class SlidingWindowWorkload {
+public:
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<KeyT>;
+
+	SlidingWindowWorkload(size_t window_in, double search_fraction_in,
+	                      std::uint64_t interval_in, std::uint64_t jitter_in,
+	                      unsigned long seed)
+	    : window(window_in), search_fraction(search_fraction_in),
+	      timestamps(interval_in, jitter_in), rng(seed)
+	{}
+
+	/* Writes `count` insertions, plus the deletions and searches that go with
+	 * them. Node ids are recycled, only window + 1 nodes are needed. */
+	void
+	generate(size_t count, typename BSS::CompactWriter & writer)
+	{
+		std::vector<KeyT> keys(this->window + 1);
+		std::uniform_real_distribution<double> udistr(0.0, 1.0);
+		// Searches go to the newest tenth of the window
+		size_t recent = std::max(size_t{1}, this->window / 10);
+
+		for (size_t i = 0; i < count; ++i) {
+			size_t slot = i % keys.size();
+			std::uint64_t timestamp = this->timestamps.next(this->rng);
+			if constexpr (sizeof(KeyT) < sizeof(std::uint64_t)) {
+				// Too narrow for timestamps, count microseconds since the epoch
+				timestamp = (timestamp - TimestampGenerator::EPOCH) / 1000;
+			}
+			keys[slot] = make_key<KeyT>(timestamp);
+			writer.write(BSS::Type::INSERT, slot + 1, keys[slot]);
+
+			if (i >= this->window) {
+				size_t oldest = (i - this->window) % keys.size();
+				writer.write(BSS::Type::DELETE, oldest + 1, keys[oldest]);
+			}
+
+			if (udistr(this->rng) < this->search_fraction) {
+				size_t live = std::min(i + 1, this->window);
+				std::uniform_int_distribution<size_t> age(
+				    0, std::min(live, recent) - 1);
+				size_t target = (i - age(this->rng)) % keys.size();
+				writer.write_search(BSS::Type::SEARCH, 0, keys[target]);
+			}
+		}
+	}
+
+private:
+	size_t window;
+	double search_fraction;
+	TimestampGenerator timestamps;
+	std::mt19937_64 rng;
+};
+
+template <class KeyT>
+class HotSetWorkload {
+public:
+	using BSS = ygg::utilities::BenchmarkSequenceStorage<KeyT>;
+
+	HotSetWorkload(size_t size_in, double hot_fraction_in,
+	               double hot_probability_in, size_t shift_interval_in,
+	               double search_fraction_in, unsigned long seed)
+	    : size(size_in), hot_fraction(hot_fraction_in),
+	      hot_probability(hot_probability_in),
+	      shift_interval(shift_interval_in),
+	      search_fraction(search_fraction_in), rng(seed), hot_start(0)
+	{}
+
+	/* First fills the tree with `size` entries, then writes `count`
+	 * replacements of a random entry by a new one. */
+	void
+	generate(size_t count, typename BSS::CompactWriter & writer)
+	{
+		std::vector<KeyT> keys(this->size);
+		std::vector<size_t> recently_inserted;
+		size_t recent_count = std::max(
+		    size_t{1}, static_cast<size_t>(this->hot_fraction *
+		                                   static_cast<double>(this->size)));
+		std::uniform_int_distribution<size_t> slot_distr(0, this->size - 1);
+		std::uniform_real_distribution<double> udistr(0.0, 1.0);
+
+		for (size_t slot = 0; slot < this->size; ++slot) {
+			keys[slot] = make_key<KeyT>(this->next_key(slot));
+			writer.write(BSS::Type::INSERT, slot + 1, keys[slot]);
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			size_t slot = slot_distr(this->rng);
+			writer.write(BSS::Type::DELETE, slot + 1, keys[slot]);
+			keys[slot] = make_key<KeyT>(this->next_key(this->size + i));
+			writer.write(BSS::Type::INSERT, slot + 1, keys[slot]);
+
+			if (recently_inserted.size() < recent_count) {
+				recently_inserted.push_back(slot);
+			} else {
+				recently_inserted[i % recent_count] = slot;
+			}
+
+			if (udistr(this->rng) < this->search_fraction) {
+				size_t target;
+				if (udistr(this->rng) < this->hot_probability) {
+					std::uniform_int_distribution<size_t> recent_distr(
+					    0, recently_inserted.size() - 1);
+					target = recently_inserted[recent_distr(this->rng)];
+				} else {
+					target = slot_distr(this->rng);
+				}
+				writer.write_search(BSS::Type::SEARCH, 0, keys[target]);
+			}
+		}
+	}
+
+private:
+	std::uint64_t
+	next_key(size_t index)
+	{
+		// Keys are non-negative, such that signed keys work as well
+		double key_space = 9223372036854775807.0;
+		if constexpr (std::is_integral_v<KeyT>) {
+			key_space = std::min(
+			    key_space,
+			    static_cast<double>(std::numeric_limits<KeyT>::max()));
+		}
+		std::uniform_real_distribution<double> udistr(0.0, 1.0);
+
+		if (index % this->shift_interval == 0) {
+			this->hot_start = udistr(this->rng) * (1.0 - this->hot_fraction);
+		}
+
+		double position = udistr(this->rng);
+		if (udistr(this->rng) < this->hot_probability) {
+			position = this->hot_start + position * this->hot_fraction;
+		}
+		return static_cast<std::uint64_t>(position * key_space);
+	}
+
+	size_t size;
+	double hot_fraction;
+	double hot_probability;
+	size_t shift_interval;
+	double search_fraction;
+	std::mt19937_64 rng;
+	double hot_start;
+};
+
+#endif
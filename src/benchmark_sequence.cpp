@@ -3,10 +3,17 @@
 
 #include "benchmark_sequence.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <type_traits>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace ygg {
 namespace utilities {
 
@@ -72,7 +79,7 @@ BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::Reader::verify_type()
 	                  std::is_integral_v<ValueT>,
 	                  std::is_floating_point_v<ValueT>,
 	                  std::is_signed_v<ValueT>,
-	                  !std::is_same_v<ValueT, void>};
+	                  has_value};
 
 	TypeInfo read_value_ti;
 	this->infile.read(reinterpret_cast<char *>(&read_value_ti),
@@ -352,6 +359,172 @@ BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::register_lbound(
 	}
 }
 
+template <class KeyT, class SearchKeyT, class ValueT>
+template <class T>
+typename BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::TypeInfo
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::compact_typeinfo()
+{
+	return TypeInfo{3,
+	                sizeof(T),
+	                std::is_integral_v<T>,
+	                std::is_floating_point_v<T>,
+	                std::is_signed_v<T>,
+	                true};
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::CompactWriter::
+    CompactWriter(std::string filename)
+    : outfile(filename, std::ios::binary)
+{
+	if (!this->outfile.good()) {
+		std::cout << "==== Could not open " << filename << "!\n";
+		exit(-1);
+	}
+
+	std::memcpy(this->header.magic, COMPACT_MAGIC, sizeof(COMPACT_MAGIC));
+	this->header.key_info = compact_typeinfo<KeyT>();
+	this->header.search_key_info = compact_typeinfo<SearchKeyT>();
+	this->header.record_size = sizeof(CompactRecord);
+	this->header.count = 0;
+	this->header.max_id = 0;
+
+	// Reserve space for the header. It is rewritten on destruction.
+	this->outfile.write(reinterpret_cast<const char *>(&this->header),
+	                    sizeof(CompactHeader));
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+BenchmarkSequenceStorage<KeyT, SearchKeyT,
+                         ValueT>::CompactWriter::~CompactWriter()
+{
+	this->outfile.seekp(0, std::ios::beg);
+	this->outfile.write(reinterpret_cast<const char *>(&this->header),
+	                    sizeof(CompactHeader));
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+void
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::CompactWriter::write(
+    Type type, size_t id, const KeyT & key)
+{
+	CompactRecord record;
+	std::memset(&record, 0, sizeof(CompactRecord));
+	record.op = (std::uint64_t{id} << 8) |
+	            static_cast<std::uint64_t>(type);
+	record.key = key;
+	this->write_record(record);
+	this->header.max_id = std::max(this->header.max_id, id);
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+void
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::CompactWriter::
+    write_search(Type type, size_t id, const SearchKeyT & search_key)
+{
+	CompactRecord record;
+	std::memset(&record, 0, sizeof(CompactRecord));
+	record.op = (std::uint64_t{id} << 8) |
+	            static_cast<std::uint64_t>(type);
+	record.search_key = search_key;
+	this->write_record(record);
+	this->header.max_id = std::max(this->header.max_id, id);
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+void
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::CompactWriter::
+    write_record(const CompactRecord & record)
+{
+	this->outfile.write(reinterpret_cast<const char *>(&record),
+	                    sizeof(CompactRecord));
+	this->header.count++;
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::MappedReader::
+    MappedReader(std::string filename)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+	struct stat file_stat;
+	if ((fd < 0) || (fstat(fd, &file_stat) != 0) ||
+	    (static_cast<size_t>(file_stat.st_size) < sizeof(CompactHeader))) {
+		std::cout << "==== Could not open " << filename << "!\n";
+		exit(-1);
+	}
+
+	this->mapping_size = static_cast<size_t>(file_stat.st_size);
+	int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+	flags |= MAP_POPULATE;
+#endif
+	this->mapping =
+	    mmap(nullptr, this->mapping_size, PROT_READ, flags, fd, 0);
+	close(fd);
+	if (this->mapping == MAP_FAILED) {
+		std::cout << "==== Could not map " << filename << "!\n";
+		exit(-1);
+	}
+	madvise(this->mapping, this->mapping_size, MADV_SEQUENTIAL);
+
+	this->header = reinterpret_cast<const CompactHeader *>(this->mapping);
+
+	TypeInfo key_ti = compact_typeinfo<KeyT>();
+	TypeInfo search_key_ti = compact_typeinfo<SearchKeyT>();
+	if ((std::memcmp(this->header->magic, COMPACT_MAGIC,
+	                 sizeof(COMPACT_MAGIC)) != 0) ||
+	    (key_ti != this->header->key_info) ||
+	    (search_key_ti != this->header->search_key_info) ||
+	    (this->header->record_size != sizeof(CompactRecord)) ||
+	    (this->mapping_size <
+	     sizeof(CompactHeader) + this->header->count * sizeof(CompactRecord))) {
+		munmap(this->mapping, this->mapping_size);
+		throw WrongTypeException{};
+	}
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+BenchmarkSequenceStorage<KeyT, SearchKeyT,
+                         ValueT>::MappedReader::~MappedReader()
+{
+	munmap(this->mapping, this->mapping_size);
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+const typename BenchmarkSequenceStorage<KeyT, SearchKeyT,
+                                        ValueT>::CompactRecord *
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::MappedReader::begin()
+    const noexcept
+{
+	// The header's size is a multiple of 8, so the records are aligned
+	return reinterpret_cast<const CompactRecord *>(this->header + 1);
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+const typename BenchmarkSequenceStorage<KeyT, SearchKeyT,
+                                        ValueT>::CompactRecord *
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::MappedReader::end()
+    const noexcept
+{
+	return this->begin() + this->header->count;
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+size_t
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::MappedReader::size()
+    const noexcept
+{
+	return this->header->count;
+}
+
+template <class KeyT, class SearchKeyT, class ValueT>
+size_t
+BenchmarkSequenceStorage<KeyT, SearchKeyT, ValueT>::MappedReader::get_max_id()
+    const noexcept
+{
+	return this->header->max_id;
+}
+
 } // namespace utilities
 } // namespace ygg
 #endif
@@ -2,6 +2,7 @@
 #define YGG_BENCHMARK_SEQUENCE_HPP
 
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <tuple>
@@ -125,7 +126,7 @@ public:
 			         (this->is_integral == other.is_integral) &&
 			         (this->is_float == other.is_float) &&
 			         (this->is_signed == other.is_signed) &&
-			         (this->present = other.present));
+			         (this->present == other.present));
 		}
 	};
 
@@ -143,6 +144,98 @@ public:
 		size_t remaining_in_chunk;
 	};
 
+	/**
+	 * @brief A fixed-width record of the compact trace format
+	 *
+	 * In compact traces, node pointers are replaced by dense ids (starting at 1,
+	 * with 0 denoting "no node"), such that a node can be looked up by indexing
+	 * into an array. Values are not stored. Since every record has the same
+	 * size, a compact trace can be memory-mapped and replayed without any
+	 * parsing, see MappedReader.
+	 */
+	struct CompactRecord
+	{
+		static_assert(std::is_trivially_copyable_v<KeyT> &&
+		                  std::is_trivially_copyable_v<SearchKeyT>,
+		              "Compact traces require trivially copyable keys.");
+
+		// The node id in the upper 56 bits, the Type in the lower 8 bits
+		std::uint64_t op;
+		// key is set for INSERT, DELETE and ERASE, search_key for all others
+		union {
+			KeyT key;
+			SearchKeyT search_key;
+		};
+
+		Type
+		get_type() const noexcept
+		{
+			return static_cast<Type>(this->op & 0xFF);
+		}
+
+		size_t
+		get_id() const noexcept
+		{
+			return this->op >> 8;
+		}
+	};
+
+	struct CompactHeader
+	{
+		char magic[8];
+		TypeInfo key_info;
+		TypeInfo search_key_info;
+		size_t record_size;
+		size_t count;
+		// The largest node id used by any record
+		size_t max_id;
+	};
+
+	/**
+	 * @brief Writes a trace in the compact format
+	 *
+	 * The header is completed when the writer is destroyed.
+	 */
+	class CompactWriter {
+	public:
+		CompactWriter(std::string filename);
+		~CompactWriter();
+
+		void write(Type type, size_t id, const KeyT & key);
+		void write_search(Type type, size_t id, const SearchKeyT & search_key);
+
+	private:
+		void write_record(const CompactRecord & record);
+
+		std::ofstream outfile;
+		CompactHeader header;
+	};
+
+	/**
+	 * @brief Memory-maps a trace in the compact format
+	 *
+	 * The records can be iterated directly from the mapping. The whole file is
+	 * faulted in when it is opened, so that replaying the records is not slowed
+	 * down by I/O.
+	 */
+	class MappedReader {
+	public:
+		MappedReader(std::string filename);
+		~MappedReader();
+		MappedReader(const MappedReader & other) = delete;
+		MappedReader & operator=(const MappedReader & other) = delete;
+
+		const CompactRecord * begin() const noexcept;
+		const CompactRecord * end() const noexcept;
+		size_t size() const noexcept;
+		size_t get_max_id() const noexcept;
+
+	private:
+		void * mapping;
+		size_t mapping_size;
+		const CompactHeader * header;
+	};
+
 	template <class Dummy = KeyT>
 	void register_insert(const void * id,
 	                     const std::enable_if_t<!has_value, Dummy> & key);
@@ -166,6 +259,11 @@ private:
 	void write_typeinfo();
 	void sync();
 
+	template <class T>
+	static TypeInfo compact_typeinfo();
+	constexpr static char COMPACT_MAGIC[8] = {'Y', 'G', 'G', 'T',
+	                                          'R', 'A', 'C', 'E'};
+
 	std::string filename;
 	bool file_exists(const std::string & test_file) const;
 	std::string get_filename() const;
@@ -49,7 +49,11 @@ Node *
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_parent() const noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_parent();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_parent(this);
+		} else {
+			Options::PointerGetCallback::get_parent();
+		}
 	}
 	return this->_bst_parent.get_parent();
 }
@@ -60,7 +64,11 @@ std::enable_if_t<InnerPC::parent_reference, Node *&>
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_parent() const noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_parent();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_parent(this);
+		} else {
+			Options::PointerGetCallback::get_parent();
+		}
 	}
 	return this->_bst_parent.get_parent();
 }
@@ -70,7 +78,11 @@ Node *&
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_left() noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_left();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_left(this);
+		} else {
+			Options::PointerGetCallback::get_left();
+		}
 	}
 	return this->_bst_children[0];
 }
@@ -80,7 +92,11 @@ Node *&
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_right() noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_right();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_right(this);
+		} else {
+			Options::PointerGetCallback::get_right();
+		}
 	}
 	return this->_bst_children[1];
 }
@@ -90,7 +106,11 @@ Node * const &
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_left() const noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_left();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_left(this);
+		} else {
+			Options::PointerGetCallback::get_left();
+		}
 	}
 	return this->_bst_children[0];
 }
@@ -100,7 +120,11 @@ Node * const &
 BSTNodeBase<Node, Options, Tag, ParentContainer>::get_right() const noexcept
 {
 	if constexpr (Options::has_pointer_get_callback) {
-		Options::PointerGetCallback::get_right();
+		if constexpr (Options::pointer_get_callback_takes_node) {
+			Options::PointerGetCallback::get_right(this);
+		} else {
+			Options::PointerGetCallback::get_right();
+		}
 	}
 	return this->_bst_children[1];
 }
@@ -153,6 +177,10 @@ BinarySearchTree<Node, Options, Tag, Compare,
 	this->root = other.root;
 	other.root = nullptr;
 	this->s = other.s;
+	this->stat_counters() = other.stat_counters();
+	if constexpr (Options::collect_statistics) {
+		this->cmp = other.cmp;
+	}
 }
 
 template <class Node, class Options, class Tag, class Compare,
@@ -164,6 +192,10 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::operator=(
 	this->root = other.root;
 	other.root = nullptr;
 	this->s = other.s;
+	this->stat_counters() = other.stat_counters();
+	if constexpr (Options::collect_statistics) {
+		this->cmp = other.cmp;
+	}
 }
 
 template <class Node, class Options, class Tag, class Compare,
@@ -175,6 +207,42 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::clear() noexcept
 	this->s.set(0);
 }
 
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+stats::Counters
+BinarySearchTree<Node, Options, Tag, Compare,
+                 ParentContainer>::get_statistics() const noexcept
+{
+	static_assert(Options::collect_statistics,
+	              "Statistics are only collected with COLLECT_STATISTICS.");
+
+	stats::Counters counters = this->stat_counters().get();
+	counters.comparisons = this->cmp.get_count();
+	return counters;
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+void
+BinarySearchTree<Node, Options, Tag, Compare,
+                 ParentContainer>::reset_statistics() noexcept
+{
+	this->stat_counters().reset();
+	if constexpr (Options::collect_statistics) {
+		this->cmp.reset_count();
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+stats::Shape
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::collect_shape()
+    const
+{
+	return stats::compute_shape<NodeInterface>(
+	    static_cast<const Node *>(this->root));
+}
+
 template <class Node, class Options, class Tag, class Compare,
           class ParentContainer>
 Node *
@@ -629,6 +697,7 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 	                          Options::SequenceInterface::get_key(query));
 #endif
 
+	decltype(auto) key = this->search_key(query);
 	Node * cur = this->root;
 	cbs->init_root(cur);
 
@@ -636,10 +705,10 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 	 * to ensure the callbacks are called in the right way. */
 
 	while (cur != nullptr) {
-		if (this->cmp(*cur, query)) {
+		if (this->cmp(*cur, key)) {
 			cur = cur->NB::get_right();
 			cbs->descend_right(cur);
-		} else if (this->cmp(query, *cur)) {
+		} else if (this->cmp(key, *cur)) {
 			cur = cur->NB::get_left();
 			cbs->descend_left(cur);
 		} else {
@@ -652,6 +721,35 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 	return this->end();
 }
 
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+decltype(auto)
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::search_key(
+    const Comparable & query) noexcept
+{
+	if constexpr (Options::bst_cache_key &&
+	              std::is_base_of<NB, Comparable>::value) {
+		return Options::bst_cached_key::type::get_key(
+		    static_cast<const Node &>(query));
+	} else {
+		return query;
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+void
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::cache_key(
+    Node & node) noexcept
+{
+	if constexpr (Options::bst_cache_key) {
+		node.NB::_bst_key = Options::bst_cached_key::type::get_key(node);
+	} else {
+		(void)node;
+	}
+}
+
 template <class Node, class Options, class Tag, class Compare,
           class ParentContainer>
 Node *
@@ -687,6 +785,7 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 	                          Options::SequenceInterface::get_key(query));
 #endif
 
+	decltype(auto) key = this->search_key(query);
 	Node * cur = this->root;
 	Node * last_left = nullptr;
 
@@ -701,15 +800,15 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 			(void)last_left;
 
 			if (__builtin_expect(
-			        (!this->cmp(*cur, query)) && (!this->cmp(query, *cur)), false)) {
+			        (!this->cmp(*cur, key)) && (!this->cmp(key, *cur)), false)) {
 				if constexpr (ensure_first) {
 					cur = this->get_first_equal(cur);
 				}
 				return iterator<false>(cur);
 			}
-			cur = utilities::go_right_if(this->cmp(*cur, query), cur);
+			cur = utilities::go_right_if(this->cmp(*cur, key), cur);
 		} else {
-			if (this->cmp(*cur, query)) {
+			if (this->cmp(*cur, key)) {
 				cur = cur->NB::get_right();
 			} else {
 				last_left = cur;
@@ -719,7 +818,7 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find(
 	}
 
 	if constexpr (!Options::micro_avoid_conditionals) {
-		if ((last_left != nullptr) && (!this->cmp(query, *last_left))) {
+		if ((last_left != nullptr) && (!this->cmp(key, *last_left))) {
 			if constexpr (ensure_first) {
 				last_left = this->get_first_equal(last_left);
 			}
@@ -760,19 +859,119 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::lower_bound(
 	                          Options::SequenceInterface::get_key(query));
 #endif
 
-	// TODO avoid conditionals!
-	Node * cur = this->root;
-	Node * last_left = nullptr;
+	Node * last_left =
+	    this->lower_bound_below(this->root, nullptr, this->search_key(query));
 
+	if (last_left != nullptr) {
+		return iterator<false>(last_left);
+	} else {
+		return this->end();
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+Node *
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::
+    lower_bound_below(Node * cur, Node * last_left,
+                      const Comparable & query) CMP_NOEXCEPT(query)
+{
 	while (cur != nullptr) {
-		if (this->cmp(*cur, query)) {
-			cur = cur->NB::get_right();
+		if constexpr (Options::micro_avoid_conditionals) {
+			const bool goes_right = this->cmp(*cur, query);
+			last_left = goes_right ? last_left : cur;
+			cur = utilities::go_right_if(goes_right, cur);
 		} else {
-			last_left = cur;
-			cur = cur->NB::get_left();
+			if (this->cmp(*cur, query)) {
+				cur = cur->NB::get_right();
+			} else {
+				last_left = cur;
+				cur = cur->NB::get_left();
+			}
 		}
 	}
 
+	return last_left;
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+Node *
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::
+    climb_from_finger(Node * finger, const Comparable & query,
+                      Node *& upper) CMP_NOEXCEPT(query)
+{
+	/* The subtree below <anchor> is bounded by the closest ancestor it is a left
+	 * descendant of (from above) and the closest ancestor it is a right
+	 * descendant of (from below). If the path of <query> passes both of these in
+	 * the right direction, it passes all ancestors in the right direction.
+	 *
+	 * The direction <query> takes at <anchor> itself already implies one of the
+	 * two bounds: If it goes left, query <= anchor <= upper bound, and vice
+	 * versa. */
+	Node * anchor = finger;
+	Node * cur = finger;
+	upper = nullptr;
+
+	bool upper_ok = !this->cmp(*anchor, query);
+	bool lower_ok = !upper_ok;
+
+	while (!(upper_ok && lower_ok)) {
+		Node * prev = cur;
+		cur = cur->NB::get_parent();
+
+		if (__builtin_expect(cur == nullptr, false)) {
+			// Climbed past the root - everything above anchor has been checked.
+			break;
+		}
+
+		const bool ascended_left = (cur->NB::get_left() == prev);
+		const bool goes_left = !this->cmp(*cur, query);
+
+		if (ascended_left && goes_left) {
+			if (!upper_ok) {
+				upper = cur;
+			}
+			upper_ok = true;
+		} else if (!ascended_left && !goes_left) {
+			lower_ok = true;
+		} else {
+			// Wrong turn - the path of query goes through cur.
+			anchor = cur;
+			upper = nullptr;
+			upper_ok = goes_left;
+			lower_ok = !goes_left;
+		}
+	}
+
+	return anchor;
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+typename BinarySearchTree<Node, Options, Tag, Compare,
+                          ParentContainer>::template iterator<false>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::
+    lower_bound_from(iterator<false> finger,
+                     const Comparable & query) CMP_NOEXCEPT(query)
+{
+	if (finger == this->end()) {
+		return this->lower_bound(query);
+	}
+
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_lbound(reinterpret_cast<const void *>(&query),
+	                          Options::SequenceInterface::get_key(query));
+#endif
+
+	decltype(auto) key = this->search_key(query);
+	Node * upper;
+	Node * anchor = this->climb_from_finger(&*finger, key, upper);
+	Node * last_left = this->lower_bound_below(anchor, upper, key);
+
 	if (last_left != nullptr) {
 		return iterator<false>(last_left);
 	} else {
@@ -780,6 +979,57 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::lower_bound(
 	}
 }
 
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+typename BinarySearchTree<Node, Options, Tag, Compare,
+                          ParentContainer>::template const_iterator<false>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::
+    lower_bound_from(const_iterator<false> finger,
+                     const Comparable & query) const CMP_NOEXCEPT(query)
+{
+	if (finger == this->cend()) {
+		return this->lower_bound(query);
+	}
+
+	MyClass * self = const_cast<MyClass *>(this);
+	return const_iterator<false>(self->lower_bound_from(
+	    self->iterator_to(const_cast<Node &>(*finger)), query));
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+typename BinarySearchTree<Node, Options, Tag, Compare,
+                          ParentContainer>::template iterator<false>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find_from(
+    iterator<false> finger, const Comparable & query) CMP_NOEXCEPT(query)
+{
+	auto it = this->lower_bound_from(finger, query);
+	if ((it != this->end()) && !this->cmp(this->search_key(query), *it)) {
+		return it;
+	} else {
+		return this->end();
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+typename BinarySearchTree<Node, Options, Tag, Compare,
+                          ParentContainer>::template const_iterator<false>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::find_from(
+    const_iterator<false> finger, const Comparable & query) const
+    CMP_NOEXCEPT(query)
+{
+	auto it = this->lower_bound_from(finger, query);
+	if ((it != this->cend()) && !this->cmp(this->search_key(query), *it)) {
+		return it;
+	} else {
+		return this->cend();
+	}
+}
+
 template <class Node, class Options, class Tag, class Compare,
           class ParentContainer>
 template <class Comparable>
@@ -793,24 +1043,122 @@ BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::upper_bound(
 	                          Options::SequenceInterface::get_key(query));
 #endif
 
-	// TODO avoid conditionals!
+	Node * last_left =
+	    this->upper_bound_below(this->root, nullptr, this->search_key(query));
+
+	if (last_left != nullptr) {
+		return iterator<false>(last_left);
+	} else {
+		return this->end();
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+Node *
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::
+    upper_bound_below(Node * cur, Node * last_left,
+                      const Comparable & query) CMP_NOEXCEPT(query)
+{
+	while (cur != nullptr) {
+		if constexpr (Options::micro_avoid_conditionals) {
+			const bool goes_left = this->cmp(query, *cur);
+			last_left = goes_left ? cur : last_left;
+			cur = utilities::go_left_if(goes_left, cur);
+		} else {
+			if (this->cmp(query, *cur)) {
+				last_left = cur;
+				cur = cur->NB::get_left();
+			} else {
+				cur = cur->NB::get_right();
+			}
+		}
+	}
+
+	return last_left;
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+std::pair<typename BinarySearchTree<Node, Options, Tag, Compare,
+                                    ParentContainer>::template iterator<false>,
+          typename BinarySearchTree<Node, Options, Tag, Compare,
+                                    ParentContainer>::template iterator<false>>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::equal_range(
+    const Comparable & query) CMP_NOEXCEPT(query)
+{
+	decltype(auto) key = this->search_key(query);
 	Node * cur = this->root;
 	Node * last_left = nullptr;
 
+	// Both bounds share the path down to the first equal node
 	while (cur != nullptr) {
-		if (this->cmp(query, *cur)) {
+		if (this->cmp(*cur, key)) {
+			cur = cur->NB::get_right();
+		} else if (this->cmp(key, *cur)) {
 			last_left = cur;
-			cur = cur->get_left();
+			cur = cur->NB::get_left();
 		} else {
-			cur = cur->get_right();
+			break;
 		}
 	}
 
-	if (last_left != nullptr) {
-		return iterator<false>(last_left);
-	} else {
-		return this->end();
+	if (cur == nullptr) {
+		// Nothing compares equally. Note that iterator<false>(nullptr) is end().
+		return {iterator<false>(last_left), iterator<false>(last_left)};
 	}
+
+	Node * lower = this->lower_bound_below(cur->NB::get_left(), cur, key);
+	Node * upper =
+	    this->upper_bound_below(cur->NB::get_right(), last_left, key);
+
+	return {iterator<false>(lower), iterator<false>(upper)};
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+std::pair<
+    typename BinarySearchTree<Node, Options, Tag, Compare,
+                              ParentContainer>::template const_iterator<false>,
+    typename BinarySearchTree<Node, Options, Tag, Compare,
+                              ParentContainer>::template const_iterator<false>>
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::equal_range(
+    const Comparable & query) const CMP_NOEXCEPT(query)
+{
+	auto range = const_cast<MyClass *>(this)->equal_range(query);
+	return {const_iterator<false>(range.first),
+	        const_iterator<false>(range.second)};
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class Comparable>
+size_t
+BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>::count(
+    const Comparable & query) const CMP_NOEXCEPT(query)
+{
+	auto range = this->equal_range(query);
+
+	size_t count = 0;
+	for (auto it = range.first; it != range.second; ++it) {
+		count++;
+	}
+
+	return count;
+}
+
+template <class Node, class Options, class Tag, class Compare,
+          class ParentContainer>
+template <class KeyExtractor>
+EytzingerSnapshot<Node, typename KeyExtractor::key_type>
+BinarySearchTree<Node, Options, Tag, Compare,
+                 ParentContainer>::freeze_eytzinger()
+{
+	return EytzingerSnapshot<Node, typename KeyExtractor::key_type>::
+	    template from_sorted<KeyExtractor>(this->begin(), this->end());
 }
 
 template <class Node, class Options, class Tag, class Compare,
@@ -1,8 +1,10 @@
 #ifndef YGG_BST_HPP
 #define YGG_BST_HPP
 
+#include "eytzinger.hpp"
 #include "options.hpp"
 #include "size_holder.hpp"
+#include "stats.hpp"
 #include "tree_iterator.hpp"
 #include "util.hpp"
 
@@ -10,6 +12,7 @@
 #include <cstddef>
 #include <set>
 #include <type_traits>
+#include <utility>
 
 #ifdef YGG_STORE_SEQUENCE
 #include "benchmark_sequence.hpp"
@@ -73,9 +76,63 @@ public:
 	static DefaultFindCallbacks<Node> dummy;
 };
 
+/* Holds the key cached by TreeFlags::BST_CACHED_KEY. If that option is not
+ * set, this class is empty and does not take up any space in the node. */
+template <class Options, class Tag, bool cache = Options::bst_cache_key>
+class CachedKeyHolder {
+};
+
+template <class Options, class Tag>
+class CachedKeyHolder<Options, Tag, true> {
+public:
+	using KeyExtractor = typename Options::bst_cached_key::type;
+	using Key = typename KeyExtractor::key_type;
+	static_assert(std::is_integral<Key>::value,
+	              "BST_CACHED_KEY requires an integral key_type.");
+
+	Key _bst_key;
+};
+
+/* The comparator used by trees with TreeFlags::BST_CACHED_KEY set. Nodes are
+ * compared via their cached keys, everything else via Compare. */
+template <class Node, class NB, class Options, class Compare>
+class CachedKeyCompare {
+public:
+	using Key = typename Options::bst_cached_key::type::key_type;
+
+	[[gnu::always_inline, gnu::pure]] inline bool
+	operator()(const Node & lhs, const Node & rhs) const noexcept
+	{
+		return lhs.NB::_bst_key < rhs.NB::_bst_key;
+	}
+
+	[[gnu::always_inline, gnu::pure]] inline bool
+	operator()(const Node & lhs, const Key & rhs) const noexcept
+	{
+		return lhs.NB::_bst_key < rhs;
+	}
+
+	[[gnu::always_inline, gnu::pure]] inline bool
+	operator()(const Key & lhs, const Node & rhs) const noexcept
+	{
+		return lhs < rhs.NB::_bst_key;
+	}
+
+	template <class T1, class T2>
+	[[gnu::always_inline]] inline bool
+	operator()(const T1 & lhs, const T2 & rhs) const
+	    noexcept(noexcept(std::declval<const Compare &>()(lhs, rhs)))
+	{
+		return this->cmp(lhs, rhs);
+	}
+
+private:
+	Compare cmp;
+};
+
 template <class Node, class Options, class Tag = int,
           class ParentContainer = DefaultParentContainer<Node>>
-class BSTNodeBase {
+class BSTNodeBase : public CachedKeyHolder<Options, Tag> {
 
 private:
 	/* Determine whether our parent storage allows us to obtain a
@@ -121,10 +178,25 @@ public:
 	size_t get_depth() const noexcept;
 };
 
+/* The key extractor used by freeze_eytzinger() by default: The one given to
+ * TreeFlags::BST_CACHED_KEY, if that option is set. */
+template <class Options, bool cache = Options::bst_cache_key>
+class DefaultSnapshotKeyExtractor {
+public:
+	using type = void;
+};
+
+template <class Options>
+class DefaultSnapshotKeyExtractor<Options, true> {
+public:
+	using type = typename Options::bst_cached_key::type;
+};
+
 template <class Node, class Options, class Tag = int,
           class Compare = ygg::utilities::flexible_less,
           class ParentContainer = DefaultParentContainer<Node>>
-class BinarySearchTree {
+class BinarySearchTree
+    : private stats::CounterHolder<Options::collect_statistics> {
 public:
 	using MyClass =
 	    BinarySearchTree<Node, Options, Tag, Compare, ParentContainer>;
@@ -257,9 +329,36 @@ public:
 	 ******************************************************/
 
 protected:
+	/* With TreeFlags::BST_CACHED_KEY set, Node queries are replaced by their
+	 * keys before descending, since only nodes in the tree have their keys
+	 * cached. Any other query is passed through unchanged. */
+	template <class Comparable>
+	[[gnu::always_inline]] static inline decltype(auto)
+	search_key(const Comparable & query) noexcept;
+	/* Caches the key of <node>, which is about to be inserted. A no-op unless
+	 * TreeFlags::BST_CACHED_KEY is set. */
+	[[gnu::always_inline]] static inline void cache_key(Node & node) noexcept;
+
 	// TODO document
 	inline Node * get_first_equal(Node * n) noexcept;
 
+	/* Climbs up from <finger> to the lowest node (possibly <finger> itself) that
+	 * lies on the path lower_bound(<query>) would take from the root, i.e., for
+	 * which every ancestor was passed in the right direction. <upper> is set to
+	 * the last ancestor the path descended left from, if any was seen. */
+	template <class Comparable>
+	Node * climb_from_finger(Node * finger, const Comparable & query,
+	                         Node *& upper) CMP_NOEXCEPT(query);
+	/* Runs the lower_bound() descent in the subtree rooted at <cur>, with
+	 * <last_left> being the candidate found above <cur>. */
+	template <class Comparable>
+	Node * lower_bound_below(Node * cur, Node * last_left,
+	                         const Comparable & query) CMP_NOEXCEPT(query);
+	/* Same for upper_bound(). */
+	template <class Comparable>
+	Node * upper_bound_below(Node * cur, Node * last_left,
+	                         const Comparable & query) CMP_NOEXCEPT(query);
+
 public:
 	// TODO document ensure_firstx
 	/**
@@ -349,6 +448,113 @@ public:
 	template <class Comparable>
 	iterator<false> lower_bound(const Comparable & query) CMP_NOEXCEPT(query);
 
+	/**
+	 * @brief Lower-bounds an element, starting at a finger
+	 *
+	 * Returns the same as lower_bound(<query>), but instead of starting the
+	 * search at the root, it climbs up from <finger> only as far as necessary.
+	 * If the result is d elements away from <finger>, this usually costs
+	 * O(log d) instead of O(log n), which makes it a good fit for queries that
+	 * arrive (nearly) sorted. The worst case is still O(log n), e.g., if
+	 * <finger> and the result lie on different sides of the root.
+	 *
+	 * @param finger An iterator into this tree at which the search starts. If it
+	 * is end(), this is equivalent to lower_bound(<query>).
+	 * @param query An object comparable to Node that should be lower-bounded
+	 * @returns An iterator to the first element comparing greater-or-equally to
+	 * <query>, or end() if no such element exists
+	 */
+	template <class Comparable>
+	const_iterator<false> lower_bound_from(const_iterator<false> finger,
+	                                       const Comparable & query) const
+	    CMP_NOEXCEPT(query);
+	template <class Comparable>
+	iterator<false> lower_bound_from(iterator<false> finger,
+	                                 const Comparable & query)
+	    CMP_NOEXCEPT(query);
+
+	/**
+	 * @brief Finds an element, starting at a finger
+	 *
+	 * Like find(<query>), but starting the search at <finger>. See
+	 * lower_bound_from() for the cost of this.
+	 *
+	 * @param finger An iterator into this tree at which the search starts. If it
+	 * is end(), this is equivalent to find(<query>).
+	 * @param query An object comparing equally to the element that should be
+	 * found.
+	 * @returns An iterator to the first element comparing equally to <query>, or
+	 * end() if no such element exists
+	 */
+	template <class Comparable>
+	const_iterator<false> find_from(const_iterator<false> finger,
+	                                const Comparable & query) const
+	    CMP_NOEXCEPT(query);
+	template <class Comparable>
+	iterator<false> find_from(iterator<false> finger, const Comparable & query)
+	    CMP_NOEXCEPT(query);
+
+	/**
+	 * @brief Returns the range of elements comparing equally to <query>
+	 *
+	 * Returns a pair of iterators, the first being lower_bound(<query>) and the
+	 * second being upper_bound(<query>). Both are found by descending the tree
+	 * once, splitting the descent at the first node comparing equally to
+	 * <query>. Thus, this runs in O(log n) regardless of the number of equal
+	 * elements. See lower_bound() for the requirements on <query>.
+	 *
+	 * @param query An object comparable to Node
+	 * @returns A pair of iterators delimiting the elements comparing equally to
+	 * <query>.
+	 */
+	template <class Comparable>
+	std::pair<const_iterator<false>, const_iterator<false>>
+	equal_range(const Comparable & query) const CMP_NOEXCEPT(query);
+	template <class Comparable>
+	std::pair<iterator<false>, iterator<false>>
+	equal_range(const Comparable & query) CMP_NOEXCEPT(query);
+
+	/**
+	 * @brief Counts the elements comparing equally to <query>
+	 *
+	 * Counts by iterating over equal_range(<query>), thus this runs in
+	 * O(log n + k), where k is the number of counted elements. Trees that keep
+	 * track of subtree sizes provide a count() that runs in O(log n).
+	 *
+	 * @param query An object comparable to Node
+	 * @returns The number of elements comparing equally to <query>
+	 */
+	template <class Comparable>
+	size_t count(const Comparable & query) const CMP_NOEXCEPT(query);
+
+	/**
+	 * @brief Creates an array-based, read-only copy of the tree
+	 *
+	 * Copies the keys of all elements, together with pointers to the elements,
+	 * into an EytzingerSnapshot. Searching the snapshot does not chase any
+	 * pointers and is usually several times faster than searching the tree,
+	 * which makes it a good read replica during long read-only phases.
+	 *
+	 * The snapshot is not updated when the tree is modified. Create a new one
+	 * after modifying the tree.
+	 *
+	 * This method runs in O(n).
+	 *
+	 * @tparam KeyExtractor A class with a member type key_type and a static
+	 * method
+	 *
+	 * key_type get_key(const Node &)
+	 *
+	 * which returns the key of a node. The order of the keys must be the order
+	 * of the tree. If TreeFlags::BST_CACHED_KEY is set, its KeyExtractor is used
+	 * by default.
+	 *
+	 * @returns A snapshot of all elements in the tree
+	 */
+	template <class KeyExtractor =
+	              typename DefaultSnapshotKeyExtractor<Options>::type>
+	EytzingerSnapshot<Node, typename KeyExtractor::key_type> freeze_eytzinger();
+
 	/**
 	 * @brief Debugging Method: Draw the Tree as a .dot file
 	 *
@@ -439,6 +645,34 @@ public:
 	 */
 	bool empty() const noexcept;
 
+	/**
+	 * @brief Returns how many structural operations the tree has performed
+	 *
+	 * Counts rotations, zips, unzips and comparisons since the tree was created
+	 * or reset_statistics() was called.
+	 *
+	 * @warning This method is only available if COLLECT_STATISTICS is set as
+	 * option!
+	 *
+	 * @return The counters of this tree
+	 */
+	stats::Counters get_statistics() const noexcept;
+
+	/**
+	 * @brief Resets all counters returned by get_statistics() to zero
+	 */
+	void reset_statistics() noexcept;
+
+	/**
+	 * @brief Computes the current shape of the tree
+	 *
+	 * This walks the whole tree and thus runs in O(n). It is available
+	 * regardless of COLLECT_STATISTICS.
+	 *
+	 * @return The depth histogram, average path length and maximum depth
+	 */
+	stats::Shape collect_shape() const;
+
 	// TODO document
 	// TODO do we need them anymore?
 	Node * get_root() const noexcept;
@@ -460,10 +694,30 @@ protected:
 	Node * get_largest() const noexcept;
 	Node * get_uncle(Node * node) const noexcept;
 
-	Compare cmp;
+	using UncountedKeyCompare =
+	    typename std::conditional<Options::bst_cache_key,
+	                              CachedKeyCompare<Node, NB, Options, Compare>,
+	                              Compare>::type;
+	using KeyCompare =
+	    typename std::conditional<Options::collect_statistics,
+	                              stats::CountingCompare<UncountedKeyCompare>,
+	                              UncountedKeyCompare>::type;
+	KeyCompare cmp;
 
 	SizeHolder<Options::constant_time_size> s;
 
+	using StatCounters = stats::CounterHolder<Options::collect_statistics>;
+	StatCounters &
+	stat_counters() noexcept
+	{
+		return *this;
+	}
+	const StatCounters &
+	stat_counters() const noexcept
+	{
+		return *this;
+	}
+
 	/* What follows are debugging tools */
 	template <class NodeNameGetter>
 	void dump_to_dot_base(const std::string & filename,
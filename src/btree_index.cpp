@@ -0,0 +1,746 @@
+#ifndef YGG_BTREE_INDEX_CPP
+#define YGG_BTREE_INDEX_CPP
+
+#include "btree_index.hpp"
+
+#include "debug.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ygg {
+
+template <class Node, class NodeTraits, class Options, class Compare>
+BTreeIndex<Node, NodeTraits, Options, Compare>::BTreeIndex() noexcept
+    : root(nullptr), height(0), first_leaf(nullptr), last_leaf(nullptr), s(0)
+{}
+
+/*
+ * Searching
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::key_type
+BTreeIndex<Node, NodeTraits, Options, Compare>::search_key(const Node & query)
+{
+	return NodeTraits::get_key(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+const Comparable &
+BTreeIndex<Node, NodeTraits, Options, Compare>::search_key(
+    const Comparable & query) noexcept
+{
+	return query;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+size_t
+BTreeIndex<Node, NodeTraits, Options, Compare>::count_less(
+    const key_type * keys, size_t n, const Comparable & query) noexcept
+{
+	Compare cmp;
+	size_t result = 0;
+	// No early exit - this loop must stay free of branches to be vectorized
+	for (size_t i = 0; i < n; ++i) {
+		result += static_cast<size_t>(cmp(keys[i], query));
+	}
+	return result;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+size_t
+BTreeIndex<Node, NodeTraits, Options, Compare>::count_less_equal(
+    const key_type * keys, size_t n, const Comparable & query) noexcept
+{
+	Compare cmp;
+	size_t result = 0;
+	for (size_t i = 0; i < n; ++i) {
+		result += static_cast<size_t>(!cmp(query, keys[i]));
+	}
+	return result;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <bool upper, class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::bound(
+    const Comparable & query) const
+{
+	if (this->root == nullptr) {
+		return iterator<false>();
+	}
+
+	const auto & key = search_key(query);
+	void * cur = this->root;
+	for (size_t level = 0; level < this->height; ++level) {
+		Inner * inner = static_cast<Inner *>(cur);
+		size_t index;
+		if constexpr (upper) {
+			index = count_less_equal(inner->keys, inner->count, key);
+		} else {
+			index = count_less(inner->keys, inner->count, key);
+		}
+		cur = inner->children[index];
+	}
+
+	Leaf * leaf = static_cast<Leaf *>(cur);
+	size_t pos;
+	if constexpr (upper) {
+		pos = count_less_equal(leaf->keys, leaf->count, key);
+	} else {
+		pos = count_less(leaf->keys, leaf->count, key);
+	}
+
+	// Separators are not tight, thus the result may be in the next leaf
+	if (pos == leaf->count) {
+		return iterator<false>(leaf->next, 0);
+	}
+	return iterator<false>(leaf, pos);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::lower_bound(
+    const Comparable & query)
+{
+	return this->template bound<false>(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::lower_bound(
+    const Comparable & query) const
+{
+	return this->template bound<false>(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::upper_bound(
+    const Comparable & query)
+{
+	return this->template bound<true>(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::upper_bound(
+    const Comparable & query) const
+{
+	return this->template bound<true>(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::find(const Comparable & query)
+{
+	iterator<false> it = this->template bound<false>(query);
+	if ((it.leaf != nullptr) &&
+	    !Compare()(search_key(query), it.leaf->keys[it.pos])) {
+		return it;
+	}
+	return this->end();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+template <class Comparable>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::find(
+    const Comparable & query) const
+{
+	return const_cast<MyClass *>(this)->find(query);
+}
+
+/*
+ * Insertion
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::insert_into_leaf(
+    Leaf * leaf, size_t pos, const key_type & key, Node * node) noexcept
+{
+	std::copy_backward(leaf->keys + pos, leaf->keys + leaf->count,
+	                   leaf->keys + leaf->count + 1);
+	std::copy_backward(leaf->nodes + pos, leaf->nodes + leaf->count,
+	                   leaf->nodes + leaf->count + 1);
+	leaf->keys[pos] = key;
+	leaf->nodes[pos] = node;
+	leaf->count++;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::insert_into_inner(
+    Inner * inner, size_t pos, const key_type & key, void * child) noexcept
+{
+	std::copy_backward(inner->keys + pos, inner->keys + inner->count,
+	                   inner->keys + inner->count + 1);
+	std::copy_backward(inner->children + pos + 1,
+	                   inner->children + inner->count + 1,
+	                   inner->children + inner->count + 2);
+	inner->keys[pos] = key;
+	inner->children[pos + 1] = child;
+	inner->count++;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::insert_into_parents(
+    size_t level, Inner ** path, size_t * indices, key_type separator,
+    void * child, Inner ** spares) noexcept
+{
+	while (true) {
+		if (level == 0) {
+			// The root has been split
+			Inner * new_root = *spares;
+			new_root->count = 1;
+			new_root->keys[0] = separator;
+			new_root->children[0] = this->root;
+			new_root->children[1] = child;
+			this->root = new_root;
+			this->height++;
+			return;
+		}
+
+		level--;
+		Inner * parent = path[level];
+		size_t index = indices[level];
+
+		if (parent->count < CAPACITY) {
+			this->insert_into_inner(parent, index, separator, child);
+			return;
+		}
+
+		// Split the parent. The middle key moves up.
+		constexpr size_t mid = CAPACITY / 2;
+		Inner * right = *spares++;
+		key_type up = parent->keys[mid];
+
+		right->count = CAPACITY - mid - 1;
+		std::copy(parent->keys + mid + 1, parent->keys + CAPACITY, right->keys);
+		std::copy(parent->children + mid + 1, parent->children + CAPACITY + 1,
+		          right->children);
+		parent->count = mid;
+
+		if (index <= mid) {
+			this->insert_into_inner(parent, index, separator, child);
+		} else {
+			this->insert_into_inner(right, index - mid - 1, separator, child);
+		}
+
+		separator = up;
+		child = right;
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::insert(Node & node)
+{
+	key_type key = NodeTraits::get_key(node);
+
+	if (this->root == nullptr) {
+		Leaf * leaf = this->leaf_pool.allocate();
+		leaf->count = 0;
+		leaf->prev = nullptr;
+		leaf->next = nullptr;
+		this->insert_into_leaf(leaf, 0, key, &node);
+
+		this->root = leaf;
+		this->first_leaf = leaf;
+		this->last_leaf = leaf;
+		this->s = 1;
+		return;
+	}
+
+	Inner * path[MAX_HEIGHT];
+	size_t indices[MAX_HEIGHT];
+
+	// Multisets insert after equal elements, sets before them to find them
+	void * cur = this->root;
+	for (size_t level = 0; level < this->height; ++level) {
+		Inner * inner = static_cast<Inner *>(cur);
+		size_t index;
+		if constexpr (Options::multiple) {
+			index = count_less_equal(inner->keys, inner->count, key);
+		} else {
+			index = count_less(inner->keys, inner->count, key);
+		}
+		path[level] = inner;
+		indices[level] = index;
+		cur = inner->children[index];
+	}
+
+	Leaf * leaf = static_cast<Leaf *>(cur);
+	size_t pos;
+	if constexpr (Options::multiple) {
+		pos = count_less_equal(leaf->keys, leaf->count, key);
+	} else {
+		pos = count_less(leaf->keys, leaf->count, key);
+
+		Compare cmp;
+		if (pos < leaf->count) {
+			if (!cmp(key, leaf->keys[pos])) {
+				return;
+			}
+		} else if ((leaf->next != nullptr) && !cmp(key, leaf->next->keys[0])) {
+			return;
+		}
+	}
+
+	if (__builtin_expect(leaf->count < CAPACITY, true)) {
+		this->insert_into_leaf(leaf, pos, key, &node);
+		this->s++;
+		return;
+	}
+
+	/*
+	 * The leaf must be split. Allocate everything needed beforehand, such that
+	 * the index stays unchanged if an allocation fails: One inner node per
+	 * full ancestor, plus a new root if all ancestors are full.
+	 */
+	size_t needed = 1;
+	for (size_t level = this->height; level > 0; --level) {
+		if (path[level - 1]->count < CAPACITY) {
+			needed--;
+			break;
+		}
+		needed++;
+	}
+
+	Inner * spares[MAX_HEIGHT + 1];
+	Leaf * right = this->leaf_pool.allocate();
+	size_t allocated = 0;
+	try {
+		for (; allocated < needed; ++allocated) {
+			spares[allocated] = this->inner_pool.allocate();
+		}
+	} catch (...) {
+		for (size_t i = 0; i < allocated; ++i) {
+			this->inner_pool.deallocate(spares[i]);
+		}
+		this->leaf_pool.deallocate(right);
+		throw;
+	}
+
+	constexpr size_t keep = CAPACITY / 2;
+	right->count = CAPACITY - keep;
+	std::copy(leaf->keys + keep, leaf->keys + CAPACITY, right->keys);
+	std::copy(leaf->nodes + keep, leaf->nodes + CAPACITY, right->nodes);
+	leaf->count = keep;
+
+	right->prev = leaf;
+	right->next = leaf->next;
+	if (leaf->next != nullptr) {
+		leaf->next->prev = right;
+	} else {
+		this->last_leaf = right;
+	}
+	leaf->next = right;
+
+	// Never insert at the front of the right leaf, its first key is the separator
+	if (pos <= keep) {
+		this->insert_into_leaf(leaf, pos, key, &node);
+	} else {
+		this->insert_into_leaf(right, pos - keep, key, &node);
+	}
+	this->s++;
+
+	this->insert_into_parents(this->height, path, indices, right->keys[0], right,
+	                          spares);
+}
+
+/*
+ * Removal
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+bool
+BTreeIndex<Node, NodeTraits, Options, Compare>::advance_path(
+    Inner ** path, size_t * indices, Leaf *& leaf) const
+{
+	size_t level = this->height;
+	while (level > 0) {
+		level--;
+		if (indices[level] < path[level]->count) {
+			indices[level]++;
+			void * cur = path[level]->children[indices[level]];
+			for (size_t lower = level + 1; lower < this->height; ++lower) {
+				path[lower] = static_cast<Inner *>(cur);
+				indices[lower] = 0;
+				cur = path[lower]->children[0];
+			}
+
+			assert(leaf->next == cur);
+			leaf = static_cast<Leaf *>(cur);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::remove_from_parents(
+    size_t level, Inner ** path, size_t * indices)
+{
+	while (level > 0) {
+		level--;
+		Inner * parent = path[level];
+		size_t index = indices[level];
+
+		if (parent->count == 0) {
+			// The removed child was the only one
+			this->inner_pool.deallocate(parent);
+			continue;
+		}
+
+		// Remove the child and one of the separators next to it
+		size_t key_index = (index > 0) ? (index - 1) : 0;
+		std::copy(parent->keys + key_index + 1, parent->keys + parent->count,
+		          parent->keys + key_index);
+		std::copy(parent->children + index + 1,
+		          parent->children + parent->count + 1, parent->children + index);
+		parent->count--;
+
+		// Shrink the index if the root only has a single child left
+		while ((this->height > 0) &&
+		       (static_cast<Inner *>(this->root)->count == 0)) {
+			Inner * old_root = static_cast<Inner *>(this->root);
+			this->root = old_root->children[0];
+			this->inner_pool.deallocate(old_root);
+			this->height--;
+		}
+		return;
+	}
+
+	// Everything has been removed
+	this->root = nullptr;
+	this->height = 0;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::remove(Node & node)
+{
+	key_type key = NodeTraits::get_key(node);
+
+	Inner * path[MAX_HEIGHT];
+	size_t indices[MAX_HEIGHT];
+
+	void * cur = this->root;
+	for (size_t level = 0; level < this->height; ++level) {
+		Inner * inner = static_cast<Inner *>(cur);
+		size_t index = count_less(inner->keys, inner->count, key);
+		path[level] = inner;
+		indices[level] = index;
+		cur = inner->children[index];
+	}
+
+	// Find the node among the elements with an equal key
+	Leaf * leaf = static_cast<Leaf *>(cur);
+	size_t pos = count_less(leaf->keys, leaf->count, key);
+	while (true) {
+		if (pos == leaf->count) {
+			[[maybe_unused]] bool found = this->advance_path(path, indices, leaf);
+			assert(found);
+			pos = 0;
+			continue;
+		}
+		if (leaf->nodes[pos] == &node) {
+			break;
+		}
+		assert(!Compare()(key, leaf->keys[pos]));
+		pos++;
+	}
+
+	std::copy(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+	std::copy(leaf->nodes + pos + 1, leaf->nodes + leaf->count,
+	          leaf->nodes + pos);
+	leaf->count--;
+	this->s--;
+
+	if (leaf->count > 0) {
+		return;
+	}
+
+	// Free-at-empty
+	if (leaf->prev != nullptr) {
+		leaf->prev->next = leaf->next;
+	} else {
+		this->first_leaf = leaf->next;
+	}
+	if (leaf->next != nullptr) {
+		leaf->next->prev = leaf->prev;
+	} else {
+		this->last_leaf = leaf->prev;
+	}
+	this->leaf_pool.deallocate(leaf);
+
+	this->remove_from_parents(this->height, path, indices);
+}
+
+/*
+ * Iteration
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::cbegin() const noexcept
+{
+	return const_iterator<false>(this->first_leaf, 0);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::cend() const noexcept
+{
+	return const_iterator<false>();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::begin() const noexcept
+{
+	return this->cbegin();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::begin() noexcept
+{
+	return iterator<false>(this->first_leaf, 0);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::end() const noexcept
+{
+	return this->cend();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<
+    false>
+BTreeIndex<Node, NodeTraits, Options, Compare>::end() noexcept
+{
+	return iterator<false>();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::crbegin() const noexcept
+{
+	if (this->last_leaf == nullptr) {
+		return const_iterator<true>();
+	}
+	return const_iterator<true>(this->last_leaf, this->last_leaf->count - 1);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::crend() const noexcept
+{
+	return const_iterator<true>();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::rbegin() const noexcept
+{
+	return this->crbegin();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::rbegin() noexcept
+{
+	if (this->last_leaf == nullptr) {
+		return iterator<true>();
+	}
+	return iterator<true>(this->last_leaf, this->last_leaf->count - 1);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options,
+                    Compare>::template const_iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::rend() const noexcept
+{
+	return this->crend();
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+typename BTreeIndex<Node, NodeTraits, Options, Compare>::template iterator<true>
+BTreeIndex<Node, NodeTraits, Options, Compare>::rend() noexcept
+{
+	return iterator<true>();
+}
+
+/*
+ * Miscellaneous
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+size_t
+BTreeIndex<Node, NodeTraits, Options, Compare>::size() const noexcept
+{
+	return this->s;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+bool
+BTreeIndex<Node, NodeTraits, Options, Compare>::empty() const noexcept
+{
+	return this->s == 0;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+size_t
+BTreeIndex<Node, NodeTraits, Options, Compare>::get_height() const noexcept
+{
+	return this->height;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::free_subtree(
+    void * n, size_t levels) noexcept
+{
+	if (levels == 0) {
+		this->leaf_pool.deallocate(static_cast<Leaf *>(n));
+		return;
+	}
+
+	Inner * inner = static_cast<Inner *>(n);
+	for (size_t i = 0; i <= inner->count; ++i) {
+		this->free_subtree(inner->children[i], levels - 1);
+	}
+	this->inner_pool.deallocate(inner);
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::clear() noexcept
+{
+	if (this->root != nullptr) {
+		this->free_subtree(this->root, this->height);
+	}
+
+	this->root = nullptr;
+	this->height = 0;
+	this->first_leaf = nullptr;
+	this->last_leaf = nullptr;
+	this->s = 0;
+}
+
+/*
+ * Debugging
+ */
+template <class Node, class NodeTraits, class Options, class Compare>
+size_t
+BTreeIndex<Node, NodeTraits, Options, Compare>::verify_subtree(
+    void * n, size_t levels, const key_type * lower, const key_type * upper,
+    Leaf *& prev_leaf) const
+{
+	Compare cmp;
+
+	if (levels == 0) {
+		Leaf * leaf = static_cast<Leaf *>(n);
+		debug::yggassert(leaf->count > 0);
+		debug::yggassert(leaf->count <= CAPACITY);
+		debug::yggassert(leaf->prev == prev_leaf);
+		if (prev_leaf != nullptr) {
+			debug::yggassert(prev_leaf->next == leaf);
+			// Keys are sorted across leaves
+			const key_type & last = prev_leaf->keys[prev_leaf->count - 1];
+			if constexpr (Options::multiple) {
+				debug::yggassert(!cmp(leaf->keys[0], last));
+			} else {
+				debug::yggassert(cmp(last, leaf->keys[0]));
+			}
+		} else {
+			debug::yggassert(this->first_leaf == leaf);
+		}
+
+		for (size_t i = 0; i < leaf->count; ++i) {
+			const key_type & key = leaf->keys[i];
+			const key_type node_key = NodeTraits::get_key(*leaf->nodes[i]);
+			debug::yggassert(!cmp(key, node_key) && !cmp(node_key, key));
+
+			debug::yggassert((lower == nullptr) || !cmp(key, *lower));
+			debug::yggassert((upper == nullptr) || !cmp(*upper, key));
+			if (i > 0) {
+				if constexpr (Options::multiple) {
+					debug::yggassert(!cmp(key, leaf->keys[i - 1]));
+				} else {
+					debug::yggassert(cmp(leaf->keys[i - 1], key));
+				}
+			}
+		}
+
+		prev_leaf = leaf;
+		return leaf->count;
+	}
+
+	Inner * inner = static_cast<Inner *>(n);
+	debug::yggassert(inner->count <= CAPACITY);
+	debug::yggassert((inner != this->root) || (inner->count > 0));
+
+	size_t count = 0;
+	for (size_t i = 0; i <= inner->count; ++i) {
+		const key_type * child_lower = (i > 0) ? &inner->keys[i - 1] : lower;
+		const key_type * child_upper = (i < inner->count) ? &inner->keys[i] : upper;
+		if ((child_lower != nullptr) && (child_upper != nullptr)) {
+			debug::yggassert(!cmp(*child_upper, *child_lower));
+		}
+		count += this->verify_subtree(inner->children[i], levels - 1, child_lower,
+		                              child_upper, prev_leaf);
+	}
+
+	return count;
+}
+
+template <class Node, class NodeTraits, class Options, class Compare>
+void
+BTreeIndex<Node, NodeTraits, Options, Compare>::dbg_verify() const
+{
+	if (this->root == nullptr) {
+		debug::yggassert(this->height == 0);
+		debug::yggassert(this->first_leaf == nullptr);
+		debug::yggassert(this->last_leaf == nullptr);
+		debug::yggassert(this->s == 0);
+		return;
+	}
+
+	Leaf * prev_leaf = nullptr;
+	size_t count = this->verify_subtree(this->root, this->height, nullptr,
+	                                    nullptr, prev_leaf);
+	debug::yggassert(prev_leaf == this->last_leaf);
+	debug::yggassert(prev_leaf->next == nullptr);
+	debug::yggassert(count == this->s);
+}
+
+} // namespace ygg
+
+#endif // YGG_BTREE_INDEX_CPP
@@ -0,0 +1,389 @@
+#ifndef YGG_BTREE_INDEX_HPP
+#define YGG_BTREE_INDEX_HPP
+
+#include "node_pool.hpp"
+#include "options.hpp"
+#include "util.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace ygg {
+
+namespace btree_internal {
+/// @cond INTERNAL
+
+template <class Node, class Key, size_t capacity>
+struct Leaf
+{
+	size_t count;
+	Leaf * prev;
+	Leaf * next;
+	Key keys[capacity];
+	Node * nodes[capacity];
+};
+
+/*
+ * keys[i] separates children[i] from children[i+1]: Every key in children[i]
+ * is less-or-equal to keys[i], which is less-or-equal to every key in
+ * children[i+1]. An inner node has 'count' keys and 'count + 1' children.
+ */
+template <class Key, size_t capacity>
+struct Inner
+{
+	size_t count;
+	Key keys[capacity];
+	void * children[capacity + 1];
+};
+
+/// @endcond
+} // namespace btree_internal
+
+/**
+ * @brief Abstract base class for the Node Traits that need to be implemented
+ *
+ * Every BTreeIndex needs to be supplied with a node traits class that must be
+ * derived from this class. In your derived class, you must define the
+ * key_type as the type of the keys your nodes are ordered by, and you must
+ * implement get_key() to return the key of a node.
+ */
+template <class Node>
+class BTreeIndexNodeTraits {
+public:
+	/**
+	 * @brief The type of the keys. This is the type that get_key() must return.
+	 * It must be default-constructible and copy-assignable, and it must be
+	 * comparable, i.e., operator< etc. must be implemented.
+	 */
+	using key_type = void;
+
+	/**
+	 * Must be implemented to return the key of n. The key of a node must not
+	 * change while the node is in the index.
+	 *
+	 * @param n The node whose key should be returned.
+	 * @return Must return the key of n
+	 */
+	static key_type get_key(const Node & n) = delete;
+};
+
+/**
+ * @brief A B+-tree indexing intrusive nodes
+ *
+ * Binary search trees pay (roughly) one cache miss per level. This index
+ * instead stores the keys of your nodes in wide, sorted arrays: Inner nodes
+ * and leaves each hold up to TreeFlags::BTREE_NODE_KEYS keys (32 by default).
+ * The leaves additionally hold pointers to your nodes. Leaves are linked to
+ * allow for fast iteration.
+ *
+ * Unlike all other trees in this library, your nodes do not need to be
+ * derived from any base class, and they are not modified when being inserted.
+ * Instead, the inner nodes and leaves are allocated by the index itself, from
+ * two NodePool instances. Thus, in contrast to the other trees, insert() may
+ * throw std::bad_alloc. In that case, the index is left unchanged.
+ *
+ * Within a node, the position of a query is computed by counting the keys
+ * that are smaller than the query, without any conditional branches. For
+ * arithmetic key types, compilers vectorize this search.
+ *
+ * A leaf is only removed once it becomes empty ("free-at-empty"), i.e., leaves
+ * are never merged. This keeps removals cheap, and all leaves are always at the
+ * same depth.
+ *
+ * Any modification of the index invalidates all iterators.
+ *
+ * The index is neither copyable nor movable.
+ *
+ * @tparam Node       The node class. May be any class.
+ * @tparam NodeTraits A class derived from BTreeIndexNodeTraits, providing the
+ * key type and the keys of your nodes.
+ * @tparam Options    The TreeOptions class specifying the parameters of this
+ * index. See TreeFlags::MULTIPLE, TreeFlags::BTREE_NODE_KEYS and the Node Pool
+ * options.
+ * @tparam Compare    A compare class for the keys. The default compares the
+ * keys with operator<.
+ */
+template <class Node, class NodeTraits, class Options = DefaultOptions,
+          class Compare = ygg::utilities::flexible_less>
+class BTreeIndex {
+public:
+	using MyClass = BTreeIndex<Node, NodeTraits, Options, Compare>;
+	using key_type = typename NodeTraits::key_type;
+
+private:
+	constexpr static size_t CAPACITY = Options::btree_node_keys;
+	// A level is only added if the root overflows, which takes exponentially
+	// many insertions in the height. Thus, this is never reached in practice.
+	constexpr static size_t MAX_HEIGHT = 64;
+
+	static_assert(CAPACITY >= 4, "BTREE_NODE_KEYS must be at least 4.");
+	static_assert(!std::is_void<key_type>::value,
+	              "NodeTraits must define key_type.");
+
+	using Leaf = btree_internal::Leaf<Node, key_type, CAPACITY>;
+	using Inner = btree_internal::Inner<key_type, CAPACITY>;
+
+	template <bool reverse, class IterNode>
+	class IteratorImpl {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Node;
+		using difference_type = std::ptrdiff_t;
+		using pointer = IterNode *;
+		using reference = IterNode &;
+
+		IteratorImpl() : leaf(nullptr), pos(0) {}
+		IteratorImpl(Leaf * leaf_in, size_t pos_in) : leaf(leaf_in), pos(pos_in)
+		{}
+		// Converts iterators to const_iterators
+		template <class OtherNode, class = std::enable_if_t<
+		                               std::is_const<IterNode>::value &&
+		                               !std::is_const<OtherNode>::value>>
+		IteratorImpl(const IteratorImpl<reverse, OtherNode> & other)
+		    : leaf(other.leaf), pos(other.pos)
+		{}
+
+		bool
+		operator==(const IteratorImpl & other) const
+		{
+			return (this->leaf == other.leaf) && (this->pos == other.pos);
+		}
+		bool
+		operator!=(const IteratorImpl & other) const
+		{
+			return !(*this == other);
+		}
+
+		reference operator*() const { return *this->leaf->nodes[this->pos]; }
+		pointer operator->() const { return this->leaf->nodes[this->pos]; }
+
+		IteratorImpl &
+		operator++()
+		{
+			if constexpr (reverse) {
+				this->step_back();
+			} else {
+				this->step_forward();
+			}
+			return *this;
+		}
+		IteratorImpl
+		operator++(int)
+		{
+			IteratorImpl old = *this;
+			++(*this);
+			return old;
+		}
+		IteratorImpl &
+		operator--()
+		{
+			if constexpr (reverse) {
+				this->step_forward();
+			} else {
+				this->step_back();
+			}
+			return *this;
+		}
+		IteratorImpl
+		operator--(int)
+		{
+			IteratorImpl old = *this;
+			--(*this);
+			return old;
+		}
+
+	private:
+		friend class BTreeIndex;
+		template <bool, class>
+		friend class IteratorImpl;
+
+		void
+		step_forward()
+		{
+			this->pos++;
+			if (this->pos == this->leaf->count) {
+				this->leaf = this->leaf->next;
+				this->pos = 0;
+			}
+		}
+		void
+		step_back()
+		{
+			if (this->pos == 0) {
+				this->leaf = this->leaf->prev;
+				this->pos = (this->leaf != nullptr) ? this->leaf->count - 1 : 0;
+			} else {
+				this->pos--;
+			}
+		}
+
+		Leaf * leaf;
+		size_t pos;
+	};
+
+public:
+	template <bool reverse>
+	using iterator = IteratorImpl<reverse, Node>;
+	template <bool reverse>
+	using const_iterator = IteratorImpl<reverse, const Node>;
+
+	BTreeIndex() noexcept;
+	BTreeIndex(const MyClass & other) = delete;
+	MyClass & operator=(const MyClass & other) = delete;
+
+	/**
+	 * @brief Inserts <node> into the index
+	 *
+	 * If TreeFlags::MULTIPLE is set, <node> is inserted after all nodes with an
+	 * equal key. Otherwise, <node> is not inserted if a node with an equal key
+	 * is already present.
+	 *
+	 * *Warning*: <node> *may not move in memory* while it is in the index.
+	 *
+	 * @param node The node to be inserted
+	 */
+	void insert(Node & node);
+
+	/**
+	 * @brief Removes <node> from the index
+	 *
+	 * The key of <node> must not have changed since it was inserted.
+	 *
+	 * @param node The node to be removed. Must be in the index.
+	 */
+	void remove(Node & node);
+
+	/**
+	 * @brief Finds an element in the index
+	 *
+	 * Returns an iterator to the first element whose key compares equally to
+	 * <query>. The query may either be a Node, whose key is then used, or
+	 * anything that can be compared to key_type with Compare.
+	 *
+	 * @param query The node or key to be found
+	 * @returns An iterator to the first matching element, or end() if no such
+	 * element exists
+	 */
+	template <class Comparable>
+	const_iterator<false> find(const Comparable & query) const;
+	template <class Comparable>
+	iterator<false> find(const Comparable & query);
+
+	/**
+	 * @brief Lower-bounds an element
+	 *
+	 * Returns an iterator to the first element whose key is not less than
+	 * <query>. See find() for the requirements on <query>.
+	 *
+	 * @param query A node or key that should be lower-bounded
+	 * @returns An iterator to the first element not less than <query>, or end()
+	 * if no such element exists
+	 */
+	template <class Comparable>
+	const_iterator<false> lower_bound(const Comparable & query) const;
+	template <class Comparable>
+	iterator<false> lower_bound(const Comparable & query);
+
+	/**
+	 * @brief Upper-bounds an element
+	 *
+	 * Returns an iterator to the first element whose key is greater than
+	 * <query>. See find() for the requirements on <query>.
+	 *
+	 * @param query A node or key that should be upper-bounded
+	 * @returns An iterator to the first element greater than <query>, or end()
+	 * if no such element exists
+	 */
+	template <class Comparable>
+	const_iterator<false> upper_bound(const Comparable & query) const;
+	template <class Comparable>
+	iterator<false> upper_bound(const Comparable & query);
+
+	// Iteration
+	const_iterator<false> cbegin() const noexcept;
+	const_iterator<false> cend() const noexcept;
+	const_iterator<false> begin() const noexcept;
+	iterator<false> begin() noexcept;
+	const_iterator<false> end() const noexcept;
+	iterator<false> end() noexcept;
+
+	const_iterator<true> crbegin() const noexcept;
+	const_iterator<true> crend() const noexcept;
+	const_iterator<true> rbegin() const noexcept;
+	iterator<true> rbegin() noexcept;
+	const_iterator<true> rend() const noexcept;
+	iterator<true> rend() noexcept;
+
+	/**
+	 * @brief Returns the number of elements in the index
+	 *
+	 * This method runs in O(1).
+	 */
+	size_t size() const noexcept;
+
+	/**
+	 * @brief Returns whether the index is empty
+	 */
+	bool empty() const noexcept;
+
+	/**
+	 * @brief Removes all elements from the index
+	 *
+	 * Frees all inner nodes and leaves. Your nodes are not touched.
+	 */
+	void clear() noexcept;
+
+	/**
+	 * @brief Returns the number of levels of inner nodes above the leaves
+	 */
+	size_t get_height() const noexcept;
+
+	// Debugging methods
+	void dbg_verify() const;
+
+private:
+	static key_type search_key(const Node & query);
+	template <class Comparable>
+	static const Comparable & search_key(const Comparable & query) noexcept;
+
+	template <class Comparable>
+	static size_t count_less(const key_type * keys, size_t n,
+	                         const Comparable & query) noexcept;
+	template <class Comparable>
+	static size_t count_less_equal(const key_type * keys, size_t n,
+	                               const Comparable & query) noexcept;
+
+	template <bool upper, class Comparable>
+	iterator<false> bound(const Comparable & query) const;
+
+	void insert_into_leaf(Leaf * leaf, size_t pos, const key_type & key,
+	                      Node * node) noexcept;
+	void insert_into_inner(Inner * inner, size_t pos, const key_type & key,
+	                       void * child) noexcept;
+	void insert_into_parents(size_t level, Inner ** path, size_t * indices,
+	                         key_type separator, void * child,
+	                         Inner ** spares) noexcept;
+	void remove_from_parents(size_t level, Inner ** path, size_t * indices);
+	bool advance_path(Inner ** path, size_t * indices, Leaf *& leaf) const;
+
+	void free_subtree(void * n, size_t levels) noexcept;
+	size_t verify_subtree(void * n, size_t levels, const key_type * lower,
+	                      const key_type * upper, Leaf *& prev_leaf) const;
+
+	void * root;
+	// Number of inner levels above the leaves
+	size_t height;
+	Leaf * first_leaf;
+	Leaf * last_leaf;
+	size_t s;
+
+	NodePool<Leaf, Options> leaf_pool;
+	NodePool<Inner, Options> inner_pool;
+};
+
+} // namespace ygg
+
+#include "btree_index.cpp"
+
+#endif // YGG_BTREE_INDEX_HPP
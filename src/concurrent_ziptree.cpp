@@ -0,0 +1,810 @@
+#ifndef YGG_CONCURRENT_ZIPTREE_CPP
+#define YGG_CONCURRENT_ZIPTREE_CPP
+
+#include "concurrent_ziptree.hpp"
+
+#include <cassert>
+#include <thread>
+
+namespace ygg {
+
+namespace czt_internal {
+// @cond INTERNAL
+
+inline NodeLock::NodeLock() noexcept : version(0) {}
+
+inline NodeLock::NodeLock(const NodeLock & other) noexcept : version(0)
+{
+	(void)other;
+}
+
+inline NodeLock &
+NodeLock::operator=(const NodeLock & other) noexcept
+{
+	(void)other;
+	return *this;
+}
+
+inline void
+NodeLock::lock() noexcept
+{
+	uint64_t current = this->version.load(std::memory_order_relaxed);
+	while (((current & LOCKED) != 0) ||
+	       !this->version.compare_exchange_weak(current, current | LOCKED,
+	                                            std::memory_order_acquire,
+	                                            std::memory_order_relaxed)) {
+		// Spin on a plain load to not steal the cache line from the owner. Give
+		// up the time slice now and then, the owner might not be running.
+		size_t spins = 0;
+		current = this->version.load(std::memory_order_relaxed);
+		while ((current & LOCKED) != 0) {
+			if (++spins == 128) {
+				std::this_thread::yield();
+				spins = 0;
+			}
+			current = this->version.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+inline void
+NodeLock::mark_modified() noexcept
+{
+	// The modifications themselves are stored with release semantics, thus
+	// whoever sees one of them also sees this.
+	this->version.store(this->version.load(std::memory_order_relaxed) |
+	                        MODIFIED,
+	                    std::memory_order_relaxed);
+}
+
+inline void
+NodeLock::unlock() noexcept
+{
+	uint64_t current = this->version.load(std::memory_order_relaxed);
+	if ((current & MODIFIED) != 0) {
+		current += VERSION_STEP;
+	}
+	this->version.store(current & ~(LOCKED | MODIFIED),
+	                    std::memory_order_release);
+}
+
+inline uint64_t
+NodeLock::read_version() const noexcept
+{
+	size_t spins = 0;
+	uint64_t current = this->version.load(std::memory_order_acquire);
+	while ((current & MODIFIED) != 0) {
+		if (++spins == 128) {
+			std::this_thread::yield();
+			spins = 0;
+		}
+		current = this->version.load(std::memory_order_acquire);
+	}
+
+	return current & ~LOCKED;
+}
+
+inline bool
+NodeLock::validate(uint64_t seen_version) const noexcept
+{
+	return (this->version.load(std::memory_order_acquire) & ~LOCKED) ==
+	       seen_version;
+}
+
+template <class Node>
+ChildPointer<Node>::ChildPointer() noexcept : ptr(nullptr)
+{}
+
+template <class Node>
+ChildPointer<Node>::ChildPointer(const ChildPointer & other) noexcept
+    : ptr(other.load(std::memory_order_relaxed))
+{}
+
+template <class Node>
+ChildPointer<Node> &
+ChildPointer<Node>::operator=(const ChildPointer & other) noexcept
+{
+	this->store(other.load(std::memory_order_relaxed),
+	            std::memory_order_relaxed);
+	return *this;
+}
+
+template <class Node>
+Node *
+ChildPointer<Node>::load(std::memory_order order) const noexcept
+{
+	return this->ptr.load(order);
+}
+
+template <class Node>
+void
+ChildPointer<Node>::store(Node * node, std::memory_order order) noexcept
+{
+	this->ptr.store(node, order);
+}
+
+inline AtomicSizeHolder<true>::AtomicSizeHolder() noexcept : n(0) {}
+
+inline void
+AtomicSizeHolder<true>::add(size_t i) noexcept
+{
+	this->n.fetch_add(i, std::memory_order_relaxed);
+}
+
+inline void
+AtomicSizeHolder<true>::reduce(size_t i) noexcept
+{
+	this->n.fetch_sub(i, std::memory_order_relaxed);
+}
+
+inline size_t
+AtomicSizeHolder<true>::get() const noexcept
+{
+	return this->n.load(std::memory_order_relaxed);
+}
+
+inline void
+AtomicSizeHolder<false>::add(size_t i) noexcept
+{
+	(void)i;
+}
+
+inline void
+AtomicSizeHolder<false>::reduce(size_t i) noexcept
+{
+	(void)i;
+}
+
+template <class Node>
+EpochSlot<Node>::EpochSlot() noexcept
+    : in_use(false), state(0), limbo_epoch{0, 0, 0}, ops_since_advance(0)
+{}
+
+// @endcond
+} // namespace czt_internal
+
+template <class Node, class Options, class Tag>
+auto
+ConcurrentZTreeNodeBase<Node, Options, Tag>::dbg_get_rank() const noexcept
+{
+	return decltype(this->_zt_rank)::get_rank(*(static_cast<const Node *>(this)));
+}
+
+template <class Node, class Options, class Tag>
+void
+ConcurrentZTreeNodeBase<Node, Options, Tag>::update_rank() noexcept
+{
+	decltype(this->_zt_rank)::update_rank(*static_cast<Node *>(this));
+}
+
+/*
+ * Thread handles and guards
+ */
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::ThreadHandle::ThreadHandle(MyClass * tree_in,
+                                                        size_t slot_in) noexcept
+    : tree(tree_in), slot(slot_in)
+{}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::ThreadHandle::ThreadHandle(ThreadHandle &&
+                                                            other) noexcept
+    : tree(other.tree), slot(other.slot)
+{
+	other.tree = nullptr;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::ThreadHandle::~ThreadHandle()
+{
+	if (this->tree != nullptr) {
+		// Retired nodes stay in the slot and are reclaimed by its next owner
+		this->tree->slots[this->slot].in_use.store(false,
+		                                           std::memory_order_release);
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+typename ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                         RankGetter>::EpochGuard
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::ThreadHandle::pin() noexcept
+{
+	this->tree->pin(this->slot);
+	return EpochGuard(this->tree, this->slot);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::EpochGuard::EpochGuard(MyClass * tree_in,
+                                                    size_t slot_in) noexcept
+    : tree(tree_in), slot(slot_in)
+{}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::EpochGuard::EpochGuard(EpochGuard &&
+                                                        other) noexcept
+    : tree(other.tree), slot(other.slot)
+{
+	other.tree = nullptr;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::EpochGuard::~EpochGuard()
+{
+	if (this->tree != nullptr) {
+		this->tree->unpin(this->slot);
+	}
+}
+
+/*
+ * The tree itself
+ */
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::ConcurrentZTree(size_t max_threads_in)
+    : global_epoch(0), max_threads(max_threads_in),
+      slots(new czt_internal::EpochSlot<Node>[max_threads_in])
+{}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+typename ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                         RankGetter>::ThreadHandle
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::register_thread() noexcept
+{
+	while (true) {
+		for (size_t i = 0; i < this->max_threads; ++i) {
+			bool expected = false;
+			if (this->slots[i].in_use.compare_exchange_strong(
+			        expected, true, std::memory_order_acquire)) {
+				return ThreadHandle(this, i);
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+bool
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::goes_left(const Node & node,
+                                       const Node & cur) const
+    CMP_NOEXCEPT(node)
+{
+	if (this->cmp(node, cur)) {
+		return true;
+	}
+	if constexpr (Options::multiple) {
+		return !this->cmp(cur, node) && (&node < &cur);
+	} else {
+		return false;
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::insert(
+    Node & node) CMP_NOEXCEPT(node)
+{
+	const auto node_rank = RankGetter::get_rank(node);
+	node.NB::_czt_left.store(nullptr, std::memory_order_relaxed);
+	node.NB::_czt_right.store(nullptr, std::memory_order_relaxed);
+
+	// Find the first node on the search path that has a smaller rank. Ranks
+	// and keys of nodes in the tree never change, so they can be read before
+	// locking the node.
+	czt_internal::NodeLock * held = &this->root_lock;
+	held->lock();
+	ChildPointer * slot = &this->root;
+	Node * cur = slot->load(std::memory_order_relaxed);
+
+	while ((cur != nullptr) && (RankGetter::get_rank(*cur) >= node_rank)) {
+		cur->NB::_czt_lock.lock();
+		held->unlock();
+		held = &cur->NB::_czt_lock;
+
+		if (this->goes_left(node, *cur)) {
+			slot = &cur->NB::_czt_left;
+		} else {
+			slot = &cur->NB::_czt_right;
+		}
+		cur = slot->load(std::memory_order_relaxed);
+	}
+
+	// The slot is only replaced after unzipping is done, so other threads never
+	// see the spines while they are being built.
+	held->mark_modified();
+	this->unzip(cur, node);
+	slot->store(&node, std::memory_order_release);
+	this->s.add(1);
+
+	held->unlock();
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::unzip(
+    Node * cur, Node & node) CMP_NOEXCEPT(node)
+{
+	// The last node of each spine stays locked until the next node is appended
+	// to that spine, or until unzipping is done.
+	ChildPointer * left_slot = &node.NB::_czt_left;
+	ChildPointer * right_slot = &node.NB::_czt_right;
+	czt_internal::NodeLock * left_lock = nullptr;
+	czt_internal::NodeLock * right_lock = nullptr;
+
+	while (cur != nullptr) {
+		cur->NB::_czt_lock.lock();
+		cur->NB::_czt_lock.mark_modified();
+
+		if (this->goes_left(node, *cur)) {
+			// Add to the right spine
+			right_slot->store(cur, std::memory_order_release);
+			if (right_lock != nullptr) {
+				right_lock->unlock();
+			}
+			right_lock = &cur->NB::_czt_lock;
+			right_slot = &cur->NB::_czt_left;
+			cur = right_slot->load(std::memory_order_relaxed);
+		} else {
+			// Add to the left spine
+			left_slot->store(cur, std::memory_order_release);
+			if (left_lock != nullptr) {
+				left_lock->unlock();
+			}
+			left_lock = &cur->NB::_czt_lock;
+			left_slot = &cur->NB::_czt_right;
+			cur = left_slot->load(std::memory_order_relaxed);
+		}
+	}
+
+	// End of the spines
+	left_slot->store(nullptr, std::memory_order_release);
+	right_slot->store(nullptr, std::memory_order_release);
+
+	if (left_lock != nullptr) {
+		left_lock->unlock();
+	}
+	if (right_lock != nullptr) {
+		right_lock->unlock();
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::remove(
+    Node & node) CMP_NOEXCEPT(node)
+{
+	this->unlink(node);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::remove(
+    Node & node, ThreadHandle & handle) CMP_NOEXCEPT(node)
+{
+	assert(handle.tree == this);
+
+	this->unlink(node);
+	this->retire(node, handle.slot);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::unlink(
+    Node & node) CMP_NOEXCEPT(node)
+{
+	czt_internal::NodeLock * held = &this->root_lock;
+	held->lock();
+	ChildPointer * slot = &this->root;
+	Node * cur = slot->load(std::memory_order_relaxed);
+
+	while (cur != &node) {
+		assert(cur != nullptr);
+
+		cur->NB::_czt_lock.lock();
+		held->unlock();
+		held = &cur->NB::_czt_lock;
+
+		if (this->goes_left(node, *cur)) {
+			slot = &cur->NB::_czt_left;
+		} else {
+			slot = &cur->NB::_czt_right;
+		}
+		cur = slot->load(std::memory_order_relaxed);
+	}
+
+	// The parent of the node (or the root) stays locked during zipping
+	held->mark_modified();
+	node.NB::_czt_lock.lock();
+	this->zip(slot, node);
+	this->s.reduce(1);
+	node.NB::_czt_lock.unlock();
+
+	held->unlock();
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::zip(
+    ChildPointer * slot, Node & old_root) noexcept
+{
+	Node * left_head = old_root.NB::_czt_left.load(std::memory_order_relaxed);
+	Node * right_head = old_root.NB::_czt_right.load(std::memory_order_relaxed);
+
+	// As in unzip(), the last node taken from either side stays locked until
+	// the next node from that side has been taken.
+	czt_internal::NodeLock * left_lock = nullptr;
+	czt_internal::NodeLock * right_lock = nullptr;
+
+	// Left heads are used if they have a higher rank, as in ZTree
+	while ((left_head != nullptr) && (right_head != nullptr)) {
+		if (RankGetter::get_rank(*left_head) > RankGetter::get_rank(*right_head)) {
+			left_head->NB::_czt_lock.lock();
+			left_head->NB::_czt_lock.mark_modified();
+			slot->store(left_head, std::memory_order_release);
+			if (left_lock != nullptr) {
+				left_lock->unlock();
+			}
+			left_lock = &left_head->NB::_czt_lock;
+			slot = &left_head->NB::_czt_right;
+			left_head = slot->load(std::memory_order_relaxed);
+		} else {
+			right_head->NB::_czt_lock.lock();
+			right_head->NB::_czt_lock.mark_modified();
+			slot->store(right_head, std::memory_order_release);
+			if (right_lock != nullptr) {
+				right_lock->unlock();
+			}
+			right_lock = &right_head->NB::_czt_lock;
+			slot = &right_head->NB::_czt_left;
+			right_head = slot->load(std::memory_order_relaxed);
+		}
+	}
+
+	if (left_head != nullptr) {
+		slot->store(left_head, std::memory_order_release);
+	} else {
+		slot->store(right_head, std::memory_order_release);
+	}
+
+	if (left_lock != nullptr) {
+		left_lock->unlock();
+	}
+	if (right_lock != nullptr) {
+		right_lock->unlock();
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable>
+Node *
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::find(
+    const Comparable & query) CMP_NOEXCEPT(query)
+{
+	for (size_t attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; ++attempt) {
+		Node * result = nullptr;
+		if (this->find_optimistic(query, result)) {
+			return result;
+		}
+	}
+
+	return this->find_locked(query);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable>
+bool
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::
+    find_optimistic(const Comparable & query, Node *& result) const
+    CMP_NOEXCEPT(query)
+{
+	/* A modifying thread marks every node it modifies, and the parent of the
+	 * modified part for the whole operation. Thus, if none of the nodes on our
+	 * path has been marked since we have passed it, the path is exactly the one
+	 * we would have seen at the moment we reached its end. Nodes we pass cannot
+	 * be reclaimed, since the caller is pinned. */
+	const czt_internal::NodeLock * locks[OPTIMISTIC_MAX_DEPTH];
+	uint64_t versions[OPTIMISTIC_MAX_DEPTH];
+
+	locks[0] = &this->root_lock;
+	versions[0] = this->root_lock.read_version();
+	size_t depth = 1;
+	Node * cur = this->root.load(std::memory_order_acquire);
+
+	while (cur != nullptr) {
+		if (depth == OPTIMISTIC_MAX_DEPTH) {
+			return false;
+		}
+		locks[depth] = &cur->NB::_czt_lock;
+		versions[depth] = cur->NB::_czt_lock.read_version();
+		depth++;
+
+		if (this->cmp(query, *cur)) {
+			cur = cur->NB::_czt_left.load(std::memory_order_acquire);
+		} else if (this->cmp(*cur, query)) {
+			cur = cur->NB::_czt_right.load(std::memory_order_acquire);
+		} else {
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < depth; ++i) {
+		if (!locks[i]->validate(versions[i])) {
+			return false;
+		}
+	}
+
+	result = cur;
+	return true;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable>
+Node *
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::find_locked(const Comparable & query)
+    CMP_NOEXCEPT(query)
+{
+	czt_internal::NodeLock * held = &this->root_lock;
+	held->lock();
+	Node * cur = this->root.load(std::memory_order_relaxed);
+
+	while (cur != nullptr) {
+		cur->NB::_czt_lock.lock();
+		held->unlock();
+		held = &cur->NB::_czt_lock;
+
+		if (this->cmp(query, *cur)) {
+			cur = cur->NB::_czt_left.load(std::memory_order_relaxed);
+		} else if (this->cmp(*cur, query)) {
+			cur = cur->NB::_czt_right.load(std::memory_order_relaxed);
+		} else {
+			break;
+		}
+	}
+
+	held->unlock();
+	return cur;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+bool
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::empty()
+    const noexcept
+{
+	return this->root.load(std::memory_order_acquire) == nullptr;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+size_t
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::size()
+    const noexcept
+{
+	static_assert(Options::constant_time_size,
+	              "size() requires the CONSTANT_TIME_SIZE option");
+	return this->s.get();
+}
+
+/*
+ * Epoch based reclamation
+ *
+ * A node retired while the global epoch is e may still be seen by threads
+ * pinned in epoch e - 1 or e. The global epoch is only advanced once all
+ * pinned threads have seen the current epoch, thus no thread can still hold
+ * a pointer to the node once the global epoch has reached e + 2.
+ */
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::pin(
+    size_t slot) noexcept
+{
+	auto & slot_state = this->slots[slot];
+	assert((slot_state.state.load(std::memory_order_relaxed) & 1) == 0);
+
+	// The global epoch might advance between reading it and publishing it in
+	// our slot. Retry until we publish the current epoch.
+	uint64_t epoch = this->global_epoch.load(std::memory_order_seq_cst);
+	while (true) {
+		slot_state.state.store((epoch << 1) | 1, std::memory_order_seq_cst);
+		uint64_t current = this->global_epoch.load(std::memory_order_seq_cst);
+		if (current == epoch) {
+			break;
+		}
+		epoch = current;
+	}
+
+	if (!slot_state.limbo[0].empty() || !slot_state.limbo[1].empty() ||
+	    !slot_state.limbo[2].empty()) {
+		if (++slot_state.ops_since_advance >= EPOCH_ADVANCE_INTERVAL) {
+			slot_state.ops_since_advance = 0;
+			this->try_advance_epoch();
+		}
+		this->reclaim_limbo(slot, epoch);
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::unpin(
+    size_t slot) noexcept
+{
+	this->slots[slot].state.store(0, std::memory_order_release);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::retire(
+    Node & node, size_t slot) noexcept
+{
+	auto & slot_state = this->slots[slot];
+	uint64_t epoch = this->global_epoch.load(std::memory_order_seq_cst);
+	size_t bucket = epoch % 3;
+
+	// Anything left in the bucket is from epoch - 3 or earlier
+	if (slot_state.limbo_epoch[bucket] != epoch) {
+		this->reclaim_list(slot_state.limbo[bucket]);
+		slot_state.limbo_epoch[bucket] = epoch;
+	}
+	slot_state.limbo[bucket].push_back(&node);
+
+	if (++slot_state.ops_since_advance >= EPOCH_ADVANCE_INTERVAL) {
+		slot_state.ops_since_advance = 0;
+		this->try_advance_epoch();
+		this->reclaim_limbo(slot,
+		                    this->global_epoch.load(std::memory_order_seq_cst));
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+bool
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::try_advance_epoch() noexcept
+{
+	uint64_t epoch = this->global_epoch.load(std::memory_order_seq_cst);
+
+	for (size_t i = 0; i < this->max_threads; ++i) {
+		uint64_t state = this->slots[i].state.load(std::memory_order_seq_cst);
+		if (((state & 1) != 0) && ((state >> 1) != epoch)) {
+			return false;
+		}
+	}
+
+	return this->global_epoch.compare_exchange_strong(
+	    epoch, epoch + 1, std::memory_order_seq_cst);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::reclaim_list(std::vector<Node *> & nodes) noexcept
+{
+	NodeTraits traits;
+
+	for (Node * node : nodes) {
+		traits.reclaimable(node);
+	}
+	nodes.clear();
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::reclaim_limbo(size_t slot, uint64_t epoch) noexcept
+{
+	auto & slot_state = this->slots[slot];
+
+	for (size_t bucket = 0; bucket < 3; ++bucket) {
+		if (slot_state.limbo_epoch[bucket] + 2 <= epoch) {
+			this->reclaim_list(slot_state.limbo[bucket]);
+		}
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::reclaim_all() noexcept
+{
+	for (size_t i = 0; i < this->max_threads; ++i) {
+		for (size_t bucket = 0; bucket < 3; ++bucket) {
+			this->reclaim_list(this->slots[i].limbo[bucket]);
+		}
+	}
+}
+
+/*
+ * Debugging
+ */
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::dbg_verify() const
+{
+	size_t node_count =
+	    this->dbg_verify_consistency(this->root.load(std::memory_order_relaxed),
+	                                 nullptr, nullptr);
+
+	if constexpr (Options::constant_time_size) {
+		assert(node_count == this->size());
+	}
+	(void)node_count;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+size_t
+ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare,
+                RankGetter>::dbg_verify_consistency(Node * sub_root,
+                                                    Node * lower_bound_node,
+                                                    Node * upper_bound_node)
+    const
+{
+	if (sub_root == nullptr) {
+		return 0;
+	}
+
+	if (lower_bound_node != nullptr) {
+		assert(!this->goes_left(*sub_root, *lower_bound_node));
+	}
+	if (upper_bound_node != nullptr) {
+		assert(this->goes_left(*sub_root, *upper_bound_node));
+	}
+
+	Node * left = sub_root->NB::_czt_left.load(std::memory_order_relaxed);
+	Node * right = sub_root->NB::_czt_right.load(std::memory_order_relaxed);
+
+	if (left != nullptr) {
+		assert(RankGetter::get_rank(*left) <= RankGetter::get_rank(*sub_root));
+	}
+	if (right != nullptr) {
+		assert(RankGetter::get_rank(*right) <= RankGetter::get_rank(*sub_root));
+	}
+
+	return 1 +
+	       this->dbg_verify_consistency(left, lower_bound_node, sub_root) +
+	       this->dbg_verify_consistency(right, sub_root, upper_bound_node);
+}
+
+} // namespace ygg
+
+#endif // YGG_CONCURRENT_ZIPTREE_CPP
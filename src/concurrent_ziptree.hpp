@@ -0,0 +1,469 @@
+#ifndef YGG_CONCURRENT_ZIPTREE_H
+#define YGG_CONCURRENT_ZIPTREE_H
+
+#include "options.hpp"
+#include "size_holder.hpp"
+#include "util.hpp"
+#include "ziptree.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ygg {
+
+namespace czt_internal {
+/// @cond INTERNAL
+
+/*
+ * A test-and-test-and-set spin lock, which doubles as a version counter for
+ * lookups that do not lock (see ConcurrentZTree::find()). Before the holder
+ * modifies the node or anything below it, it marks the lock as modified.
+ * Unlocking a modified lock advances the version. Lookups wait for modified
+ * locks, but ignore locks that are only held to descend the tree. Copying a
+ * lock yields a fresh, unlocked lock, such that the nodes containing it stay
+ * copyable.
+ */
+class NodeLock {
+public:
+	NodeLock() noexcept;
+	NodeLock(const NodeLock & other) noexcept;
+	NodeLock & operator=(const NodeLock & other) noexcept;
+
+	void lock() noexcept;
+	void mark_modified() noexcept;
+	void unlock() noexcept;
+
+	// Waits until the lock is not marked as modified and returns the version
+	uint64_t read_version() const noexcept;
+	// Whether the lock has not been marked as modified since read_version()
+	// returned <seen_version>
+	bool validate(uint64_t seen_version) const noexcept;
+
+private:
+	static constexpr uint64_t LOCKED = 1;
+	static constexpr uint64_t MODIFIED = 2;
+	// The version counts in the bits above LOCKED and MODIFIED
+	static constexpr uint64_t VERSION_STEP = 4;
+
+	std::atomic<uint64_t> version;
+};
+
+/*
+ * A child pointer. Lookups read these without locking, so they are atomic.
+ * They are only written while holding the lock of the node that contains
+ * them, or while that node is not in the tree. Copying a pointer copies its
+ * value, such that the nodes containing it stay copyable.
+ */
+template <class Node>
+class ChildPointer {
+public:
+	ChildPointer() noexcept;
+	ChildPointer(const ChildPointer & other) noexcept;
+	ChildPointer & operator=(const ChildPointer & other) noexcept;
+
+	Node * load(std::memory_order order) const noexcept;
+	void store(Node * node, std::memory_order order) noexcept;
+
+private:
+	std::atomic<Node *> ptr;
+};
+
+template <bool enable>
+class AtomicSizeHolder;
+
+template <>
+class AtomicSizeHolder<true> {
+public:
+	AtomicSizeHolder() noexcept;
+
+	void add(size_t i) noexcept;
+	void reduce(size_t i) noexcept;
+	size_t get() const noexcept;
+
+private:
+	std::atomic<size_t> n;
+};
+
+template <>
+class AtomicSizeHolder<false> {
+public:
+	void add(size_t i) noexcept;
+	void reduce(size_t i) noexcept;
+};
+
+/*
+ * Per-thread state of the epoch based reclamation. Every slot sits in its own
+ * cache line, since it is written on every pin / unpin.
+ */
+template <class Node>
+struct alignas(64) EpochSlot
+{
+	EpochSlot() noexcept;
+
+	std::atomic<bool> in_use;
+	// Zero if the owning thread is not pinned, (epoch << 1) | 1 otherwise
+	std::atomic<uint64_t> state;
+
+	// Removed nodes, bucketed by the epoch in which they were removed. Only
+	// accessed by the owning thread. These are not chained through the nodes,
+	// since a removed node may be re-inserted before it is reclaimed.
+	std::vector<Node *> limbo[3];
+	uint64_t limbo_epoch[3];
+	size_t ops_since_advance;
+};
+
+/// @endcond
+} // namespace czt_internal
+
+/**
+ * @brief Base class (template) to supply your node class with metainformation
+ *
+ * The class you use as nodes for the Concurrent Zip Tree *must* derive from
+ * this class (template). It supplies your class with the child pointers, the
+ * lock and the rank of the node.
+ *
+ * Ranks are handled exactly as for ZTree, i.e., the same TreeFlags::ZTREE_*
+ * options apply. See ZTreeNodeBase for details.
+ *
+ * @tparam Node    The node class itself. Yes, that's the class derived from
+ * this template. This sounds weird, but is correct. See the examples if you're
+ * confused.
+ * @tparam Options  The options class (a version of TreeOptions) that you
+ * parameterize the tree with. (See the options parameter of ConcurrentZTree.)
+ * @tparam Tag 		The tag used to identify the tree that this node should
+ * be inserted into. See ConcurrentZTree for details.
+ */
+template <class Node, class Options = DefaultOptions, class Tag = int>
+class ConcurrentZTreeNodeBase {
+public:
+	// Debugging methods
+	auto dbg_get_rank() const noexcept;
+
+protected:
+	/**
+	 * @brief Update the stored rank in this node
+	 *
+	 * See ZTreeNodeBase::update_rank(). This must not be called while the node
+	 * is in a tree.
+	 */
+	void update_rank() noexcept;
+
+private:
+	template <class, class, class, class, class, class>
+	friend class ConcurrentZTree;
+	template <class, class, bool, bool>
+	friend class ztree_internal::ZTreeRankGenerator;
+
+	czt_internal::ChildPointer<Node> _czt_left;
+	czt_internal::ChildPointer<Node> _czt_right;
+	czt_internal::NodeLock _czt_lock;
+
+	ztree_internal::ZTreeRankGenerator<Node, Options, Options::ztree_use_hash,
+	                                   Options::ztree_store_rank>
+	    _zt_rank;
+};
+
+template <class Node>
+class ConcurrentZTreeDefaultNodeTraits {
+public:
+	/**
+	 * @brief Called when a removed node may be reused
+	 *
+	 * This is called for every node that was removed via
+	 * ConcurrentZTree::remove(Node &, ThreadHandle &) as soon as no thread can
+	 * hold a pointer to it anymore, i.e., as soon as every thread that was pinned
+	 * when the node was removed has been unpinned. From this point on, you may
+	 * free or reuse the node. A node that is removed several times is reported
+	 * once per removal.
+	 *
+	 * It is called from the thread that removed the node, from within one of
+	 * its calls to ConcurrentZTree::remove() or ThreadHandle::pin(), or from
+	 * ConcurrentZTree::reclaim_all().
+	 *
+	 * @param node The node that may now be reused
+	 */
+	void
+	reclaimable(Node * node) const noexcept
+	{
+		(void)node;
+	}
+};
+
+/**
+ * @brief A Zip Tree that can be modified by many threads at the same time
+ *
+ * This is a thread-safe variant of ZTree. Insertion, removal and lookups may
+ * all be called concurrently from any number of threads.
+ *
+ * Insertion (unzipping) and removal (zipping) only ever modify the nodes on a
+ * single path, below the point where the inserted or removed node is located.
+ * Thus, every node carries a small spin lock, and both operations descend the
+ * tree via lock coupling: A thread locks a child before releasing its parent,
+ * and only ever locks children of nodes it already holds. The parent of the
+ * inserted / removed node stays locked until the operation is complete, such
+ * that no other modifying thread can observe a half-zipped tree. Since all
+ * locks are taken top-down, there are no deadlocks. Since inserted nodes have
+ * a rank of 1 half of the time, most insertions and removals only lock a few
+ * nodes close to the leaves for a longer time. Every modification still
+ * briefly locks the root.
+ *
+ * Lookups do not lock at all. Every lock carries a version, which is advanced
+ * whenever the node is unlocked after having been modified. A lookup descends
+ * the tree optimistically, remembering the version of every node it passes,
+ * and checks afterwards that none of them has been locked or modified in the
+ * meantime. Otherwise, it starts over. Thus, lookups never write to shared
+ * memory. After a few failed attempts, a lookup falls back to lock coupling,
+ * such that it cannot starve.
+ *
+ * Removed nodes: Lookups (find()) do not hold any locks, neither during the
+ * descent nor when returning a node. If the node can be removed concurrently,
+ * the caller must not use that pointer after the node has been freed or
+ * reused. To know
+ * when this is the case, every thread that wants to use such pointers must
+ * register via register_thread() and pin its ThreadHandle (via
+ * ThreadHandle::pin()) while doing the lookup and while using the result.
+ * Nodes removed via remove(Node &, ThreadHandle &) are reported to
+ * NodeTraits::reclaimable() once every thread that was pinned at the time of
+ * their removal has been unpinned (epoch based reclamation). See
+ * ConcurrentZTreeDefaultNodeTraits for details.
+ *
+ * If the MULTIPLE option is set, nodes comparing equally are ordered by their
+ * address. The tree does not provide iterators, since iterating a tree that is
+ * concurrently modified is not meaningful.
+ *
+ * @tparam Node         The node class for this tree. It must be derived from
+ * ConcurrentZTreeNodeBase.
+ * @tparam NodeTraits   A class implementing the reclaimable() hook. See
+ * ConcurrentZTreeDefaultNodeTraits.
+ * @tparam Options			The TreeOptions class specifying the
+ * parameters of this tree. See ZTree for the options concerning ranks.
+ * @tparam Tag					An class tag that identifies
+ * this tree. Can be used to insert the same nodes into multiple trees. Can be
+ * any class, the class can be empty.
+ * @tparam Compare      A compare class. See ZTree.
+ * @tparam RankGetter   A class that must implement a static size_t
+ * get_rank(const Node &) function. See ZTree.
+ */
+template <
+    class Node, class NodeTraits = ConcurrentZTreeDefaultNodeTraits<Node>,
+    class Options = DefaultOptions, class Tag = int,
+    class Compare = ygg::utilities::flexible_less,
+    class RankGetter = ztree_internal::ZTreeRankGenerator<
+        Node, Options, Options::ztree_use_hash, Options::ztree_store_rank>>
+class ConcurrentZTree {
+public:
+	using NB = ConcurrentZTreeNodeBase<Node, Options, Tag>;
+	using MyClass =
+	    ConcurrentZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>;
+
+	/**********************************************
+	 * Sanity Checks                              *
+	 **********************************************/
+	static_assert(
+	    Options::ztree_store_rank || Options::ztree_use_hash,
+	    "ZipTrees need to have either ZTREE_RANK_TYPE or ZTREE_USE_HASH set");
+	static_assert(std::is_base_of<NB, Node>::value,
+	              "Node class not properly derived from node base!");
+
+	class EpochGuard;
+
+	/**
+	 * @brief A thread's registration with the tree's epoch based reclamation
+	 *
+	 * Must only be used by a single thread at a time.
+	 */
+	class ThreadHandle {
+	public:
+		ThreadHandle(ThreadHandle && other) noexcept;
+		ThreadHandle(const ThreadHandle & other) = delete;
+		~ThreadHandle();
+
+		/**
+		 * @brief Pins the thread
+		 *
+		 * While the returned guard exists, no node that is removed from the
+		 * tree is reported as reclaimable. Guards must not be nested.
+		 *
+		 * @return A guard that unpins the thread when it is destroyed
+		 */
+		EpochGuard pin() noexcept;
+
+	private:
+		friend class ConcurrentZTree;
+		ThreadHandle(MyClass * tree, size_t slot) noexcept;
+
+		MyClass * tree;
+		size_t slot;
+	};
+
+	class EpochGuard {
+	public:
+		EpochGuard(EpochGuard && other) noexcept;
+		EpochGuard(const EpochGuard & other) = delete;
+		~EpochGuard();
+
+	private:
+		friend class ThreadHandle;
+		EpochGuard(MyClass * tree, size_t slot) noexcept;
+
+		MyClass * tree;
+		size_t slot;
+	};
+
+	/**
+	 * @brief Construct a new empty Concurrent Zip Tree.
+	 *
+	 * @param max_threads The maximum number of ThreadHandle objects that may
+	 * exist at the same time
+	 */
+	explicit ConcurrentZTree(size_t max_threads = 64);
+	ConcurrentZTree(const MyClass & other) = delete;
+	MyClass & operator=(const MyClass & other) = delete;
+
+	/**
+	 * @brief Registers the calling thread for epoch based reclamation
+	 *
+	 * If max_threads handles already exist, this blocks until one of them is
+	 * destroyed.
+	 *
+	 * @return A handle for the calling thread
+	 */
+	ThreadHandle register_thread() noexcept;
+
+	/**
+	 * @brief Inserts <node> into the tree
+	 *
+	 * May be called concurrently with all other operations. If ranks are
+	 * derived from hashes and stored, the node's rank must have been updated
+	 * before. See ZTree::insert() for further details.
+	 *
+	 * @param node The node to be inserted.
+	 */
+	void insert(Node & node) CMP_NOEXCEPT(node);
+
+	/**
+	 * @brief Removes <node> from the tree
+	 *
+	 * May be called concurrently with all other operations. The node is not
+	 * passed to the epoch based reclamation, i.e., you must make sure yourself
+	 * that no other thread still uses a pointer to it.
+	 *
+	 * @param node The node to be removed.
+	 */
+	void remove(Node & node) CMP_NOEXCEPT(node);
+
+	/**
+	 * @brief Removes <node> from the tree and retires it
+	 *
+	 * Like remove(Node &), but the node is reported to
+	 * NodeTraits::reclaimable() as soon as no pinned thread can still hold a
+	 * pointer to it.
+	 *
+	 * @param node The node to be removed.
+	 * @param handle The handle of the calling thread
+	 */
+	void remove(Node & node, ThreadHandle & handle) CMP_NOEXCEPT(node);
+
+	/**
+	 * @brief Finds a node that compares equally to <query>
+	 *
+	 * May be called concurrently with all other operations, and usually does
+	 * not take any locks. If nodes may be removed concurrently, the calling
+	 * thread must be pinned during the call and for as long as it uses the
+	 * result.
+	 *
+	 * @param query Anything comparable to a node
+	 * @return A pointer to a node comparing equally to <query>, or nullptr if
+	 * there is no such node.
+	 */
+	template <class Comparable>
+	Node * find(const Comparable & query) CMP_NOEXCEPT(query);
+
+	/**
+	 * @brief Returns whether the tree is empty
+	 *
+	 * The result may be outdated by the time it is returned if other threads
+	 * modify the tree.
+	 */
+	bool empty() const noexcept;
+
+	/**
+	 * @brief Returns the number of nodes in the tree
+	 *
+	 * Requires the CONSTANT_TIME_SIZE option. The result may be outdated by the
+	 * time it is returned if other threads modify the tree.
+	 */
+	size_t size() const noexcept;
+
+	/**
+	 * @brief Reports all retired nodes as reclaimable
+	 *
+	 * Calls NodeTraits::reclaimable() for every node that has been removed via
+	 * remove(Node &, ThreadHandle &) and not been reported yet.
+	 *
+	 * @warning This must only be called while no other thread accesses the tree.
+	 */
+	void reclaim_all() noexcept;
+
+	// Debugging methods. Must only be called while no other thread accesses the
+	// tree.
+	void dbg_verify() const;
+
+private:
+	using ChildPointer = czt_internal::ChildPointer<Node>;
+
+	// Whether <node> belongs to the left of <cur>. For MULTIPLE trees, equal
+	// nodes are ordered by their address.
+	bool goes_left(const Node & node, const Node & cur) const
+	    CMP_NOEXCEPT(node);
+
+	void unzip(Node * cur, Node & node) CMP_NOEXCEPT(node);
+	void zip(ChildPointer * slot, Node & old_root) noexcept;
+	void unlink(Node & node) CMP_NOEXCEPT(node);
+
+	// Lookups. The optimistic one returns false if it must be retried.
+	template <class Comparable>
+	bool find_optimistic(const Comparable & query, Node *& result) const
+	    CMP_NOEXCEPT(query);
+	template <class Comparable>
+	Node * find_locked(const Comparable & query) CMP_NOEXCEPT(query);
+
+	// Epoch based reclamation
+	void pin(size_t slot) noexcept;
+	void unpin(size_t slot) noexcept;
+	void retire(Node & node, size_t slot) noexcept;
+	bool try_advance_epoch() noexcept;
+	void reclaim_list(std::vector<Node *> & nodes) noexcept;
+	void reclaim_limbo(size_t slot, uint64_t epoch) noexcept;
+
+	// Debugging methods
+	size_t dbg_verify_consistency(Node * sub_root, Node * lower_bound,
+	                              Node * upper_bound) const;
+
+	Compare cmp;
+
+	ChildPointer root;
+	czt_internal::NodeLock root_lock;
+	czt_internal::AtomicSizeHolder<Options::constant_time_size> s;
+
+	// Number of operations after which a thread tries to advance the epoch
+	static constexpr size_t EPOCH_ADVANCE_INTERVAL = 64;
+	// Number of optimistic attempts of a lookup before it takes locks
+	static constexpr size_t OPTIMISTIC_ATTEMPTS = 4;
+	// Optimistic lookups fall back to taking locks below this depth
+	static constexpr size_t OPTIMISTIC_MAX_DEPTH = 128;
+
+	alignas(64) std::atomic<uint64_t> global_epoch;
+	size_t max_threads;
+	std::unique_ptr<czt_internal::EpochSlot<Node>[]> slots;
+};
+
+} // namespace ygg
+
+#ifndef YGG_CONCURRENT_ZIPTREE_CPP
+#include "concurrent_ziptree.cpp"
+#endif
+
+#endif // YGG_CONCURRENT_ZIPTREE_H
@@ -6,9 +6,12 @@
 
 #include "debug.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <cmath>
+#include <future>
+#include <initializer_list>
 #include <iostream>
+#include <thread>
 
 // TODO currently, only a multi-set is implemented
 
@@ -38,6 +41,12 @@ EnergyTree<Node, Options, Tag, Compare>::EnergyTree(MyClass && other)
 {
 	this->root = other.root;
 	other.root = nullptr;
+	this->rebuild_queue = std::move(other.rebuild_queue);
+	other.rebuild_queue.clear();
+	this->stat_counters() = other.stat_counters();
+	if constexpr (Options::collect_statistics) {
+		this->cmp = other.cmp;
+	}
 }
 
 template <class Node, class Options, class Tag, class Compare>
@@ -46,6 +55,12 @@ EnergyTree<Node, Options, Tag, Compare>::operator=(MyClass && other)
 {
 	this->root = other.root;
 	other.root = nullptr;
+	this->rebuild_queue = std::move(other.rebuild_queue);
+	other.rebuild_queue.clear();
+	this->stat_counters() = other.stat_counters();
+	if constexpr (Options::collect_statistics) {
+		this->cmp = other.cmp;
+	}
 
 	return *this;
 }
@@ -103,8 +118,9 @@ EnergyTree<Node, Options, Tag, Compare>::insert(Node & node)
 	}
 
 	if (rebuild_at != nullptr) {
-		this->rebuild_below(rebuild_at);
+		this->schedule_rebuild(rebuild_at);
 	}
+	this->rebuild_step();
 }
 
 template <class Node, class Options, class Tag, class Compare>
@@ -292,9 +308,306 @@ EnergyTree<Node, Options, Tag, Compare>::remove(Node & node)
 		}
 	}
 
+	if constexpr (Options::etree_incremental_rebuild) {
+		// A subtree scheduled at the removed node is now rooted at its replacement
+		Node * replacement = (child != &node) ? child : nullptr;
+		std::replace(this->rebuild_queue.pending.begin(),
+		             this->rebuild_queue.pending.end(), &node, replacement);
+	}
+
 	if (rebuild_at != nullptr) {
-		this->rebuild_below(rebuild_at);
+		this->schedule_rebuild(rebuild_at);
+	}
+	this->rebuild_step();
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable, class Callback>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::erase_range(const Comparable & lo,
+                                                     const Comparable & hi,
+                                                     Callback callback)
+{
+	size_t count = 0;
+	Node * next = this->unlink_range(lo, hi, count);
+
+	// The callback may free the node, thus read the next one first
+	while (next != nullptr) {
+		Node & node = *next;
+		next = next->NB::_et_right;
+
+		callback(node);
+	}
+
+	return count;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::erase_range(const Comparable & lo,
+                                                     const Comparable & hi)
+{
+	return this->erase_range(lo, hi, [](Node &) {});
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+typename EnergyTree<Node, Options, Tag, Compare>::MyClass
+EnergyTree<Node, Options, Tag, Compare>::extract_range(const Comparable & lo,
+                                                       const Comparable & hi)
+{
+	MyClass extracted;
+	size_t count = 0;
+
+	// The nodes come as a path of right children already
+	Node * range = this->unlink_range(lo, hi, count);
+	if (range == nullptr) {
+		return extracted;
+	}
+
+	Node * largest = nullptr;
+	for (Node * node = range; node != nullptr; node = node->NB::_et_right) {
+		node->NB::_et_parent = largest;
+		largest = node;
+	}
+
+	// Fix up the sizes along the path, then balance it in one go
+	size_t size = 0;
+	for (Node * node = largest; node != nullptr; node = node->NB::_et_parent) {
+		node->NB::_et_size = ++size;
+		node->NB::_et_energy = 0;
+	}
+	extracted.root = range;
+	extracted.s.add(count);
+	extracted.rebuild_below(extracted.root);
+
+	return extracted;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+Node *
+EnergyTree<Node, Options, Tag, Compare>::unlink_range(const Comparable & lo,
+                                                      const Comparable & hi,
+                                                      size_t & count)
+{
+	count = 0;
+
+	// All nodes of the range are below the first one we find on the way down
+	Node * top = this->root;
+	while (top != nullptr) {
+		if (this->cmp(*top, lo)) {
+			top = top->NB::_et_right;
+		} else if (!this->cmp(*top, hi)) {
+			top = top->NB::_et_left;
+		} else {
+			break;
+		}
+	}
+
+	if (top == nullptr) {
+		return nullptr;
+	}
+
+	/* Below <top>, the nodes that stay form two paths: On the left, the nodes
+	 * less than <lo> along their right pointers, and on the right, the nodes not
+	 * less than <hi> along their left pointers. Everything hanging off these
+	 * paths towards the range is cut off and collected as a path of right
+	 * children, in order. */
+	Node * head = top;
+	Node * tail = top;
+	Node * cur = top->NB::_et_left;
+	Node * right_cur = top->NB::_et_right;
+	top->NB::_et_left = nullptr;
+	top->NB::_et_right = nullptr;
+
+	Node * left_root = nullptr;
+	Node * left_last = nullptr;
+	while (cur != nullptr) {
+		if (this->cmp(*cur, lo)) {
+			if (left_last == nullptr) {
+				left_root = cur;
+			} else {
+				left_last->NB::_et_right = cur;
+			}
+			cur->NB::_et_parent = left_last;
+			left_last = cur;
+			cur = cur->NB::_et_right;
+		} else {
+			// <cur> and everything right of it is in the range
+			Node * next = cur->NB::_et_left;
+			cur->NB::_et_left = nullptr;
+			Node * piece_tail = nullptr;
+			Node * piece_head = flatten(cur, piece_tail);
+			piece_tail->NB::_et_right = head;
+			head = piece_head;
+			cur = next;
+		}
+	}
+	if (left_last != nullptr) {
+		left_last->NB::_et_right = nullptr;
+	}
+
+	Node * right_root = nullptr;
+	Node * right_last = nullptr;
+	cur = right_cur;
+	while (cur != nullptr) {
+		if (!this->cmp(*cur, hi)) {
+			if (right_last == nullptr) {
+				right_root = cur;
+			} else {
+				right_last->NB::_et_left = cur;
+			}
+			cur->NB::_et_parent = right_last;
+			right_last = cur;
+			cur = cur->NB::_et_left;
+		} else {
+			// <cur> and everything left of it is in the range
+			Node * next = cur->NB::_et_right;
+			cur->NB::_et_right = nullptr;
+			Node * piece_tail = nullptr;
+			tail->NB::_et_right = flatten(cur, piece_tail);
+			tail = piece_tail;
+			cur = next;
+		}
+	}
+	if (right_last != nullptr) {
+		right_last->NB::_et_left = nullptr;
+	}
+
+	// The largest node of the left path replaces <top>
+	Node * replacement = right_root;
+	if (left_last != nullptr) {
+		replacement = left_last;
+		left_last = replacement->NB::_et_parent;
+		Node * child = replacement->NB::_et_left;
+		if (left_last == nullptr) {
+			left_root = child;
+		} else {
+			left_last->NB::_et_right = child;
+		}
+		if (child != nullptr) {
+			child->NB::_et_parent = left_last;
+		}
+	}
+
+	/* Every node below which nodes were removed gains as much energy as the
+	 * individual removals would have given it. Only the topmost node that
+	 * needs to be rebuilt is rebuilt, just like in remove(). Below the
+	 * replacement, the two paths are disjoint, thus both may need one. */
+	Node * rebuild_at = nullptr;
+	auto update = [&](Node * node, size_t new_size) {
+		node->NB::_et_energy += node->NB::_et_size - new_size;
+		node->NB::_et_size = new_size;
+		if (2 * node->NB::_et_energy > node->NB::_et_size) {
+			rebuild_at = node;
+		}
+	};
+	auto size_of = [](const Node * node) -> size_t {
+		return (node != nullptr) ? node->NB::_et_size : 0;
+	};
+
+	Node * path_rebuilds[2] = {nullptr, nullptr};
+	Node * path_ends[2] = {left_last, right_last};
+	for (size_t side = 0; side < 2; ++side) {
+		for (Node * node = path_ends[side]; node != nullptr;
+		     node = node->NB::_et_parent) {
+			update(node, 1 + size_of(node->NB::_et_left) +
+			                 size_of(node->NB::_et_right));
+		}
+		path_rebuilds[side] = rebuild_at;
+		rebuild_at = nullptr;
+	}
+
+	if ((replacement != nullptr) && (replacement != right_root)) {
+		replacement->NB::_et_left = left_root;
+		replacement->NB::_et_right = right_root;
+		if (left_root != nullptr) {
+			left_root->NB::_et_parent = replacement;
+		}
+		if (right_root != nullptr) {
+			right_root->NB::_et_parent = replacement;
+		}
+		replacement->NB::_et_size = top->NB::_et_size;
+		replacement->NB::_et_energy = top->NB::_et_energy;
+		update(replacement, 1 + size_of(left_root) + size_of(right_root));
+	}
+	count = top->NB::_et_size - size_of(replacement);
+
+	Node * parent = top->NB::_et_parent;
+	if (replacement != nullptr) {
+		replacement->NB::_et_parent = parent;
+	}
+	if (parent == nullptr) {
+		this->root = replacement;
+	} else if (parent->NB::_et_left == top) {
+		parent->NB::_et_left = replacement;
+	} else {
+		assert(parent->NB::_et_right == top);
+		parent->NB::_et_right = replacement;
+	}
+
+	for (Node * node = parent; node != nullptr; node = node->NB::_et_parent) {
+		update(node, node->NB::_et_size - count);
+	}
+
+	if constexpr (Options::etree_incremental_rebuild) {
+		// Subtrees scheduled at removed nodes are gone, except for <top>'s
+		for (Node *& pending : this->rebuild_queue.pending) {
+			if (pending == top) {
+				pending = replacement;
+			} else if ((pending != nullptr) && !this->cmp(*pending, lo) &&
+			           this->cmp(*pending, hi)) {
+				pending = nullptr;
+			}
+		}
+	}
+
+	this->s.reduce(count);
+	if (rebuild_at != nullptr) {
+		this->schedule_rebuild(rebuild_at);
+	} else {
+		for (Node * node : path_rebuilds) {
+			if (node != nullptr) {
+				this->schedule_rebuild(node);
+			}
+		}
 	}
+	this->rebuild_step();
+
+	return head;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+Node *
+EnergyTree<Node, Options, Tag, Compare>::flatten(Node * subtree, Node *& tail)
+{
+	// Turns <subtree> into a path of right children by rotating right
+	Node * head = nullptr;
+	tail = nullptr;
+	Node * rest = subtree;
+	while (rest != nullptr) {
+		Node * left = rest->NB::_et_left;
+		if (left == nullptr) {
+			if (tail == nullptr) {
+				head = rest;
+			}
+			tail = rest;
+			rest = rest->NB::_et_right;
+		} else {
+			rest->NB::_et_left = left->NB::_et_right;
+			left->NB::_et_right = rest;
+			rest = left;
+			if (tail == nullptr) {
+				head = left;
+			} else {
+				tail->NB::_et_right = left;
+			}
+		}
+	}
+
+	return head;
 }
 
 template <class Node, class Options, class Tag, class Compare>
@@ -348,6 +661,11 @@ template <class Node, class Options, class Tag, class Compare>
 void
 EnergyTree<Node, Options, Tag, Compare>::dbg_verify_energy() const
 {
+	// Subtrees scheduled for rebuilding may temporarily exceed their energy
+	if (!this->rebuild_queue.empty()) {
+		return;
+	}
+
 	for (const Node & n : *this) {
 		debug::yggassert(2 * n.NB::_et_energy <= n.NB::_et_size);
 	}
@@ -397,230 +715,412 @@ EnergyTree<Node, Options, Tag, Compare>::dbg_verify_tree(Node * node) const
 
 template <class Node, class Options, class Tag, class Compare>
 void
-EnergyTree<Node, Options, Tag, Compare>::rebuild_below(Node * node)
+EnergyTree<Node, Options, Tag, Compare>::RebuildState::reset_links()
 {
-	// TODO this is a wild hack. Is this portable?
-	//	size_t full_tree_size = 1 << (fls(node->NB::_et_size) + (1 -
-	//__builtin_parity(node->NB::_et_size)));
-	int tree_levels =
-	    static_cast<int>(std::ceil(std::log2(node->NB::_et_size + 1)));
-	size_t full_tree_size = (1 << tree_levels) - 1;
-
-	this->rebuild_buffer.resize(full_tree_size);
+	for (int level = 0; level < this->tree_levels; ++level) {
+		this->pending_left[level] = nullptr;
+		this->pending_right[level] = nullptr;
+		this->missing_parent[level] = nullptr;
+		this->missing_left[level] = nullptr;
+	}
+}
 
-	Node * smallest;
-	Node * largest;
+template <class Node, class Options, class Tag, class Compare>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::RebuildState::counter_before(
+    size_t rank) const
+{
+	// Closed form of the counter progression in rebuild_place(): Up to the last
+	// node of the bottom level, the counter is incremented by one per node.
+	// After that, all odd (i.e., bottom level) positions are skipped.
+	if (rank <= this->max_counter_bottom_level) {
+		return rank;
+	}
+	return this->max_counter_bottom_level +
+	       2 * (rank - this->max_counter_bottom_level);
+}
 
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_below(Node * node)
+{
 	Node * original_parent = node->NB::_et_parent;
 	size_t original_size = node->NB::_et_size;
 
-	/*
-	std::cout << "################# Rebuilding subtree of size " << original_size
-	          << "\n";
-	*/
+	/* The rebuilt subtree is a complete tree, i.e., all levels except the
+	 * bottom one are full, and the bottom level is filled from the left. */
+	RebuildState state;
+	state.tree_levels = static_cast<int>(
+	    (sizeof(unsigned long long) * 8) -
+	    static_cast<size_t>(__builtin_clzll(original_size)));
+	size_t full_tree_size = (size_t{1} << state.tree_levels) - 1;
+	state.bottom_level_size =
+	    ((full_tree_size + 1) / 2) - (full_tree_size - original_size);
+	assert(state.bottom_level_size > 0);
+	state.max_counter_bottom_level = 1 + (2 * (state.bottom_level_size - 1));
+	state.counter = 0;
+	state.reset_links();
+
+	if constexpr (Options::etree_parallel_rebuild) {
+		if (original_size >= Options::etree_parallel_rebuild_threshold) {
+			// Fork until every thread has some work to do
+			unsigned int threads = static_cast<unsigned int>(
+			    Options::etree_parallel_rebuild_threads);
+			if (threads == 0) {
+				threads = std::thread::hardware_concurrency();
+			}
+			threads = std::max(2u, threads);
+			int fork_depth = static_cast<int>(sizeof(unsigned int) * 8) -
+			                 __builtin_clz(threads - 1);
+			this->rebuild_collect_parallel(node, 0, state, fork_depth);
+		} else {
+			this->rebuild_collect(node, state);
+		}
+	} else {
+		this->rebuild_collect(node, state);
+	}
 
-	// TODO it should be possible to prevent backtracking out of the node
-	smallest = node;
-	while (smallest->NB::_et_left != nullptr) {
-		smallest = smallest->NB::_et_left;
+	// The last node placed at the topmost level is the new subtree root
+	Node * top = state.pending_left[state.tree_levels - 1];
+	assert(top != nullptr);
+	assert(top->NB::_et_size == original_size);
+
+	// Top level connects to the original parent
+	top->NB::_et_parent = original_parent;
+	if (original_parent == nullptr) {
+		this->root = top;
+	} else if (original_parent->NB::_et_left == node) {
+		original_parent->NB::_et_left = top;
+	} else {
+		assert(original_parent->NB::_et_right == node);
+		original_parent->NB::_et_right = top;
 	}
-	largest = node;
-	while (largest->NB::_et_right != nullptr) {
-		largest = largest->NB::_et_right;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_collect(Node * node,
+                                                         RebuildState & state)
+{
+	/* In-order traversal of the old subtree. Both children of a node are read
+	 * before the node is placed, and placing a node only ever modifies nodes
+	 * that have already been traversed. Thus, the old structure stays intact
+	 * for everything we still have to visit. Recursing only to the left keeps
+	 * the recursion depth bounded by the height of the old subtree. */
+	while (node != nullptr) {
+		Node * left = node->NB::_et_left;
+		Node * right = node->NB::_et_right;
+
+		if (left != nullptr) {
+			this->rebuild_collect(left, state);
+		}
+
+		this->rebuild_place(node, state);
+
+		node = right;
 	}
+}
 
-	iterator<false> it(smallest);
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_place(Node * node,
+                                                       RebuildState & state)
+{
+	// Lowest level is 0, topmost is (tree_levels - 1). Past the last node of
+	// the bottom level, every bottom level slot (odd counter) is skipped.
+	state.counter++;
+	if ((state.counter > state.max_counter_bottom_level) &&
+	    (state.counter % 2 == 1)) {
+		state.counter++;
+	}
+	int level = __builtin_ctzll(state.counter);
+	size_t index_in_level = state.counter >> (level + 1);
+
+	// The subtree below this node covers 2^level slots of the bottom level, of
+	// which only the first bottom_level_size are occupied.
+	size_t bottom_width = size_t{1} << level;
+	size_t bottom_start = index_in_level * bottom_width;
+	size_t bottom_used = 0;
+	if (bottom_start < state.bottom_level_size) {
+		bottom_used =
+		    std::min(bottom_width, state.bottom_level_size - bottom_start);
+	}
 
-	size_t bottom_level_size =
-	    ((full_tree_size + 1) / 2) - (full_tree_size - original_size);
-	assert((full_tree_size + 1) / 2 > (full_tree_size - original_size));
-	assert(bottom_level_size > 0);
-
-	size_t max_counter_bottom_level = 1 + (2 * (bottom_level_size - 1));
-	//	std::cout << "Bottom level size: " << bottom_level_size << "\n";
-	// std::cout << "Max bottom level counter: " << max_counter_bottom_level <<
-	// "\n";
-
-	// Handle first element manually
-	this->rebuild_buffer[0] = smallest;
-	unsigned int counter = 1;
-
-	/*
-	std::cout << "--------------------\n";
-	std::cout << "N: " << std::hex << (size_t)smallest << std::dec << "\n";
-	std::cout << "Level offset 0 / index 0 \n";
-	*/
-
-	// TODO unroll this loop?
-	while (&(*it) != largest) {
-		++it;
-		++counter;
-		// TODO this is a two-phase loop. Unroll the two phases.
-		if (counter > max_counter_bottom_level) {
-			if (counter % 2 == 1) {
-				counter++;
+	node->NB::_et_size = bottom_width - 1 + bottom_used;
+	node->NB::_et_energy = 0;
+	node->NB::_et_right = nullptr;
+
+	// Our left child (if any) is the last node placed one level below.
+	node->NB::_et_left = nullptr;
+	if (level > 0) {
+		Node * child = state.pending_left[level - 1];
+		if (child != nullptr) {
+			node->NB::_et_left = child;
+			child->NB::_et_parent = node;
+			state.pending_left[level - 1] = nullptr;
+		} else if ((level > 1) || (bottom_used > 0)) {
+			// It exists, but has been placed by someone else.
+			state.missing_left[level] = node;
+		}
+	}
+
+	// Odd indices are right children of the last node placed one level above,
+	// even indices wait to become the left child of the next one.
+	if ((level + 1 < state.tree_levels) && (index_in_level % 2 == 1)) {
+		Node * parent = state.pending_right[level + 1];
+		if (parent != nullptr) {
+			parent->NB::_et_right = node;
+			node->NB::_et_parent = parent;
+			state.pending_right[level + 1] = nullptr;
+		} else {
+			state.missing_parent[level] = node;
+		}
+	} else {
+		state.pending_left[level] = node;
+	}
+	state.pending_right[level] = node;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_collect_parallel(
+    Node * node, size_t rank_offset, RebuildState & state, int fork_depth)
+{
+	state.counter = state.counter_before(rank_offset);
+
+	if ((fork_depth <= 0) ||
+	    (node->NB::_et_size < Options::etree_parallel_rebuild_threshold)) {
+		this->rebuild_collect(node, state);
+		return;
+	}
+
+	/* The old left subtree, the old root and the old right subtree are three
+	 * consecutive ranges of ranks in the new subtree. The right range is
+	 * relinked by a second thread, using its own state. Links crossing the
+	 * ranges are established afterwards by rebuild_merge(). */
+	Node * left = node->NB::_et_left;
+	Node * right = node->NB::_et_right;
+	size_t left_size = (left != nullptr) ? left->NB::_et_size : 0;
+
+	RebuildState right_state = state;
+	right_state.reset_links();
+
+	std::future<void> right_done;
+	if (right != nullptr) {
+		right_done = std::async(std::launch::async, [&]() {
+			this->rebuild_collect_parallel(right, rank_offset + left_size + 1,
+			                               right_state, fork_depth - 1);
+		});
+	}
+
+	if (left != nullptr) {
+		this->rebuild_collect_parallel(left, rank_offset, state, fork_depth - 1);
+	}
+	state.counter = state.counter_before(rank_offset + left_size);
+	this->rebuild_place(node, state);
+
+	if (right != nullptr) {
+		right_done.get();
+		this->rebuild_merge(state, right_state);
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_merge(RebuildState & front,
+                                                       RebuildState & back)
+{
+	/* If the front part is itself only a part of the subtree (i.e., the forks
+	 * are nested), the missing link may lie before the front part as well. In
+	 * that case, it is passed on to whoever merges the front part. */
+	for (int level = 0; level < front.tree_levels; ++level) {
+		Node * node = back.missing_parent[level];
+		if (node != nullptr) {
+			Node * parent = front.pending_right[level + 1];
+			if (parent != nullptr) {
+				parent->NB::_et_right = node;
+				node->NB::_et_parent = parent;
+				front.pending_right[level + 1] = nullptr;
+			} else {
+				assert(front.missing_parent[level] == nullptr);
+				front.missing_parent[level] = node;
+			}
+		}
+
+		node = back.missing_left[level];
+		if (node != nullptr) {
+			Node * child = front.pending_left[level - 1];
+			if (child != nullptr) {
+				node->NB::_et_left = child;
+				child->NB::_et_parent = node;
+				front.pending_left[level - 1] = nullptr;
+			} else {
+				assert(front.missing_left[level] == nullptr);
+				front.missing_left[level] = node;
 			}
 		}
+	}
+
+	for (int level = 0; level < front.tree_levels; ++level) {
+		if (back.pending_left[level] != nullptr) {
+			front.pending_left[level] = back.pending_left[level];
+		}
+		if (back.pending_right[level] != nullptr) {
+			front.pending_right[level] = back.pending_right[level];
+		}
+	}
+	front.counter = back.counter;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::schedule_rebuild(Node * node)
+{
+	this->stat_counters().count_rebuild();
+
+	if constexpr (Options::etree_incremental_rebuild) {
+		if (node->NB::_et_size <= Options::etree_incremental_rebuild_budget) {
+			this->rebuild_below(node);
+		} else {
+			// Reset the energy right away, so that we do not schedule this subtree
+			// again with every operation until it has been rebuilt
+			node->NB::_et_energy = 0;
+			this->rebuild_queue.pending.push_back(node);
+		}
+	} else {
+		this->rebuild_below(node);
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rebuild_step()
+{
+	if constexpr (Options::etree_incremental_rebuild) {
+		size_t budget = Options::etree_incremental_rebuild_budget;
+		auto & pending = this->rebuild_queue.pending;
+
+		while (!pending.empty() && (budget > 0)) {
+			Node * node = pending.back();
+			pending.pop_back();
+			if (node == nullptr) {
+				// was removed from the tree
+				continue;
+			}
 
-		// Lowest level is 0, topmost is (tree_levels - 1)
-		int level = __builtin_ctz(counter);
-		size_t prev_levels_size = (1 << (tree_levels - 1 - level)) - 1;
-		size_t this_level_size = prev_levels_size + 1;
-		size_t level_offset =
-		    full_tree_size - prev_levels_size -
-		    this_level_size; // TODO can be simplified - just omit the "-1" above
-
-		unsigned int index_in_level = counter >> (level + 1);
-
-		/*
-		std::cout << "N: " << std::hex << (size_t) & (*it) << std::dec << "\n";
-		std::cout << "Level offset " << level_offset << " / index "
-		          << index_in_level << "\n";
-		*/
-
-		this->rebuild_buffer[level_offset +
-		                     static_cast<unsigned long>(index_in_level)] = &(*it);
-	}
-
-	//	std::cout << "--------------------\n";
-
-	size_t lower_offset = 0;
-	size_t upper_offset = (full_tree_size + 1) / 2;
-
-	//	std::cout << "-- Up-linking bottom level. Level Size: " <<
-	// bottom_level_size
-	//          << "\n";
-
-	if (tree_levels > 1) {
-		// Linking the bottom level up is special, since it is not full
-		size_t i = 0;
-		for (; i < bottom_level_size - 1; i += 2) { // Go in steps of two
-			/*
-			std::cout << "## i: " << i << " Upper Node: " << std::hex
-			          << (size_t)this->rebuild_buffer[upper_offset + (i / 2)]
-			          << std::dec << "\n";
-			*/
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_left =
-			    this->rebuild_buffer[i];
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_right =
-			    this->rebuild_buffer[i + 1];
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_size = 3;
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_energy = 0;
-			/*
-			std::cout << "  L: " << std::hex << this->rebuild_buffer[i]
-			          << " R: " << this->rebuild_buffer[i + 1] << std::dec << "\n";
-			*/
-			this->rebuild_buffer[i]->NB::_et_left = nullptr;
-			this->rebuild_buffer[i]->NB::_et_size = 1;
-			this->rebuild_buffer[i]->NB::_et_energy = 0;
-			this->rebuild_buffer[i]->NB::_et_right = nullptr;
-			this->rebuild_buffer[i]->NB::_et_parent =
-			    this->rebuild_buffer[upper_offset + (i / 2)];
-			this->rebuild_buffer[i + 1]->NB::_et_left = nullptr;
-			this->rebuild_buffer[i + 1]->NB::_et_right = nullptr;
-			this->rebuild_buffer[i + 1]->NB::_et_parent =
-			    this->rebuild_buffer[upper_offset + (i / 2)];
-			this->rebuild_buffer[i + 1]->NB::_et_size = 1;
-			this->rebuild_buffer[i + 1]->NB::_et_energy = 0;
-		}
-		if (i < bottom_level_size) {
-			/*
-			std::cout << "## Remaining i: " << i << " Upper Node: " << std::hex
-			          << (size_t)this->rebuild_buffer[upper_offset + (i / 2)]
-			          << std::dec << "\n";
-			std::cout << "  L: " << std::hex << this->rebuild_buffer[i] << std::dec
-			          << "\n";
-			*/
-
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_left =
-			    this->rebuild_buffer[i];
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_right = nullptr;
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_size = 2;
-			this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_energy = 0;
-
-			this->rebuild_buffer[i]->NB::_et_left = nullptr;
-			this->rebuild_buffer[i]->NB::_et_right = nullptr;
-			this->rebuild_buffer[i]->NB::_et_parent =
-			    this->rebuild_buffer[upper_offset + (i / 2)];
-			this->rebuild_buffer[i]->NB::_et_size = 1;
-			this->rebuild_buffer[i]->NB::_et_energy = 0;
-
-			i += 2;
-		}
-
-		for (size_t j = i / 2; j < static_cast<size_t>(1 << (tree_levels - 2));
-		     j++) {
-			// Remaining nodes in the second-to-last level
-			/*
-			std::cout << "## Zero-ing out to below " << std::hex
-			          << this->rebuild_buffer[i] << std::dec << " at position " << j
-			          << " \n";
-			*/
-			this->rebuild_buffer[upper_offset + j]->NB::_et_left = nullptr;
-			this->rebuild_buffer[upper_offset + j]->NB::_et_right = nullptr;
-			this->rebuild_buffer[upper_offset + j]->NB::_et_size = 1;
-			this->rebuild_buffer[upper_offset + j]->NB::_et_energy = 0;
-		}
-
-		// Now, climb up the levels
-		int level = 1;
-		while (level < tree_levels - 1) {
-
-			lower_offset = upper_offset;
-			upper_offset = full_tree_size - (1 << (tree_levels - 1 - level)) + 1;
-			assert(upper_offset > lower_offset);
-			size_t current_lower_level_size = upper_offset - lower_offset;
-
-			/*
-			std::cout << "-- Up-linking level " << level
-			          << ". Lower Offset: " << lower_offset
-			          << " | Upper Offset: " << upper_offset << "\n";
-			*/
-			// TODO it's probably faster to increment *_offset and save some
-			// additions…
-			for (i = 0; i < current_lower_level_size; i += 2) { // Go in steps of two
-				/*
-				std::cout << "## i: " << i << " Upper node: " << std::hex
-				          << this->rebuild_buffer[upper_offset + (i / 2)] << std::dec
-				          << "\n";
-				*/
-				this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_left =
-				    this->rebuild_buffer[lower_offset + i];
-				this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_right =
-				    this->rebuild_buffer[lower_offset + i + 1];
-				this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_size =
-				    (this->rebuild_buffer[lower_offset + i]->NB::_et_size +
-				     this->rebuild_buffer[lower_offset + i + 1]->NB::_et_size + 1);
-				this->rebuild_buffer[upper_offset + (i / 2)]->NB::_et_energy = 0;
-
-				this->rebuild_buffer[lower_offset + i]->NB::_et_parent =
-				    this->rebuild_buffer[upper_offset + (i / 2)];
-				this->rebuild_buffer[lower_offset + i + 1]->NB::_et_parent =
-				    this->rebuild_buffer[upper_offset + (i / 2)];
+			if (node->NB::_et_size <= budget) {
+				budget -= node->NB::_et_size;
+				this->rebuild_below(node);
+				continue;
 			}
 
-			level += 1;
+			size_t work = this->rebuild_partition(node);
+			budget -= std::min(budget, work);
 		}
 	}
+}
 
-	/*
-	std::cout << "-- Fixing Top.\n";
-	std::cout << "Top node: " << std::hex << this->rebuild_buffer.back()
-	          << " / Parent: " << original_parent << std::dec << "\n";
-	*/
+template <class Node, class Options, class Tag, class Compare>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::rebuild_partition(Node * node)
+{
+	// Find the median of the subtree
+	size_t rank = (node->NB::_et_size - 1) / 2;
+	Node * median = node;
+	size_t work = 1;
+	while (true) {
+		size_t left_size = (median->NB::_et_left != nullptr)
+		                       ? median->NB::_et_left->NB::_et_size
+		                       : 0;
+		if (rank < left_size) {
+			median = median->NB::_et_left;
+		} else if (rank > left_size) {
+			rank -= left_size + 1;
+			median = median->NB::_et_right;
+		} else {
+			break;
+		}
+		work++;
+	}
 
-	// Top level connects to the original parent
-	this->rebuild_buffer.back()->NB::_et_parent = original_parent;
-	if (original_parent == nullptr) {
-		this->root = this->rebuild_buffer.back();
-	} else if (original_parent->NB::_et_left == node) {
-		original_parent->NB::_et_left = this->rebuild_buffer.back();
+	// Rotate it to the top of the subtree
+	Node * anchor = node->NB::_et_parent;
+	while (median->NB::_et_parent != anchor) {
+		this->rotate_up(median);
+	}
+	median->NB::_et_energy = 0;
+
+	/* Balance the two halves later on. Everything of size <= 2 is balanced,
+	 * but its energy may still stem from before the subtree was scheduled. All
+	 * other nodes are reset when their half is partitioned or rebuilt. */
+	for (Node * half : {median->NB::_et_right, median->NB::_et_left}) {
+		if (half == nullptr) {
+			continue;
+		}
+		if (half->NB::_et_size > 2) {
+			this->rebuild_queue.pending.push_back(half);
+			continue;
+		}
+
+		half->NB::_et_energy = 0;
+		for (Node * child : {half->NB::_et_left, half->NB::_et_right}) {
+			if (child != nullptr) {
+				child->NB::_et_energy = 0;
+			}
+		}
+		work++;
+	}
+
+	return work;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::rotate_up(Node * node)
+{
+	this->stat_counters().count_rotation();
+
+	Node * parent = node->NB::_et_parent;
+	Node * grandparent = parent->NB::_et_parent;
+
+	if (parent->NB::_et_left == node) {
+		parent->NB::_et_left = node->NB::_et_right;
+		if (parent->NB::_et_left != nullptr) {
+			parent->NB::_et_left->NB::_et_parent = parent;
+		}
+		node->NB::_et_right = parent;
 	} else {
-		assert(original_parent->NB::_et_right == node);
-		original_parent->NB::_et_right = this->rebuild_buffer.back();
+		assert(parent->NB::_et_right == node);
+		parent->NB::_et_right = node->NB::_et_left;
+		if (parent->NB::_et_right != nullptr) {
+			parent->NB::_et_right->NB::_et_parent = parent;
+		}
+		node->NB::_et_left = parent;
+	}
+	parent->NB::_et_parent = node;
+
+	node->NB::_et_parent = grandparent;
+	if (grandparent == nullptr) {
+		this->root = node;
+	} else if (grandparent->NB::_et_left == parent) {
+		grandparent->NB::_et_left = node;
+	} else {
+		assert(grandparent->NB::_et_right == parent);
+		grandparent->NB::_et_right = node;
+	}
+
+	node->NB::_et_size = parent->NB::_et_size;
+	parent->NB::_et_size = 1;
+	if (parent->NB::_et_left != nullptr) {
+		parent->NB::_et_size += parent->NB::_et_left->NB::_et_size;
+	}
+	if (parent->NB::_et_right != nullptr) {
+		parent->NB::_et_size += parent->NB::_et_right->NB::_et_size;
 	}
-	this->rebuild_buffer.back()->NB::_et_size = original_size;
-	this->rebuild_buffer.back()->NB::_et_energy = 0;
+
+	// The subtrees of both nodes changed - restart accounting.
+	node->NB::_et_energy = 0;
+	parent->NB::_et_energy = 0;
 }
 
 template <class Node, class Options, class Tag, class Compare>
@@ -872,6 +1372,195 @@ EnergyTree<Node, Options, Tag, Compare>::lower_bound(
 	return const_iterator<false>(const_cast<MyClass *>(this)->lower_bound(query));
 }
 
+template <class Node, class Options, class Tag, class Compare>
+template <class NodeT>
+NodeT *
+EnergyTree<Node, Options, Tag, Compare>::select_below(NodeT * node, size_t k)
+{
+	while (node != nullptr) {
+		size_t left_size = (node->NB::_et_left != nullptr)
+		                       ? node->NB::_et_left->NB::_et_size
+		                       : 0;
+		if (k < left_size) {
+			node = node->NB::_et_left;
+		} else if (k > left_size) {
+			k -= left_size + 1;
+			node = node->NB::_et_right;
+		} else {
+			return node;
+		}
+	}
+
+	return nullptr;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class NodeT>
+NodeT *
+EnergyTree<Node, Options, Tag, Compare>::jump(NodeT * node, size_t steps,
+                                              bool forward)
+{
+	if (node == nullptr) {
+		return nullptr;
+	}
+
+	/* Climb until the subtree contains the target, keeping track of the
+	 * rank of <node> within the current subtree. For short jumps, this stays
+	 * close to <node>. */
+	NodeT * cur = node;
+	size_t before = (node->NB::_et_left != nullptr)
+	                    ? node->NB::_et_left->NB::_et_size
+	                    : 0;
+
+	while (forward ? (before + steps >= cur->NB::_et_size) : (before < steps)) {
+		NodeT * parent = cur->NB::_et_parent;
+		if (parent == nullptr) {
+			return nullptr;
+		}
+
+		if (parent->NB::_et_right == cur) {
+			before += 1;
+			if (parent->NB::_et_left != nullptr) {
+				before += parent->NB::_et_left->NB::_et_size;
+			}
+		}
+		cur = parent;
+	}
+
+	return select_below(cur, forward ? (before + steps) : (before - steps));
+}
+
+template <class Node, class Options, class Tag, class Compare>
+typename EnergyTree<Node, Options, Tag, Compare>::template const_iterator<false>
+EnergyTree<Node, Options, Tag, Compare>::select(size_t k) const
+{
+	return const_iterator<false>(select_below<const Node>(this->root, k));
+}
+
+template <class Node, class Options, class Tag, class Compare>
+typename EnergyTree<Node, Options, Tag, Compare>::template iterator<false>
+EnergyTree<Node, Options, Tag, Compare>::select(size_t k)
+{
+	return iterator<false>(select_below(this->root, k));
+}
+
+template <class Node, class Options, class Tag, class Compare>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::rank(const Node & node) const
+{
+	size_t result = 0;
+	if (node.NB::_et_left != nullptr) {
+		result = node.NB::_et_left->NB::_et_size;
+	}
+
+	const Node * cur = &node;
+	while (cur->NB::_et_parent != nullptr) {
+		const Node * parent = cur->NB::_et_parent;
+		if (parent->NB::_et_right == cur) {
+			result += 1;
+			if (parent->NB::_et_left != nullptr) {
+				result += parent->NB::_et_left->NB::_et_size;
+			}
+		}
+		cur = parent;
+	}
+
+	return result;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::count_less(
+    const Comparable & query) const
+{
+	size_t count = 0;
+	const Node * cur = this->root;
+
+	while (cur != nullptr) {
+		if (this->cmp(*cur, query)) {
+			count += 1;
+			if (cur->NB::_et_left != nullptr) {
+				count += cur->NB::_et_left->NB::_et_size;
+			}
+			cur = cur->NB::_et_right;
+		} else {
+			cur = cur->NB::_et_left;
+		}
+	}
+
+	return count;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::count_not_greater(
+    const Comparable & query) const
+{
+	size_t count = 0;
+	const Node * cur = this->root;
+
+	while (cur != nullptr) {
+		if (this->cmp(query, *cur)) {
+			cur = cur->NB::_et_left;
+		} else {
+			count += 1;
+			if (cur->NB::_et_left != nullptr) {
+				count += cur->NB::_et_left->NB::_et_size;
+			}
+			cur = cur->NB::_et_right;
+		}
+	}
+
+	return count;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class LowerComparable, class UpperComparable>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::count_range(
+    const LowerComparable & lower, const UpperComparable & upper) const
+{
+	size_t not_greater = this->count_not_greater(upper);
+	size_t less = this->count_less(lower);
+
+	if (not_greater <= less) {
+		return 0;
+	}
+	return not_greater - less;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+std::pair<
+    typename EnergyTree<Node, Options, Tag, Compare>::template iterator<false>,
+    typename EnergyTree<Node, Options, Tag, Compare>::template iterator<false>>
+EnergyTree<Node, Options, Tag, Compare>::equal_range(const Comparable & query)
+{
+	return {this->lower_bound(query), this->upper_bound(query)};
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+std::pair<typename EnergyTree<Node, Options, Tag,
+                              Compare>::template const_iterator<false>,
+          typename EnergyTree<Node, Options, Tag,
+                              Compare>::template const_iterator<false>>
+EnergyTree<Node, Options, Tag, Compare>::equal_range(
+    const Comparable & query) const
+{
+	return {this->lower_bound(query), this->upper_bound(query)};
+}
+
+template <class Node, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+EnergyTree<Node, Options, Tag, Compare>::count(const Comparable & query) const
+{
+	return this->count_range(query, query);
+}
+
 template <class Node, class Options, class Tag, class Compare>
 size_t
 EnergyTree<Node, Options, Tag, Compare>::size() const
@@ -879,12 +1568,43 @@ EnergyTree<Node, Options, Tag, Compare>::size() const
 	return this->s.get();
 }
 
+template <class Node, class Options, class Tag, class Compare>
+stats::Counters
+EnergyTree<Node, Options, Tag, Compare>::get_statistics() const noexcept
+{
+	static_assert(Options::collect_statistics,
+	              "Statistics are only collected with COLLECT_STATISTICS.");
+
+	stats::Counters counters = this->stat_counters().get();
+	counters.comparisons = this->cmp.get_count();
+	return counters;
+}
+
+template <class Node, class Options, class Tag, class Compare>
+void
+EnergyTree<Node, Options, Tag, Compare>::reset_statistics() noexcept
+{
+	this->stat_counters().reset();
+	if constexpr (Options::collect_statistics) {
+		this->cmp.reset_count();
+	}
+}
+
+template <class Node, class Options, class Tag, class Compare>
+stats::Shape
+EnergyTree<Node, Options, Tag, Compare>::collect_shape() const
+{
+	return stats::compute_shape<NodeInterface>(
+	    static_cast<const Node *>(this->root));
+}
+
 template <class Node, class Options, class Tag, class Compare>
 void
 EnergyTree<Node, Options, Tag, Compare>::clear()
 {
 	this->root = nullptr;
 	this->s.set(0);
+	this->rebuild_queue.clear();
 }
 
 } // namespace ygg
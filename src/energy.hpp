@@ -1,13 +1,50 @@
 #ifndef YGG_ENERGY_HPP
 #define YGG_ENERGY_HPP
 
-#include <vector>
-
 #include "options.hpp"
 #include "size_holder.hpp"
+#include "stats.hpp"
 #include "tree_iterator.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace ygg {
+namespace energy_internal {
+/*
+ * Holds the subtrees that are scheduled for rebuilding if
+ * ETREE_INCREMENTAL_REBUILD is set. Empty otherwise.
+ */
+template <class Node, bool enable>
+class RebuildQueue {
+public:
+	bool
+	empty() const
+	{
+		return true;
+	}
+	void
+	clear()
+	{}
+};
+
+template <class Node>
+class RebuildQueue<Node, true> {
+public:
+	bool
+	empty() const
+	{
+		return this->pending.empty();
+	}
+	void
+	clear()
+	{
+		this->pending.clear();
+	}
+
+	std::vector<Node *> pending;
+};
+} // namespace energy_internal
 
 template <class Node, class Options = DefaultOptions, class Tag = int>
 class EnergyTreeNodeBase {
@@ -25,12 +62,15 @@ public:
 
 template <class Node, class Options = DefaultOptions, class Tag = int,
           class Compare = ygg::utilities::flexible_less>
-class EnergyTree {
+class EnergyTree : private stats::CounterHolder<Options::collect_statistics> {
 	using MyClass = EnergyTree<Node, Options, Tag, Compare>;
 	using NB = EnergyTreeNodeBase<Node, Options, Tag>;
 
 	static_assert(std::is_base_of<NB, Node>::value,
 	              "Node class not properly derived from EnergyTreeNodeBase");
+	static_assert(!Options::etree_incremental_rebuild ||
+	                  (Options::etree_incremental_rebuild_budget > 0),
+	              "ETREE_INCREMENTAL_REBUILD needs a budget of at least one");
 
 public:
 	EnergyTree();
@@ -98,6 +138,20 @@ public:
 		    : internal::IteratorBase<iterator<reverse>, Node, NodeInterface,
 		                             reverse>(){};
 
+		// Jumps run in O(log n), using the subtree sizes
+		iterator<reverse> &
+		operator+=(size_t steps)
+		{
+			this->n = MyClass::jump(this->n, steps, !reverse);
+			return *this;
+		}
+		iterator<reverse> &
+		operator-=(size_t steps)
+		{
+			this->n = MyClass::jump(this->n, steps, reverse);
+			return *this;
+		}
+
 	private:
 		friend class const_iterator<reverse>;
 	};
@@ -118,6 +172,20 @@ public:
 		const_iterator()
 		    : internal::IteratorBase<const_iterator<reverse>, const Node,
 		                             NodeInterface, reverse>(){};
+
+		// Jumps run in O(log n), using the subtree sizes
+		const_iterator<reverse> &
+		operator+=(size_t steps)
+		{
+			this->n = MyClass::jump(this->n, steps, !reverse);
+			return *this;
+		}
+		const_iterator<reverse> &
+		operator-=(size_t steps)
+		{
+			this->n = MyClass::jump(this->n, steps, reverse);
+			return *this;
+		}
 	};
 	/******************************************************
 	 ******************************************************
@@ -221,7 +289,83 @@ public:
 	template <class Comparable>
 	iterator<false> lower_bound(const Comparable & query);
 
-	
+	/**
+	 * @brief Returns the element of a given rank
+	 *
+	 * Returns an iterator to the element that has exactly <k> elements before
+	 * it in the tree, i.e., select(0) returns the smallest element.
+	 *
+	 * This method runs in O(log n).
+	 *
+	 * @param k The rank of the element to be returned
+	 * @returns An iterator to the element of rank <k>, or end() if the tree has
+	 * at most <k> elements
+	 */
+	const_iterator<false> select(size_t k) const;
+	iterator<false> select(size_t k);
+
+	/**
+	 * @brief Returns the rank of a node
+	 *
+	 * Returns the number of elements that are before <node> in the tree. This is
+	 * the inverse of select().
+	 *
+	 * This method runs in O(log n).
+	 *
+	 * @param node The node whose rank should be returned. Must be in the tree.
+	 * @returns The number of elements before <node>
+	 */
+	size_t rank(const Node & node) const;
+
+	/**
+	 * @brief Counts the elements in a range
+	 *
+	 * Returns the number of elements e in the tree that are neither less than
+	 * <lower> nor greater than <upper>, i.e., the number of elements between
+	 * lower_bound(lower) and upper_bound(upper). See lower_bound() for
+	 * the requirements on <lower> and <upper>.
+	 *
+	 * This method runs in O(log n), independent of the number of elements
+	 * counted.
+	 *
+	 * @param lower The lower end of the range (inclusive)
+	 * @param upper The upper end of the range (inclusive)
+	 * @returns The number of elements in [lower, upper]
+	 */
+	template <class LowerComparable, class UpperComparable>
+	size_t count_range(const LowerComparable & lower,
+	                   const UpperComparable & upper) const;
+
+	/**
+	 * @brief Returns the range of elements comparing equally to <query>
+	 *
+	 * Returns a pair of iterators, the first being lower_bound(<query>) and the
+	 * second being upper_bound(<query>). This runs in O(log n) regardless of the
+	 * number of equal elements.
+	 *
+	 * @param query An object comparable to Node
+	 * @returns A pair of iterators delimiting the elements comparing equally to
+	 * <query>.
+	 */
+	template <class Comparable>
+	std::pair<const_iterator<false>, const_iterator<false>>
+	equal_range(const Comparable & query) const;
+	template <class Comparable>
+	std::pair<iterator<false>, iterator<false>>
+	equal_range(const Comparable & query);
+
+	/**
+	 * @brief Counts the elements comparing equally to <query>
+	 *
+	 * Equivalent to count_range(<query>, <query>), thus this runs in O(log n)
+	 * regardless of the number of counted elements.
+	 *
+	 * @param query An object comparable to Node
+	 * @returns The number of elements comparing equally to <query>
+	 */
+	template <class Comparable>
+	size_t count(const Comparable & query) const;
+
 	// Iteration
 	/**
 	 * Returns an iterator pointing to the smallest element in the tree.
@@ -282,6 +426,50 @@ public:
 	 */
 	void remove(Node & node);
 
+	/**
+	 * @brief Removes all nodes in a key range from the tree
+	 *
+	 * Removes all nodes that are not less than <lo> but less than <hi>, i.e., the
+	 * range [lo, hi). Every node is handed to <callback> right after it has been
+	 * removed, so the owner of the nodes may e.g. free them there.
+	 *
+	 * The range is cut out of the tree along the two paths to its boundaries.
+	 * Every node above the removed ones gains as much energy as if they had been
+	 * removed one by one, and at most one subtree is rebuilt afterwards. Thus,
+	 * removing k nodes costs O(log n + k) amortized.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be removed.
+	 * @param hi    Anything comparable to a node. All removed nodes are less than
+	 * <hi>.
+	 * @param callback  A callable that is invoked as callback(Node &) for every
+	 * removed node.
+	 *
+	 * @return The number of removed nodes
+	 */
+	template <class Comparable, class Callback>
+	size_t erase_range(const Comparable & lo, const Comparable & hi,
+	                   Callback callback);
+	template <class Comparable>
+	size_t erase_range(const Comparable & lo, const Comparable & hi);
+
+	/**
+	 * @brief Moves all nodes in a key range into a new tree
+	 *
+	 * Removes all nodes in the range [lo, hi) from this tree (see erase_range())
+	 * and returns a tree containing exactly these nodes. The new tree is built
+	 * by a single rebuild in O(k), thus this costs O(log n + k) amortized, too.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be moved.
+	 * @param hi    Anything comparable to a node. All moved nodes are less than
+	 * <hi>.
+	 *
+	 * @return A new tree containing the nodes of the range
+	 */
+	template <class Comparable>
+	MyClass extract_range(const Comparable & lo, const Comparable & hi);
+
 	/**
 	 * @brief Removes all elements from the tree.
 	 *
@@ -310,19 +498,110 @@ public:
 	 */
 	bool empty() const;
 
+	/**
+	 * @brief Returns how many structural operations the tree has performed
+	 *
+	 * Counts rotations, rebuilds and comparisons since the tree was created or
+	 * reset_statistics() was called.
+	 *
+	 * @warning This method is only available if COLLECT_STATISTICS is set as
+	 * option!
+	 *
+	 * @return The counters of this tree
+	 */
+	stats::Counters get_statistics() const noexcept;
+
+	/**
+	 * @brief Resets all counters returned by get_statistics() to zero
+	 */
+	void reset_statistics() noexcept;
+
+	/**
+	 * @brief Computes the current shape of the tree
+	 *
+	 * This walks the whole tree and thus runs in O(n). It is available
+	 * regardless of COLLECT_STATISTICS.
+	 *
+	 * @return The depth histogram, average path length and maximum depth
+	 */
+	stats::Shape collect_shape() const;
+
 	void dbg_verify() const;
 	bool verify_integrity() const;
 
 private:
+	// State of a single-pass rebuild. For every level of the new subtree, we
+	// remember the last node that still waits for a parent (pending_left) and
+	// the last node that still waits for a right child (pending_right). If only
+	// a part of the subtree is relinked (see rebuild_collect_parallel), we also
+	// remember the nodes whose parent (missing_parent) or left child
+	// (missing_left) lie before that part.
+	struct RebuildState
+	{
+		Node * pending_left[sizeof(size_t) * 8];
+		Node * pending_right[sizeof(size_t) * 8];
+		Node * missing_parent[sizeof(size_t) * 8];
+		Node * missing_left[sizeof(size_t) * 8];
+		size_t counter;
+		size_t max_counter_bottom_level;
+		size_t bottom_level_size;
+		int tree_levels;
+
+		void reset_links();
+		size_t counter_before(size_t rank) const;
+	};
+
+	// Order statistics
+	template <class NodeT>
+	static NodeT * select_below(NodeT * node, size_t k);
+	template <class NodeT>
+	static NodeT * jump(NodeT * node, size_t steps, bool forward);
+	template <class Comparable>
+	size_t count_less(const Comparable & query) const;
+	template <class Comparable>
+	size_t count_not_greater(const Comparable & query) const;
+
+	// Range removal
+	template <class Comparable>
+	Node * unlink_range(const Comparable & lo, const Comparable & hi,
+	                    size_t & count);
+	static Node * flatten(Node * subtree, Node *& tail);
+
 	void rebuild_below(Node * node);
+	void rebuild_collect(Node * node, RebuildState & state);
+	void rebuild_place(Node * node, RebuildState & state);
+	void rebuild_collect_parallel(Node * node, size_t rank_offset,
+	                              RebuildState & state, int fork_depth);
+	void rebuild_merge(RebuildState & front, RebuildState & back);
+
+	// Incremental rebuilding
+	void schedule_rebuild(Node * node);
+	void rebuild_step();
+	size_t rebuild_partition(Node * node);
+	void rotate_up(Node * node);
 	Node * get_smallest() const;
 	Node * get_largest() const;
 
 	Node * root;
-	Compare cmp;
+	typename std::conditional<Options::collect_statistics,
+	                          stats::CountingCompare<Compare>, Compare>::type cmp;
+	// Empty unless incremental rebuilds are enabled. Keep it next to the (usually
+	// empty) comparator, where it takes no additional space.
+	energy_internal::RebuildQueue<Node, Options::etree_incremental_rebuild>
+	    rebuild_queue;
 	SizeHolder<Options::constant_time_size> s;
 
-	std::vector<Node *> rebuild_buffer;
+	using StatCounters = stats::CounterHolder<Options::collect_statistics>;
+	StatCounters &
+	stat_counters() noexcept
+	{
+		return *this;
+	}
+	const StatCounters &
+	stat_counters() const noexcept
+	{
+		return *this;
+	}
 
 	void dbg_verify_sizes() const;
 	void dbg_verify_energy() const;
@@ -0,0 +1,136 @@
+#ifndef YGG_EYTZINGER_CPP
+#define YGG_EYTZINGER_CPP
+
+#include "eytzinger.hpp"
+
+namespace ygg {
+
+template <class Node, class Key, class Compare>
+EytzingerSnapshot<Node, Key, Compare>::EytzingerSnapshot() noexcept : n(0)
+{}
+
+template <class Node, class Key, class Compare>
+template <class KeyExtractor>
+void
+EytzingerSnapshot<Node, Key, Compare>::place(const std::vector<Node *> & sorted,
+                                             size_t & next, size_t k)
+{
+	// The depth is logarithmic, thus recursing is fine
+	if (k > this->n) {
+		return;
+	}
+
+	this->place<KeyExtractor>(sorted, next, 2 * k);
+	this->keys[k] = KeyExtractor::get_key(*sorted[next]);
+	this->nodes[k] = sorted[next];
+	next++;
+	this->place<KeyExtractor>(sorted, next, 2 * k + 1);
+}
+
+template <class Node, class Key, class Compare>
+template <class KeyExtractor, class InputIterator>
+EytzingerSnapshot<Node, Key, Compare>
+EytzingerSnapshot<Node, Key, Compare>::from_sorted(InputIterator first,
+                                                   InputIterator last)
+{
+	std::vector<Node *> sorted;
+	for (; first != last; ++first) {
+		sorted.push_back(&*first);
+	}
+
+	MyClass snapshot;
+	snapshot.n = sorted.size();
+	snapshot.keys.resize(snapshot.n + 1);
+	snapshot.nodes.resize(snapshot.n + 1, nullptr);
+
+	size_t next = 0;
+	snapshot.template place<KeyExtractor>(sorted, next, 1);
+
+	return snapshot;
+}
+
+template <class Node, class Key, class Compare>
+template <bool upper, class Comparable>
+size_t
+EytzingerSnapshot<Node, Key, Compare>::bound(
+    const Comparable & query) const noexcept
+{
+	const Key * base = this->keys.data();
+	const size_t size = this->n;
+	Compare cmp;
+
+	size_t k = 1;
+	while (k <= size) {
+		__builtin_prefetch(base + std::min(KEYS_PER_LINE * k, size));
+		if constexpr (upper) {
+			k = 2 * k + static_cast<size_t>(!cmp(query, base[k]));
+		} else {
+			k = 2 * k + static_cast<size_t>(cmp(base[k], query));
+		}
+	}
+
+	/* The path went right (i.e., the key was too small) for every trailing 1
+	 * bit of k. The result is where the path last went left, i.e., cut off
+	 * those bits and the last 0 bit. */
+	k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+	return k;
+}
+
+template <class Node, class Key, class Compare>
+template <class Comparable>
+Node *
+EytzingerSnapshot<Node, Key, Compare>::lower_bound(
+    const Comparable & query) const noexcept
+{
+	if (this->n == 0) {
+		return nullptr;
+	}
+	return this->nodes[this->template bound<false>(query)];
+}
+
+template <class Node, class Key, class Compare>
+template <class Comparable>
+Node *
+EytzingerSnapshot<Node, Key, Compare>::upper_bound(
+    const Comparable & query) const noexcept
+{
+	if (this->n == 0) {
+		return nullptr;
+	}
+	return this->nodes[this->template bound<true>(query)];
+}
+
+template <class Node, class Key, class Compare>
+template <class Comparable>
+Node *
+EytzingerSnapshot<Node, Key, Compare>::find(
+    const Comparable & query) const noexcept
+{
+	if (this->n == 0) {
+		return nullptr;
+	}
+
+	size_t k = this->template bound<false>(query);
+	if ((k == 0) || Compare()(query, this->keys[k])) {
+		return nullptr;
+	}
+	return this->nodes[k];
+}
+
+template <class Node, class Key, class Compare>
+size_t
+EytzingerSnapshot<Node, Key, Compare>::size() const noexcept
+{
+	return this->n;
+}
+
+template <class Node, class Key, class Compare>
+bool
+EytzingerSnapshot<Node, Key, Compare>::empty() const noexcept
+{
+	return this->n == 0;
+}
+
+} // namespace ygg
+
+#endif // YGG_EYTZINGER_CPP
@@ -0,0 +1,126 @@
+#ifndef YGG_EYTZINGER_HPP
+#define YGG_EYTZINGER_HPP
+
+#include "util.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ygg {
+
+/**
+ * @brief An immutable, array-based copy of a search tree's order
+ *
+ * Stores pairs of keys and node pointers in Eytzinger order, i.e., in the
+ * breadth-first order of a perfectly balanced binary search tree: The children
+ * of the element at (1-based) index k are located at 2k and 2k+1. Searching
+ * thus walks through a single array without chasing any pointers. The search
+ * is branch-free and prefetches the keys that are needed a few levels further
+ * down, such that the memory accesses of consecutive levels overlap.
+ *
+ * A snapshot does not change when the tree it was created from is modified.
+ * It only stores pointers to the nodes, so the nodes must stay valid (and
+ * must not move in memory) while the snapshot is in use.
+ *
+ * Snapshots are usually created via BinarySearchTree::freeze_eytzinger().
+ *
+ * @tparam Node     The node class of the tree the snapshot was created from
+ * @tparam Key      The type of the keys stored in the snapshot
+ * @tparam Compare  A compare class for the keys. The default compares the keys
+ * with operator<.
+ */
+template <class Node, class Key, class Compare = ygg::utilities::flexible_less>
+class EytzingerSnapshot {
+public:
+	using MyClass = EytzingerSnapshot<Node, Key, Compare>;
+	using key_type = Key;
+
+	/**
+	 * @brief Creates an empty snapshot
+	 */
+	EytzingerSnapshot() noexcept;
+
+	/**
+	 * @brief Creates a snapshot from a sorted range of nodes
+	 *
+	 * @tparam KeyExtractor A class with a static method
+	 *
+	 * Key get_key(const Node &)
+	 *
+	 * which returns the key of a node.
+	 *
+	 * @param first An iterator to the smallest node
+	 * @param last  An iterator after the largest node
+	 * @returns A snapshot of all nodes in [first, last)
+	 */
+	template <class KeyExtractor, class InputIterator>
+	static MyClass from_sorted(InputIterator first, InputIterator last);
+
+	/**
+	 * @brief Finds an element in the snapshot
+	 *
+	 * @param query The key to be found. May be anything that can be compared to
+	 * Key using Compare.
+	 * @returns The first node whose key compares equally to <query>, or nullptr
+	 * if no such node exists
+	 */
+	template <class Comparable>
+	Node * find(const Comparable & query) const noexcept;
+
+	/**
+	 * @brief Lower-bounds an element
+	 *
+	 * @param query A key that should be lower-bounded
+	 * @returns The first node whose key is not less than <query>, or nullptr if
+	 * no such node exists
+	 */
+	template <class Comparable>
+	Node * lower_bound(const Comparable & query) const noexcept;
+
+	/**
+	 * @brief Upper-bounds an element
+	 *
+	 * @param query A key that should be upper-bounded
+	 * @returns The first node whose key is greater than <query>, or nullptr if
+	 * no such node exists
+	 */
+	template <class Comparable>
+	Node * upper_bound(const Comparable & query) const noexcept;
+
+	/**
+	 * @brief Returns the number of elements in the snapshot
+	 */
+	size_t size() const noexcept;
+
+	/**
+	 * @brief Returns whether the snapshot is empty
+	 */
+	bool empty() const noexcept;
+
+private:
+	// Number of keys per cache line. The descendants of index k that are
+	// log2(KEYS_PER_LINE) levels further down are stored consecutively, starting
+	// at index KEYS_PER_LINE * k. The search prefetches them.
+	constexpr static size_t KEYS_PER_LINE =
+	    std::max(size_t{1}, size_t{64} / sizeof(Key));
+
+	// Places sorted[next...] in the subtree rooted at index k
+	template <class KeyExtractor>
+	void place(const std::vector<Node *> & sorted, size_t & next, size_t k);
+
+	// Returns the (1-based) Eytzinger index of the bound, or 0 if there is none
+	template <bool upper, class Comparable>
+	size_t bound(const Comparable & query) const noexcept;
+
+	// Both are 1-based. keys[0] is unused, nodes[0] is nullptr.
+	std::vector<Key> keys;
+	std::vector<Node *> nodes;
+	size_t n;
+};
+
+} // namespace ygg
+
+#include "eytzinger.cpp"
+
+#endif // YGG_EYTZINGER_HPP
@@ -198,28 +198,124 @@ typename IntervalTree<Node, NodeTraits, Options,
                       Tag>::template QueryResult<Comparable>
 IntervalTree<Node, NodeTraits, Options, Tag>::query(const Comparable & q) const
 {
+	Node * hit =
+	    intervaltree_internal::find_first_in_window<Node, INB, NodeTraits>(
+	        this->root, NodeTraits::get_lower(q), NodeTraits::get_upper(q));
+
+	return QueryResult<Comparable>(hit, q);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag>
+template <class Comparable>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, intervaltree_internal::QueryKind::ENCLOSING>
+IntervalTree<Node, NodeTraits, Options, Tag>::query_enclosing(
+    const Comparable & q) const
+{
+	// An interval [l, u] encloses q iff l <= lower(q) and u >= upper(q). That is
+	// the same window as for an overlap query with the query bounds swapped.
+	Node * hit =
+	    intervaltree_internal::find_first_in_window<Node, INB, NodeTraits>(
+	        this->root, NodeTraits::get_upper(q), NodeTraits::get_lower(q));
+
+	return QueryResult<Comparable, QueryKind::ENCLOSING>(hit, q);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag>
+template <class Comparable>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, intervaltree_internal::QueryKind::CONTAINED>
+IntervalTree<Node, NodeTraits, Options, Tag>::query_contained(
+    const Comparable & q) const
+{
+	const auto q_lower = NodeTraits::get_lower(q);
+	const auto q_upper = NodeTraits::get_upper(q);
+
+	// Lower-bound search on the lower interval bounds. Every interval before the
+	// result starts before q and can therefore not be contained in q.
 	Node * cur = this->root;
-	if (this->root == nullptr) {
-		return QueryResult<Comparable>(nullptr, q);
+	Node * hit = nullptr;
+	while (cur != nullptr) {
+		if (NodeTraits::get_lower(*cur) < q_lower) {
+			cur = cur->get_right();
+		} else {
+			hit = cur;
+			cur = cur->get_left();
+		}
 	}
 
-	while ((cur->get_left() != nullptr) &&
-	       (cur->get_left()->INB::_it_max_upper >= NodeTraits::get_lower(q))) {
-		cur = cur->get_left();
+	if ((hit != nullptr) && (q_upper < NodeTraits::get_upper(*hit))) {
+		hit = intervaltree_internal::find_next_hit<
+		    Node, INB, NodeTraits, QueryKind::CONTAINED, Comparable>(hit, q);
 	}
 
-	Node * hit;
-	// If this overlaps, this is our first hit. otherwise, find the next one
-	if ((NodeTraits::get_lower(q) <= NodeTraits::get_upper(*cur)) &&
-	    (NodeTraits::get_upper(q) >= NodeTraits::get_lower(*cur))) {
-		hit = cur;
-	} else {
-		hit =
-		    intervaltree_internal::find_next_overlapping<Node, INB, NodeTraits,
-		                                                 false, Comparable>(cur, q);
+	return QueryResult<Comparable, QueryKind::CONTAINED>(hit, q);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag>
+typename IntervalTree<Node, NodeTraits, Options,
+                      Tag>::BaseTree::template const_iterator<false>
+IntervalTree<Node, NodeTraits, Options, Tag>::nearest(const Key & point) const
+{
+	// Step 1: Among all intervals starting at or before <point>, find the one
+	// reaching furthest to the right. While descending, we only remember the
+	// best node or the best left subtree. Also, the last node at which we go
+	// left is the first interval starting after <point>.
+	Node * cur = this->root;
+	Node * best = nullptr;
+	bool best_is_subtree = false;
+	Node * right_neighbor = nullptr;
+
+	auto best_upper = [&]() {
+		return best_is_subtree ? best->INB::_it_max_upper
+		                       : NodeTraits::get_upper(*best);
+	};
+
+	while (cur != nullptr) {
+		if (point < NodeTraits::get_lower(*cur)) {
+			right_neighbor = cur;
+			cur = cur->get_left();
+		} else {
+			Node * left = cur->get_left();
+			if ((left != nullptr) &&
+			    ((best == nullptr) || (best_upper() < left->INB::_it_max_upper))) {
+				best = left;
+				best_is_subtree = true;
+			}
+			if ((best == nullptr) || (best_upper() < NodeTraits::get_upper(*cur))) {
+				best = cur;
+				best_is_subtree = false;
+			}
+			cur = cur->get_right();
+		}
 	}
 
-	return QueryResult<Comparable>(hit, q);
+	// Step 2: Find the node within the best subtree that realizes the maximum
+	if (best_is_subtree) {
+		const auto maximum = best->INB::_it_max_upper;
+		while (!(NodeTraits::get_upper(*best) == maximum)) {
+			if ((best->get_left() != nullptr) &&
+			    (best->get_left()->INB::_it_max_upper == maximum)) {
+				best = best->get_left();
+			} else {
+				best = best->get_right();
+			}
+		}
+	}
+
+	// Step 3: Either <best> contains <point>, or one of the two candidates is
+	// closest.
+	if (best == nullptr) {
+		return typename BaseTree::template const_iterator<false>(right_neighbor);
+	}
+	if (!(NodeTraits::get_upper(*best) < point) || (right_neighbor == nullptr)) {
+		return typename BaseTree::template const_iterator<false>(best);
+	}
+	if ((NodeTraits::get_lower(*right_neighbor) - point) <
+	    (point - NodeTraits::get_upper(*best))) {
+		return typename BaseTree::template const_iterator<false>(right_neighbor);
+	}
+	return typename BaseTree::template const_iterator<false>(best);
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
@@ -381,6 +477,43 @@ template <class Node, class INB, class NodeTraits, bool skipfirst,
           class Comparable>
 Node *
 find_next_overlapping(Node * cur, const Comparable & q)
+{
+	return find_next_in_window<Node, INB, NodeTraits>(
+	    cur, NodeTraits::get_lower(q), NodeTraits::get_upper(q));
+}
+
+template <class Node, class INB, class NodeTraits>
+Node *
+find_first_in_window(Node * root,
+                     const typename NodeTraits::key_type & min_upper,
+                     const typename NodeTraits::key_type & max_lower)
+{
+	if (root == nullptr) {
+		return nullptr;
+	}
+
+	// Everything left of cur will end before min_upper
+	Node * cur = root;
+	while ((cur->get_left() != nullptr) &&
+	       (cur->get_left()->INB::_it_max_upper >= min_upper)) {
+		cur = cur->get_left();
+	}
+
+	// If this is in the window, this is our first hit. otherwise, find the next
+	// one
+	if ((min_upper <= NodeTraits::get_upper(*cur)) &&
+	    (max_lower >= NodeTraits::get_lower(*cur))) {
+		return cur;
+	} else {
+		return find_next_in_window<Node, INB, NodeTraits>(cur, min_upper,
+		                                                  max_lower);
+	}
+}
+
+template <class Node, class INB, class NodeTraits>
+Node *
+find_next_in_window(Node * cur, const typename NodeTraits::key_type & min_upper,
+                    const typename NodeTraits::key_type & max_lower)
 {
 	// We search for the next bigger node, pruning the search as necessary. When
 	// Pruning occurs, we need to restart the search for the next larger node.
@@ -392,7 +525,7 @@ find_next_overlapping(Node * cur, const Comparable & q)
 		if (cur->get_right() != nullptr) {
 			// go to smallest larger-or-equal child
 			cur = cur->get_right();
-			if (cur->INB::_it_max_upper < NodeTraits::get_lower(q)) {
+			if (cur->INB::_it_max_upper < min_upper) {
 				// Prune!
 				// Nothing starting from this node can overlap b/c of upper limit.
 				// Backtrack.
@@ -414,7 +547,7 @@ find_next_overlapping(Node * cur, const Comparable & q)
 			} else {
 				while (cur->get_left() != nullptr) {
 					cur = cur->get_left();
-					if (cur->INB::_it_max_upper < NodeTraits::get_lower(q)) {
+					if (cur->INB::_it_max_upper < min_upper) {
 						// Prune!
 						// Nothing starting from this node can overlap. Backtrack.
 						cur = cur->get_parent();
@@ -442,12 +575,12 @@ find_next_overlapping(Node * cur, const Comparable & q)
 			}
 		}
 
-		if (NodeTraits::get_lower(*cur) > NodeTraits::get_upper(q)) {
+		if (NodeTraits::get_lower(*cur) > max_lower) {
 			// No larger node can be an overlap!
 			return nullptr;
 		}
 
-		if (NodeTraits::get_upper(*cur) >= NodeTraits::get_lower(q)) {
+		if (NodeTraits::get_upper(*cur) >= min_upper) {
 			// Found!
 			return cur;
 		}
@@ -455,67 +588,92 @@ find_next_overlapping(Node * cur, const Comparable & q)
 	} while (true);
 }
 
+template <class Node, class INB, class NodeTraits, QueryKind kind,
+          class Comparable>
+Node *
+find_next_hit(Node * cur, const Comparable & q)
+{
+	if constexpr (kind == QueryKind::OVERLAP) {
+		return find_next_overlapping<Node, INB, NodeTraits, false, Comparable>(cur,
+		                                                                      q);
+	} else if constexpr (kind == QueryKind::ENCLOSING) {
+		return find_next_in_window<Node, INB, NodeTraits>(
+		    cur, NodeTraits::get_upper(q), NodeTraits::get_lower(q));
+	} else {
+		// We started at the first interval not starting before q. Thus, we only
+		// need to skip the intervals that reach beyond q.
+		do {
+			cur = find_next_in_window<Node, INB, NodeTraits>(
+			    cur, NodeTraits::get_lower(q), NodeTraits::get_upper(q));
+		} while ((cur != nullptr) &&
+		         (NodeTraits::get_upper(q) < NodeTraits::get_upper(*cur)));
+
+		return cur;
+	}
+}
+
 } // namespace intervaltree_internal
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::QueryResult(Node * n_in,
-                                                        const Comparable & q_in)
+             Tag>::QueryResult<Comparable, kind>::QueryResult(Node * n_in,
+                                                              const Comparable &
+                                                                  q_in)
     : n(n_in), q(q_in)
 {}
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-typename IntervalTree<Node, NodeTraits, Options,
-                      Tag>::template QueryResult<Comparable>::const_iterator
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::begin()
-    const
+template <class Comparable, intervaltree_internal::QueryKind kind>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, kind>::const_iterator
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable,
+                                                          kind>::begin() const
 {
 	return const_iterator(this->n, this->q);
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-typename IntervalTree<Node, NodeTraits, Options,
-                      Tag>::template QueryResult<Comparable>::const_iterator
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::end()
-    const
+template <class Comparable, intervaltree_internal::QueryKind kind>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, kind>::const_iterator
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable,
+                                                          kind>::end() const
 {
 	return const_iterator(nullptr, this->q);
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
-    Comparable>::const_iterator::const_iterator(Node * n_in,
-                                                const Comparable & q_in)
+    Comparable, kind>::const_iterator::const_iterator(Node * n_in,
+                                                      const Comparable & q_in)
     : n(n_in), q(q_in)
 {}
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
+template <class Comparable, intervaltree_internal::QueryKind kind>
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable, kind>::
     const_iterator::const_iterator(
         const typename IntervalTree<Node, NodeTraits, Options, Tag>::
-            template QueryResult<Comparable>::const_iterator & other)
+            template QueryResult<Comparable, kind>::const_iterator & other)
     : n(other.n), q(other.q)
 {}
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::const_iterator::~const_iterator()
+template <class Comparable, intervaltree_internal::QueryKind kind>
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
+    Comparable, kind>::const_iterator::~const_iterator()
 {}
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-typename IntervalTree<Node, NodeTraits, Options,
-                      Tag>::template QueryResult<Comparable>::const_iterator &
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
+template <class Comparable, intervaltree_internal::QueryKind kind>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, kind>::const_iterator &
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable, kind>::
     const_iterator::operator=(
         const typename IntervalTree<Node, NodeTraits, Options, Tag>::
-            template QueryResult<Comparable>::const_iterator & other)
+            template QueryResult<Comparable, kind>::const_iterator & other)
 {
 	this->n = other.n;
 	this->q = other.q;
@@ -523,12 +681,13 @@ IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 bool
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable, kind>::
     const_iterator::operator==(
         const typename IntervalTree<Node, NodeTraits, Options, Tag>::
-            template QueryResult<Comparable>::const_iterator & other) const
+            template QueryResult<Comparable, kind>::const_iterator & other)
+        const
 {
 	return ((this->n == other.n) &&
 	        (NodeTraits::get_lower(this->q) == NodeTraits::get_lower(other.q)) &&
@@ -536,39 +695,39 @@ IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 bool
-IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable>::
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<Comparable, kind>::
     const_iterator::operator!=(
         const typename IntervalTree<Node, NodeTraits, Options, Tag>::
-            template QueryResult<Comparable>::const_iterator & other) const
+            template QueryResult<Comparable, kind>::const_iterator & other)
+        const
 {
 	return !(*this == other);
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-typename IntervalTree<Node, NodeTraits, Options,
-                      Tag>::template QueryResult<Comparable>::const_iterator &
-IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::const_iterator::operator++()
+template <class Comparable, intervaltree_internal::QueryKind kind>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, kind>::const_iterator &
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
+    Comparable, kind>::const_iterator::operator++()
 {
-	this->n = intervaltree_internal::find_next_overlapping<Node, INB, NodeTraits,
-	                                                       false, Comparable>(
-	    this->n, this->q);
+	this->n = intervaltree_internal::find_next_hit<Node, INB, NodeTraits, kind,
+	                                               Comparable>(this->n, this->q);
 
 	return *this;
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
-typename IntervalTree<Node, NodeTraits, Options,
-                      Tag>::template QueryResult<Comparable>::const_iterator
-IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::const_iterator::operator++(int)
+template <class Comparable, intervaltree_internal::QueryKind kind>
+typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
+    Comparable, kind>::const_iterator
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
+    Comparable, kind>::const_iterator::operator++(int)
 {
 	typename IntervalTree<Node, NodeTraits, Options, Tag>::template QueryResult<
-	    Comparable>::const_iterator cpy(*this);
+	    Comparable, kind>::const_iterator cpy(*this);
 
 	this->operator++();
 
@@ -576,19 +735,19 @@ IntervalTree<Node, NodeTraits, Options,
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 const Node &
-IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::const_iterator::operator*() const
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
+    Comparable, kind>::const_iterator::operator*() const
 {
 	return *(this->n);
 }
 
 template <class Node, class NodeTraits, class Options, class Tag>
-template <class Comparable>
+template <class Comparable, intervaltree_internal::QueryKind kind>
 const Node *
-IntervalTree<Node, NodeTraits, Options,
-             Tag>::QueryResult<Comparable>::const_iterator::operator->() const
+IntervalTree<Node, NodeTraits, Options, Tag>::QueryResult<
+    Comparable, kind>::const_iterator::operator->() const
 {
 	return this->n;
 }
@@ -9,10 +9,38 @@
 
 namespace ygg {
 namespace intervaltree_internal {
+/**
+ * @brief The relation between a query and the intervals reported for it
+ *
+ * OVERLAP reports all intervals overlapping the query, ENCLOSING reports all
+ * intervals fully containing the query and CONTAINED reports all intervals
+ * that lie completely within the query.
+ */
+enum class QueryKind : unsigned char
+{
+	OVERLAP = 0,
+	ENCLOSING = 1,
+	CONTAINED = 2
+};
+
 template <class Node, class INB, class NodeTraits, bool skipfirst,
           class Comparable>
 Node * find_next_overlapping(Node * cur, const Comparable & q);
 
+template <class Node, class INB, class NodeTraits>
+Node * find_first_in_window(Node * root,
+                            const typename NodeTraits::key_type & min_upper,
+                            const typename NodeTraits::key_type & max_lower);
+
+template <class Node, class INB, class NodeTraits>
+Node * find_next_in_window(Node * cur,
+                           const typename NodeTraits::key_type & min_upper,
+                           const typename NodeTraits::key_type & max_lower);
+
+template <class Node, class INB, class NodeTraits, QueryKind kind,
+          class Comparable>
+Node * find_next_hit(Node * cur, const Comparable & q);
+
 template <class KeyType>
 class DummyRange : public std::pair<KeyType, KeyType> {
 public:
@@ -160,8 +188,10 @@ public:
 	using BaseTree::insert;
 	using BaseTree::remove;
 
+	using QueryKind = intervaltree_internal::QueryKind;
+
 	// Iteration of sets of intervals
-	template <class Comparable>
+	template <class Comparable, QueryKind kind = QueryKind::OVERLAP>
 	class QueryResult {
 	public:
 		class const_iterator {
@@ -221,6 +251,63 @@ public:
 	template <class Comparable>
 	QueryResult<Comparable> query(const Comparable & q) const;
 
+	/**
+	 * @brief Queries intervals that fully contain a query interval
+	 *
+	 * This method queries for all intervals [l, u] in the tree for which
+	 * l <= get_lower(q) and get_upper(q) <= u holds. See query() for the
+	 * requirements on q.
+	 *
+	 * Subtrees in which no interval reaches get_upper(q) are pruned, and the
+	 * search stops at the first interval starting after get_lower(q). Thus, only
+	 * intervals which start before q and reach the end of q are ever visited.
+	 *
+	 * @param q Anything that is comparable (i.e., has get_lower() and get_upper()
+	 * methods in NodeTraits) to an interval
+	 * @result A QueryResult holding all intervals in the tree that contain q
+	 */
+	template <class Comparable>
+	QueryResult<Comparable, QueryKind::ENCLOSING>
+	query_enclosing(const Comparable & q) const;
+
+	/**
+	 * @brief Queries intervals that lie completely within a query interval
+	 *
+	 * This method queries for all intervals [l, u] in the tree for which
+	 * get_lower(q) <= l and u <= get_upper(q) holds. See query() for the
+	 * requirements on q.
+	 *
+	 * The first candidate is found by a lower-bound search on the lower interval
+	 * bounds in O(log n). After that, only intervals starting within q are
+	 * visited, i.e., this runs in O(log n + m), with m being the number of
+	 * intervals that start within q.
+	 *
+	 * @param q Anything that is comparable (i.e., has get_lower() and get_upper()
+	 * methods in NodeTraits) to an interval
+	 * @result A QueryResult holding all intervals in the tree that are contained
+	 * in q
+	 */
+	template <class Comparable>
+	QueryResult<Comparable, QueryKind::CONTAINED>
+	query_contained(const Comparable & q) const;
+
+	/**
+	 * @brief Finds the interval closest to a point
+	 *
+	 * Returns an interval that has minimal distance to <point>. If any interval
+	 * contains <point>, one of those intervals is returned. Otherwise, the
+	 * distance of an interval [l, u] to <point> is either (point - u) or
+	 * (l - point). Thus, Key must support subtraction for this method.
+	 *
+	 * This method runs in O(log n).
+	 *
+	 * @param point The point to which the closest interval should be found
+	 * @result An iterator pointing to the closest interval, or end() if the tree
+	 * is empty
+	 */
+	typename BaseTree::template const_iterator<false>
+	nearest(const Key & point) const;
+
 	/**
 	 * @brief Checks if a specified interval is contained in the interval tree
 	 *
@@ -228,6 +228,182 @@ List<Node, Options, Tag>::remove(Node * n)
   }
 }
 
+template <class Node, class Options, class Tag>
+void
+List<Node, Options, Tag>::unlink_range(Node * first, Node * last_inclusive)
+{
+  if (last_inclusive->NB::_l_next != nullptr) {
+    last_inclusive->NB::_l_next->NB::_l_prev = first->NB::_l_prev;
+  } else {
+    this->tail = first->NB::_l_prev;
+  }
+
+  if (first->NB::_l_prev != nullptr) {
+    first->NB::_l_prev->NB::_l_next = last_inclusive->NB::_l_next;
+  } else {
+    this->head = last_inclusive->NB::_l_next;
+  }
+}
+
+template <class Node, class Options, class Tag>
+void
+List<Node, Options, Tag>::link_range(Node * next, Node * first,
+                                     Node * last_inclusive)
+{
+  Node * prev;
+  if (next != nullptr) {
+    prev = next->NB::_l_prev;
+    next->NB::_l_prev = last_inclusive;
+  } else {
+    prev = this->tail;
+    this->tail = last_inclusive;
+  }
+
+  if (prev != nullptr) {
+    prev->NB::_l_next = first;
+  } else {
+    this->head = first;
+  }
+
+  first->NB::_l_prev = prev;
+  last_inclusive->NB::_l_next = next;
+}
+
+template <class Node, class Options, class Tag>
+size_t
+List<Node, Options, Tag>::count_range(Node * first, Node * last)
+{
+  size_t count = 0;
+  while (first != last) {
+    count++;
+    first = first->NB::_l_next;
+  }
+  return count;
+}
+
+template <class Node, class Options, class Tag>
+void
+List<Node, Options, Tag>::remove_range(Node * first, Node * last)
+{
+  if (first == last) {
+    return;
+  }
+
+  if constexpr (Options::constant_time_size) {
+    this->s.reduce(count_range(first, last));
+  }
+
+  Node * last_inclusive = (last != nullptr) ? last->NB::_l_prev : this->tail;
+  this->unlink_range(first, last_inclusive);
+}
+
+template <class Node, class Options, class Tag>
+void
+List<Node, Options, Tag>::splice(Node * next, List<Node, Options, Tag> & other,
+                                 Node * first, Node * last)
+{
+  if (first == last) {
+    return;
+  }
+
+  if constexpr (Options::constant_time_size) {
+    if (&other != this) {
+      size_t count;
+      if ((first == other.head) && (last == nullptr)) {
+        count = other.size();
+      } else {
+        count = count_range(first, last);
+      }
+      other.s.reduce(count);
+      this->s.add(count);
+    }
+  }
+
+  Node * last_inclusive = (last != nullptr) ? last->NB::_l_prev : other.tail;
+  other.unlink_range(first, last_inclusive);
+  this->link_range(next, first, last_inclusive);
+}
+
+template <class Node, class Options, class Tag>
+void
+List<Node, Options, Tag>::splice(Node * next, List<Node, Options, Tag> & other)
+{
+  if (other.empty()) {
+    return;
+  }
+
+  if constexpr (Options::constant_time_size) {
+    this->s.add(other.s.get());
+  }
+
+  this->link_range(next, other.head, other.tail);
+  other.clear();
+}
+
+template <class Node, class Options, class Tag>
+template <class Compare>
+void
+List<Node, Options, Tag>::sort(Compare cmp)
+{
+  if (this->head == nullptr) {
+    return;
+  }
+
+  /* Bottom-up merge sort: In every pass, merge adjacent runs of length
+   * run_length into runs of twice that length. The _l_prev pointers are
+   * rebuilt while appending to the result. */
+  for (size_t run_length = 1;; run_length *= 2) {
+    Node * p = this->head;
+    Node * new_tail = nullptr;
+    size_t merges = 0;
+
+    this->head = nullptr;
+
+    while (p != nullptr) {
+      merges++;
+
+      Node * q = p;
+      size_t p_size = 0;
+      while ((p_size < run_length) && (q != nullptr)) {
+        p_size++;
+        q = q->NB::_l_next;
+      }
+      size_t q_size = run_length;
+
+      while ((p_size > 0) || ((q_size > 0) && (q != nullptr))) {
+        Node * e;
+        // Take from p on ties to keep the sort stable
+        if ((p_size == 0) || ((q_size > 0) && (q != nullptr) && cmp(*q, *p))) {
+          e = q;
+          q = q->NB::_l_next;
+          q_size--;
+        } else {
+          e = p;
+          p = p->NB::_l_next;
+          p_size--;
+        }
+
+        if (new_tail != nullptr) {
+          new_tail->NB::_l_next = e;
+        } else {
+          this->head = e;
+        }
+        e->NB::_l_prev = new_tail;
+        new_tail = e;
+      }
+
+      p = q;
+    }
+
+    new_tail->NB::_l_next = nullptr;
+    this->tail = new_tail;
+
+    if (merges <= 1) {
+      return;
+    }
+  }
+}
+
 template <class Node, class Options, class Tag>
 typename List<Node, Options, Tag>::iterator
 List<Node, Options, Tag>::begin()
@@ -139,6 +139,64 @@ public:
    */
   void remove(Node * n);
 
+  /**
+   * @brief Remove a range of nodes from the list.
+   *
+   * Removes all nodes from first (inclusive) to last (exclusive) from the
+   * list. The relinking runs in O(1). If CONSTANT_TIME_SIZE is set, the
+   * removed nodes must be counted, which takes O(k) for k removed nodes.
+   *
+   * @param first 	The first node to be removed.
+   * @param last 	The node after the last node to be removed. Set to
+   * nullptr to remove everything up to the end of the list.
+   */
+  void remove_range(Node * first, Node * last);
+
+  /**
+   * @brief Move a range of nodes from another list into this list
+   *
+   * Moves all nodes from first (inclusive) to last (exclusive) out of other
+   * and inserts them right before next, keeping their order. other may be
+   * this list, as long as next is not part of the range. The relinking runs in
+   * O(1). If CONSTANT_TIME_SIZE is set and other is not this list, the moved
+   * nodes must be counted, which takes O(k) for k moved nodes unless the
+   * whole of other is moved.
+   *
+   * @param next 	The node that the range should be inserted before. Set
+   * to nullptr to insert at the end of the list.
+   * @param other 	The list the nodes are taken from.
+   * @param first 	The first node to be moved.
+   * @param last 	The node after the last node to be moved. Set to nullptr
+   * to move everything up to the end of other.
+   */
+  void splice(Node * next, List<Node, Options, Tag> & other, Node * first,
+              Node * last);
+  /**
+   * @brief Move all nodes from another list into this list
+   *
+   * Moves all nodes of other right before next. Runs in O(1).
+   *
+   * @param next 	The node that the nodes should be inserted before. Set
+   * to nullptr to insert at the end of the list.
+   * @param other 	The list the nodes are taken from. Must not be this
+   * list.
+   */
+  void splice(Node * next, List<Node, Options, Tag> & other);
+
+  /**
+   * @brief Sorts the list
+   *
+   * Sorts the list in ascending order with a bottom-up merge sort. The sort is
+   * stable, runs in O(n log n) and does not allocate any memory.
+   *
+   * @tparam Compare 	The comparator to use. The default
+   * ygg::utilities::flexible_less requires operator< to be implemented for
+   * Node.
+   * @param cmp 		An instance of Compare.
+   */
+  template <class Compare = ygg::utilities::flexible_less>
+  void sort(Compare cmp = Compare());
+
   /**
    * Returns an iterator pointing to the first element in the list.
    *
@@ -203,6 +261,12 @@ private:
   Node * head;
   Node * tail;
 
+  // Unlinks [first, last_inclusive] without touching the size
+  void unlink_range(Node * first, Node * last_inclusive);
+  // Links [first, last_inclusive] before next without touching the size
+  void link_range(Node * next, Node * first, Node * last_inclusive);
+  static size_t count_range(Node * first, Node * last);
+
   SizeHolder<Options::constant_time_size> s;
 };
 
@@ -0,0 +1,359 @@
+#ifndef YGG_NODE_POOL_CPP
+#define YGG_NODE_POOL_CPP
+
+#include "node_pool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ygg {
+
+namespace pool_internal {
+
+#ifdef __linux__
+inline void
+bind_to_numa_node(void * addr, size_t size, int numa_node) noexcept
+{
+	constexpr int MPOL_BIND_MODE = 2; // MPOL_BIND from <numaif.h>
+	constexpr size_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+	constexpr size_t MASK_WORDS = 16;
+
+	if ((numa_node < 0) ||
+	    (static_cast<size_t>(numa_node) >= MASK_WORDS * BITS_PER_WORD)) {
+		return;
+	}
+
+	unsigned long mask[MASK_WORDS] = {};
+	mask[static_cast<size_t>(numa_node) / BITS_PER_WORD] =
+	    1ul << (static_cast<size_t>(numa_node) % BITS_PER_WORD);
+
+	// Best effort: If binding fails, the memory is still usable.
+	// The kernel expects the number of bits in the mask plus one.
+	(void)syscall(SYS_mbind, addr, size, MPOL_BIND_MODE, mask,
+	              MASK_WORDS * BITS_PER_WORD + 1, 0);
+}
+#endif
+
+inline void *
+map_slab(size_t size, bool huge_pages, int numa_node) noexcept
+{
+#ifdef __linux__
+	char * slab = nullptr;
+
+#ifdef MAP_HUGETLB
+	if (huge_pages) {
+		// Explicit huge pages. Only usable if the mapping happens to be aligned.
+		void * mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+		                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (mapped != MAP_FAILED) {
+			if ((reinterpret_cast<uintptr_t>(mapped) & (size - 1)) == 0) {
+				slab = static_cast<char *>(mapped);
+			} else {
+				munmap(mapped, size);
+			}
+		}
+	}
+#endif
+
+	if (slab == nullptr) {
+		// Map twice the size and trim to an aligned slab
+		void * mapped = mmap(nullptr, 2 * size, PROT_READ | PROT_WRITE,
+		                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapped == MAP_FAILED) {
+			return nullptr;
+		}
+
+		char * start = static_cast<char *>(mapped);
+		uintptr_t misalignment = reinterpret_cast<uintptr_t>(start) & (size - 1);
+		size_t head = (misalignment == 0) ? 0 : (size - misalignment);
+
+		slab = start + head;
+		if (head > 0) {
+			munmap(start, head);
+		}
+		munmap(slab + size, size - head);
+
+#ifdef MADV_HUGEPAGE
+		if (huge_pages) {
+			madvise(slab, size, MADV_HUGEPAGE);
+		}
+#endif
+	}
+
+	// Must happen before the memory is touched for the first time
+	bind_to_numa_node(slab, size, numa_node);
+
+	return slab;
+#else
+	(void)huge_pages;
+	(void)numa_node;
+	return std::aligned_alloc(size, size);
+#endif
+}
+
+inline void
+unmap_slab(void * slab, size_t size) noexcept
+{
+#ifdef __linux__
+	munmap(slab, size);
+#else
+	(void)size;
+	std::free(slab);
+#endif
+}
+
+} // namespace pool_internal
+
+/*
+ * ThreadCache
+ */
+template <class Node, class Options>
+NodePool<Node, Options>::ThreadCache::ThreadCache(MyClass * pool_in)
+    : pool(pool_in), sorted(true)
+{
+	// Never holds more, thus deallocate() never allocates
+	this->slots.reserve(2 * BATCH_SIZE);
+}
+
+template <class Node, class Options>
+NodePool<Node, Options>::ThreadCache::ThreadCache(ThreadCache && other) noexcept
+    : pool(other.pool), slots(std::move(other.slots)), sorted(other.sorted)
+{
+	other.pool = nullptr;
+	other.slots.clear();
+}
+
+template <class Node, class Options>
+NodePool<Node, Options>::ThreadCache::~ThreadCache()
+{
+	if (this->pool != nullptr) {
+		this->flush();
+	}
+}
+
+template <class Node, class Options>
+void *
+NodePool<Node, Options>::ThreadCache::take_slot()
+{
+	if (this->slots.empty()) {
+		this->pool->refill(this->slots, BATCH_SIZE);
+		this->sorted = false;
+	}
+
+	if (!this->sorted) {
+		std::sort(this->slots.begin(), this->slots.end(), std::greater<void *>());
+		this->sorted = true;
+	}
+
+	void * slot = this->slots.back();
+	this->slots.pop_back();
+	return slot;
+}
+
+template <class Node, class Options>
+template <class... Args>
+Node *
+NodePool<Node, Options>::ThreadCache::allocate(Args &&... args)
+{
+	void * slot = this->take_slot();
+
+	try {
+		return new (slot) Node(std::forward<Args>(args)...);
+	} catch (...) {
+		// This was the lowest slot, thus the cache stays sorted
+		this->slots.push_back(slot);
+		throw;
+	}
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::ThreadCache::deallocate(Node * node) noexcept
+{
+	node->~Node();
+
+	void * slot = static_cast<void *>(node);
+	if (!this->slots.empty() &&
+	    std::greater<void *>()(slot, this->slots.back())) {
+		this->sorted = false;
+	}
+	this->slots.push_back(slot);
+
+	if (this->slots.size() >= 2 * BATCH_SIZE) {
+		// Keep the lowest addresses, return the highest ones
+		if (!this->sorted) {
+			std::sort(this->slots.begin(), this->slots.end(),
+			          std::greater<void *>());
+			this->sorted = true;
+		}
+		this->pool->give_back(this->slots.data(),
+		                      this->slots.data() + BATCH_SIZE);
+		auto batch_end = this->slots.begin() + static_cast<ptrdiff_t>(BATCH_SIZE);
+		this->slots.erase(this->slots.begin(), batch_end);
+	}
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::ThreadCache::flush() noexcept
+{
+	this->pool->give_back(this->slots.data(),
+	                      this->slots.data() + this->slots.size());
+	this->slots.clear();
+	this->sorted = true;
+}
+
+/*
+ * NodePool
+ */
+template <class Node, class Options>
+NodePool<Node, Options>::NodePool(int numa_node_in) noexcept
+    : numa_node(numa_node_in), slabs(nullptr), slab_count(0), fresh(nullptr),
+      fresh_end(nullptr)
+{}
+
+template <class Node, class Options>
+NodePool<Node, Options>::~NodePool()
+{
+	pool_internal::SlabHeader * slab = this->slabs;
+	while (slab != nullptr) {
+		pool_internal::SlabHeader * next = slab->next;
+		pool_internal::unmap_slab(slab, SLAB_SIZE);
+		slab = next;
+	}
+}
+
+template <class Node, class Options>
+typename NodePool<Node, Options>::ThreadCache
+NodePool<Node, Options>::register_thread()
+{
+	return ThreadCache(this);
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::add_slab()
+{
+	// Every slot of the new slab might be freed at the same time
+	this->slots.reserve((this->slab_count + 1) * SLOTS_PER_SLAB);
+
+	void * memory = pool_internal::map_slab(SLAB_SIZE, Options::pool_huge_pages,
+	                                        this->numa_node);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	auto * header = static_cast<pool_internal::SlabHeader *>(memory);
+	header->pool = this;
+	header->next = this->slabs;
+	this->slabs = header;
+	this->slab_count++;
+
+	this->fresh = static_cast<char *>(memory) + FIRST_SLOT_OFFSET;
+	this->fresh_end = this->fresh + SLOTS_PER_SLAB * sizeof(Node);
+}
+
+template <class Node, class Options>
+void *
+NodePool<Node, Options>::take_slot_locked()
+{
+	if (!this->slots.empty()) {
+		// std::greater makes this a min-heap
+		std::pop_heap(this->slots.begin(), this->slots.end(),
+		              std::greater<void *>());
+		void * slot = this->slots.back();
+		this->slots.pop_back();
+		return slot;
+	}
+
+	if (this->fresh == this->fresh_end) {
+		this->add_slab();
+	}
+
+	void * slot = this->fresh;
+	this->fresh += sizeof(Node);
+	return slot;
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::refill(std::vector<void *> & target, size_t count)
+{
+	std::lock_guard<std::mutex> lock(this->m);
+
+	for (size_t i = 0; i < count; ++i) {
+		target.push_back(this->take_slot_locked());
+	}
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::give_back(void * const * first,
+                                   void * const * last) noexcept
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	for (; first != last; ++first) {
+		// Does not allocate, see add_slab()
+		this->slots.push_back(*first);
+		std::push_heap(this->slots.begin(), this->slots.end(),
+		               std::greater<void *>());
+	}
+}
+
+template <class Node, class Options>
+template <class... Args>
+Node *
+NodePool<Node, Options>::allocate(Args &&... args)
+{
+	void * slot;
+	{
+		std::lock_guard<std::mutex> lock(this->m);
+		slot = this->take_slot_locked();
+	}
+
+	try {
+		return new (slot) Node(std::forward<Args>(args)...);
+	} catch (...) {
+		this->give_back(&slot, &slot + 1);
+		throw;
+	}
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::deallocate(Node * node) noexcept
+{
+	node->~Node();
+	void * slot = static_cast<void *>(node);
+	this->give_back(&slot, &slot + 1);
+}
+
+template <class Node, class Options>
+void
+NodePool<Node, Options>::release(Node * node) noexcept
+{
+	auto * header = reinterpret_cast<pool_internal::SlabHeader *>(
+	    reinterpret_cast<uintptr_t>(node) & ~(SLAB_SIZE - 1));
+	static_cast<MyClass *>(header->pool)->deallocate(node);
+}
+
+template <class Node, class Options>
+size_t
+NodePool<Node, Options>::capacity() const noexcept
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	return this->slab_count * SLOTS_PER_SLAB;
+}
+
+} // namespace ygg
+
+#endif // YGG_NODE_POOL_CPP
@@ -0,0 +1,236 @@
+#ifndef YGG_NODE_POOL_HPP
+#define YGG_NODE_POOL_HPP
+
+#include "options.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ygg {
+
+namespace pool_internal {
+/// @cond INTERNAL
+
+/*
+ * Placed at the start of every slab. Since slabs are aligned to their size,
+ * the pool a node belongs to can be found from the node's address.
+ */
+struct SlabHeader
+{
+	void * pool;
+	SlabHeader * next;
+};
+
+// Returns nullptr if no memory could be mapped
+inline void * map_slab(size_t size, bool huge_pages, int numa_node) noexcept;
+inline void unmap_slab(void * slab, size_t size) noexcept;
+
+/// @endcond
+} // namespace pool_internal
+
+/**
+ * @brief A slab allocator for intrusive nodes
+ *
+ * Since all data structures in this library are intrusive, they never
+ * allocate memory. NodePool can be used to allocate the nodes instead of
+ * allocating every node separately.
+ *
+ * Nodes are carved from large slabs, which are aligned to their size (see
+ * TreeFlags::POOL_SLAB_SIZE) and can be backed by huge pages (see
+ * TreeFlags::POOL_HUGE_PAGES). If a NUMA node is given at construction, the
+ * slabs' memory is bound to that node.
+ *
+ * Allocation is address-ordered: Slots are carved from a slab in increasing
+ * address order, and among the slots that have been freed, the one with the
+ * lowest address is reused first. Thus, nodes allocated one after the other
+ * (e.g., when inserting nodes in key order) end up physically adjacent, and
+ * freed memory is compacted towards the start of the slabs.
+ *
+ * The pool itself is protected by a mutex. Threads that allocate and free
+ * many nodes should register via register_thread() and use the returned
+ * ThreadCache, which keeps a small private free list and only accesses the
+ * pool in batches.
+ *
+ * The pool only provides memory, and nodes allocated from it can be used with
+ * any tree and any NodeTraits. To free nodes reported by ConcurrentZTree as
+ * reclaimable, use PoolReclaimingNodeTraits.
+ *
+ * Destroying the pool releases all its slabs. Nodes that have not been freed
+ * at that point are not destructed, and all ThreadCaches of the pool must have
+ * been destroyed before.
+ *
+ * @tparam Node     The node class to be allocated
+ * @tparam Options  The TreeOptions class specifying the parameters of the
+ * pool. See TreeFlags::POOL_HUGE_PAGES and TreeFlags::POOL_SLAB_SIZE.
+ */
+template <class Node, class Options = DefaultOptions>
+class NodePool {
+public:
+	using MyClass = NodePool<Node, Options>;
+
+	/**
+	 * @brief A thread's private free list
+	 *
+	 * Must only be used by a single thread at a time.
+	 */
+	class ThreadCache {
+	public:
+		ThreadCache(ThreadCache && other) noexcept;
+		ThreadCache(const ThreadCache & other) = delete;
+		~ThreadCache();
+
+		/**
+		 * @brief Allocates and constructs a node
+		 *
+		 * @param args The arguments passed to the constructor of Node
+		 * @return The new node
+		 */
+		template <class... Args>
+		Node * allocate(Args &&... args);
+
+		/**
+		 * @brief Destructs and frees a node
+		 *
+		 * The node must have been allocated from the same pool, but not
+		 * necessarily via this cache.
+		 *
+		 * @param node The node to be freed
+		 */
+		void deallocate(Node * node) noexcept;
+
+		/**
+		 * @brief Returns all cached free slots to the pool
+		 */
+		void flush() noexcept;
+
+	private:
+		friend class NodePool;
+		explicit ThreadCache(MyClass * pool);
+
+		void * take_slot();
+
+		MyClass * pool;
+		// Sorted by descending address if 'sorted' is set
+		std::vector<void *> slots;
+		bool sorted;
+	};
+
+	/**
+	 * @brief Creates a new, empty pool
+	 *
+	 * @param numa_node The NUMA node to bind the memory of the pool to, or -1
+	 * to not bind it. Binding is best-effort and only has an effect on Linux.
+	 */
+	explicit NodePool(int numa_node = -1) noexcept;
+	NodePool(const MyClass & other) = delete;
+	MyClass & operator=(const MyClass & other) = delete;
+	~NodePool();
+
+	/**
+	 * @brief Creates a private free list for the calling thread
+	 *
+	 * Throws std::bad_alloc if the free list cannot be allocated.
+	 *
+	 * @return A cache that allocates from this pool
+	 */
+	ThreadCache register_thread();
+
+	/**
+	 * @brief Allocates and constructs a node
+	 *
+	 * Throws std::bad_alloc if no memory can be obtained.
+	 *
+	 * @param args The arguments passed to the constructor of Node
+	 * @return The new node
+	 */
+	template <class... Args>
+	Node * allocate(Args &&... args);
+
+	/**
+	 * @brief Destructs and frees a node
+	 *
+	 * @param node The node to be freed. Must have been allocated from this pool.
+	 */
+	void deallocate(Node * node) noexcept;
+
+	/**
+	 * @brief Destructs and frees a node, returning it to the pool it was
+	 * allocated from
+	 *
+	 * @param node The node to be freed. Must have been allocated from any
+	 * NodePool of this type.
+	 */
+	static void release(Node * node) noexcept;
+
+	/**
+	 * @brief Returns the number of nodes that fit into the slabs allocated so
+	 * far
+	 */
+	size_t capacity() const noexcept;
+
+private:
+	constexpr static size_t SLAB_SIZE = Options::pool_slab_size;
+	constexpr static size_t FIRST_SLOT_OFFSET =
+	    ((sizeof(pool_internal::SlabHeader) + alignof(Node) - 1) /
+	     alignof(Node)) *
+	    alignof(Node);
+	constexpr static size_t SLOTS_PER_SLAB =
+	    (SLAB_SIZE - FIRST_SLOT_OFFSET) / sizeof(Node);
+	// Number of slots moved between a ThreadCache and the pool at once
+	constexpr static size_t BATCH_SIZE = 64;
+
+	static_assert((SLAB_SIZE & (SLAB_SIZE - 1)) == 0,
+	              "POOL_SLAB_SIZE must be a power of two.");
+	static_assert(SLOTS_PER_SLAB > 0, "POOL_SLAB_SIZE is too small for Node.");
+
+	// All of these expect the mutex to be held
+	void * take_slot_locked();
+	void add_slab();
+
+	void refill(std::vector<void *> & target, size_t count);
+	void give_back(void * const * first, void * const * last) noexcept;
+
+	mutable std::mutex m;
+	int numa_node;
+
+	pool_internal::SlabHeader * slabs;
+	size_t slab_count;
+	// The part of the newest slab that has never been handed out
+	char * fresh;
+	char * fresh_end;
+
+	/* Freed slots, as a min-heap on the address. Taking the lowest address and
+	 * returning a slot thus cost O(log n). The capacity always suffices for all
+	 * slots of all slabs, such that returning slots never allocates. */
+	std::vector<void *> slots;
+};
+
+/**
+ * @brief NodeTraits that free reclaimable nodes via their NodePool
+ *
+ * Use this as NodeTraits for a ConcurrentZTree whose nodes have been
+ * allocated from a NodePool. Every node that the tree reports as reclaimable
+ * is destructed and returned to the pool it was allocated from.
+ *
+ * @tparam Pool        The NodePool class the nodes are allocated from
+ * @tparam BaseTraits  The NodeTraits to use otherwise, e.g.,
+ * ConcurrentZTreeDefaultNodeTraits
+ */
+template <class Pool, class BaseTraits>
+class PoolReclaimingNodeTraits : public BaseTraits {
+public:
+	template <class Node>
+	void
+	reclaimable(Node * node) const noexcept
+	{
+		Pool::release(node);
+	}
+};
+
+} // namespace ygg
+
+#include "node_pool.cpp"
+
+#endif // YGG_NODE_POOL_HPP
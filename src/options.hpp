@@ -58,6 +58,35 @@ public:
 	class ORDER_QUERIES {
 	};
 
+	/**
+	 * @brief Search Tree option: Cache integral keys inside the nodes
+	 *
+	 * If this option is set, RBTree, WBTree and ZTree store a copy of every
+	 * node's key right next to its child pointers. Searches that compare nodes
+	 * against a key (or against another node) then only access the cached keys,
+	 * and never the remainder of the nodes. This pays off if your nodes carry a
+	 * large payload, which otherwise causes a cache miss for every comparison.
+	 *
+	 * The key is extracted once, when a node is inserted. Thus, the key of a
+	 * node must not change while it is in the tree.
+	 *
+	 * @warning The order induced by the extracted keys must be the order induced
+	 * by the Compare class of the tree, i.e., Compare(a, b) must hold if and
+	 * only if get_key(a) < get_key(b) holds.
+	 *
+	 * @tparam KeyExtractor A class with a member type key_type, which must be an
+	 * integral type, and a static method
+	 *
+	 * key_type get_key(const Node &)
+	 *
+	 * which returns the key of a node.
+	 */
+	template <class KeyExtractor>
+	class BST_CACHED_KEY {
+	public:
+		using type = KeyExtractor;
+	};
+
 	/**
 	 * @brief RBTree / List option: support size() in O(1)
 	 *
@@ -79,6 +108,16 @@ public:
 	class STL_ERASE {
 	};
 
+	/**
+	 * @brief Collect statistics about the trees' structural operations
+	 *
+	 * If this flag is set, the trees count rotations, zips, unzips, rebuilds and
+	 * comparisons, which can be retrieved via get_statistics(). If it is not
+	 * set, nothing is counted and the trees do not grow.
+	 */
+	class COLLECT_STATISTICS {
+	};
+
 	/**
 	 * @brief RBTree option: Indicates that color information should be compressed
 	 * into the parent pointer
@@ -90,6 +129,27 @@ public:
 	class COMPRESS_COLOR {
 	};
 
+	/**
+	 * @brief RBTree option: Rebalance red-black trees using the top-down instead
+	 * of the bottom-up algorithm
+	 *
+	 * Setting this option causes insert() and remove() of the red-black tree to
+	 * rebalance the tree on the way down: Insertion splits nodes with two red
+	 * children as it descends, removal pushes a red node down along the search
+	 * path. Both thus never walk back up the tree, and every ancestor is
+	 * modified while it is still in the cache. On the other hand, the top-down
+	 * algorithms perform more color changes and rotations than necessary.
+	 *
+	 * Note that the bottom-up removal starts at the node to be removed and
+	 * usually only touches a few nodes above it, while the top-down removal
+	 * must descend all the way from the root. Thus, this option usually speeds
+	 * up insertions, but slows down removals.
+	 *
+	 * Hinted insertions and insert_near() still use the bottom-up algorithm.
+	 */
+	class RBT_SINGLE_PASS {
+	};
+
 	/**
 	 * @brief Zip Tree Option: Indicates that nodes' ranks should be derived from
 	 * a std::hash hash of the node.
@@ -198,6 +258,27 @@ public:
 		constexpr static size_t value = modul_in;
 	};
 
+	/**
+	 * @brief Zip Tree Option: Mix hash values before deriving ranks from them.
+	 *
+	 * Ranks are derived from the number of trailing zeroes of the (possibly
+	 * universalized) hash value of a node. This requires the lowest bits of the
+	 * hash values to be well distributed, which is not true for many hash
+	 * functions (e.g., std::hash on integers is the identity, and addresses are
+	 * aligned). Setting this option folds each hash value to 32 bits and applies
+	 * a fast, branch-free mixer to it (the finalizer of MurmurHash3, two 32 bit
+	 * multiplications) before the trailing zeroes are counted. Ranks are thus
+	 * at most 32. This is cheap enough to be evaluated during every comparison,
+	 * so you can usually skip storing the ranks (i.e., not set
+	 * ZTREE_RANK_TYPE). If you do store them, ZTree::update_ranks() computes
+	 * them for many nodes at once in a vectorized loop.
+	 *
+	 * See also ZTreeAddressHasher, which lets you derive ranks from the nodes'
+	 * addresses.
+	 */
+	class ZTREE_RANK_HASH_MIX {
+	};
+
 	/**
 	 * @brief Weight Balanced Tree Option: Sets the numerator of the Delta balance
 	 * parameter
@@ -293,6 +374,109 @@ public:
 	class ITREE_FAST_FIND {
 	};
 
+	/**
+	 * @brief Energy Tree Option: Rebuild large subtrees in parallel
+	 *
+	 * If this option is set, the Energy Tree rebuilds subtrees of at least
+	 * <threshold> nodes using a fork-join algorithm, in which the left and right
+	 * parts of the subtree are relinked by different threads. Smaller subtrees
+	 * are always rebuilt sequentially.
+	 *
+	 * Note that during a parallel rebuild, no other thread may access the tree,
+	 * just as with any other modifying operation.
+	 *
+	 * @tparam threshold The minimum subtree size to be rebuilt in parallel
+	 */
+	template <size_t threshold>
+	class ETREE_PARALLEL_REBUILD {
+	public:
+		constexpr static size_t value = threshold;
+	};
+
+	/**
+	 * @brief Energy Tree Option: Number of threads for parallel rebuilds
+	 *
+	 * Only has an effect together with ETREE_PARALLEL_REBUILD. A parallel
+	 * rebuild forks until at least <threads> threads work on the subtree. If
+	 * this option is not set, the number of hardware threads is used.
+	 *
+	 * @tparam threads The number of threads to rebuild a subtree with
+	 */
+	template <size_t threads>
+	class ETREE_PARALLEL_REBUILD_THREADS {
+	public:
+		constexpr static size_t value = threads;
+	};
+
+	/**
+	 * @brief Energy Tree Option: Rebuild large subtrees incrementally
+	 *
+	 * By default, the Energy Tree rebuilds a subtree as soon as its energy
+	 * exceeds the threshold, which makes single operations very expensive if the
+	 * subtree is large. If this option is set, subtrees of more than <budget>
+	 * nodes are instead scheduled for rebuilding. Every subsequent insert() and
+	 * remove() then performs at most (roughly) <budget> nodes worth of
+	 * rebuilding work, bounding the worst-case latency of a single operation
+	 * instead of amortizing it.
+	 *
+	 * The scheduled work rebalances subtrees by rotating their median to the
+	 * top, which in total is more expensive than rebuilding the subtree in one
+	 * go. The tree is a valid search tree at all times.
+	 *
+	 * @tparam budget The maximum number of nodes to rebuild per operation
+	 */
+	template <size_t budget>
+	class ETREE_INCREMENTAL_REBUILD {
+	public:
+		constexpr static size_t value = budget;
+	};
+
+	/******************************************************
+	 * Node Pool Options
+	 ******************************************************/
+	/**
+	 * @brief Node Pool Option: Back the slabs of a NodePool with huge pages
+	 *
+	 * If this option is set, NodePool first tries to allocate its slabs from the
+	 * explicitly reserved huge pages (MAP_HUGETLB). If none are available, it
+	 * falls back to normal pages and advises the kernel to use transparent huge
+	 * pages for them. Only has an effect on Linux.
+	 */
+	class POOL_HUGE_PAGES {
+	};
+
+	/**
+	 * @brief Node Pool Option: Sets the size of the slabs of a NodePool
+	 *
+	 * Nodes are allocated from slabs of this many bytes, which are aligned to
+	 * their size. The default is 2 MiB, i.e., the size of a huge page on x86-64.
+	 *
+	 * @tparam bytes The size of a slab. Must be a power of two.
+	 */
+	template <size_t bytes>
+	class POOL_SLAB_SIZE {
+	public:
+		constexpr static size_t value = bytes;
+	};
+
+	/******************************************************
+	 * B-Tree Index Options
+	 ******************************************************/
+	/**
+	 * @brief B-Tree Index Option: Sets the number of keys per node
+	 *
+	 * Every inner node and every leaf of a BTreeIndex holds up to this many keys.
+	 * Values between 16 and 64 usually work best, such that a node spans a few
+	 * cache lines. The default is 32.
+	 *
+	 * @tparam keys The maximum number of keys per node. Must be at least 4.
+	 */
+	template <size_t keys>
+	class BTREE_NODE_KEYS {
+	public:
+		constexpr static size_t value = keys;
+	};
+
 	/******************************************************
 	 * Micro-Optimization Options
 	 ******************************************************/
@@ -329,6 +513,14 @@ public:
 	public:
 		using type = Callback;
 	};
+	/**
+	 * @brief Calls a callback whenever a tree node's pointer is read
+	 *
+	 * Callback must provide the static methods get_left(), get_right() and
+	 * get_parent(). If these methods take a const void * instead, they are
+	 * passed the address of the node whose pointer is being read, which allows
+	 * e.g. to count the distinct cache lines touched by an operation.
+	 */
 	template <class Callback>
 	class BENCHMARK_POINTER_GET_CALLBACK {
 	public:
@@ -470,6 +662,19 @@ private:
 		}
 	}
 
+	constexpr static bool
+	compute_pointer_get_callback_takes_node()
+	{
+		using T = typename utilities::get_type_if_present<
+		    TreeFlags::BENCHMARK_POINTER_GET_CALLBACK, void, Opts...>::type;
+
+		if constexpr (!std::is_same_v<T, void>) {
+			return std::is_invocable_v<decltype(&T::type::get_left), const void *>;
+		} else {
+			return false;
+		}
+	}
+
 	template <class Node>
 	constexpr static auto
 	compute_ztree_hasher_type()
@@ -507,10 +712,19 @@ public:
 	    OptPack::template has<TreeFlags::CONSTANT_TIME_SIZE>();
 	static constexpr bool compress_color =
 	    OptPack::template has<TreeFlags::COMPRESS_COLOR>();
+	static constexpr bool rbt_single_pass =
+	    OptPack::template has<TreeFlags::RBT_SINGLE_PASS>();
 	static constexpr bool ztree_use_hash =
 	    OptPack::template has<TreeFlags::ZTREE_USE_HASH>();
 	static constexpr bool stl_erase =
 	    OptPack::template has<TreeFlags::STL_ERASE>();
+	static constexpr bool collect_statistics =
+	    OptPack::template has<TreeFlags::COLLECT_STATISTICS>();
+	using bst_cached_key =
+	    typename utilities::get_type_if_present<TreeFlags::BST_CACHED_KEY, void,
+	                                            Opts...>::type;
+	static constexpr bool bst_cache_key =
+	    !std::is_same<bst_cached_key, void>::value;
 	using ztree_rank_type =
 	    typename utilities::get_type_if_present<TreeFlags::ZTREE_RANK_TYPE, void,
 	                                            Opts...>::type;
@@ -533,6 +747,9 @@ public:
 	         TreeFlags::ZTREE_RANK_HASH_UNIVERSALIZE_COEFFICIENT,
 	         Opts...>::found);
 
+	static constexpr bool ztree_rank_hash_mix =
+	    OptPack::template has<TreeFlags::ZTREE_RANK_HASH_MIX>();
+
 	static constexpr bool ztree_store_rank =
 	    !std::is_same<ztree_rank_type, void>::value;
 
@@ -650,6 +867,40 @@ public:
 	static constexpr bool itree_fast_find =
 	    OptPack::template has<TreeFlags::ITREE_FAST_FIND>();
 
+	static constexpr size_t etree_parallel_rebuild_threshold =
+	    utilities::get_value_if_present_else_default<
+	        TreeFlags::ETREE_PARALLEL_REBUILD, 0, Opts...>::value;
+	static constexpr bool etree_parallel_rebuild =
+	    utilities::get_value_if_present<TreeFlags::ETREE_PARALLEL_REBUILD,
+	                                    Opts...>::found;
+	static constexpr size_t etree_parallel_rebuild_threads =
+	    utilities::get_value_if_present_else_default<
+	        TreeFlags::ETREE_PARALLEL_REBUILD_THREADS, 0, Opts...>::value;
+
+	static constexpr size_t etree_incremental_rebuild_budget =
+	    utilities::get_value_if_present_else_default<
+	        TreeFlags::ETREE_INCREMENTAL_REBUILD, 0, Opts...>::value;
+	static constexpr bool etree_incremental_rebuild =
+	    utilities::get_value_if_present<TreeFlags::ETREE_INCREMENTAL_REBUILD,
+	                                    Opts...>::found;
+
+	/**********************************************
+	 * Node Pool
+	 **********************************************/
+	static constexpr bool pool_huge_pages =
+	    OptPack::template has<TreeFlags::POOL_HUGE_PAGES>();
+	static constexpr size_t pool_slab_size =
+	    utilities::get_value_if_present_else_default<TreeFlags::POOL_SLAB_SIZE,
+	                                                 (size_t{1} << 21),
+	                                                 Opts...>::value;
+
+	/**********************************************
+	 * B-Tree Index
+	 **********************************************/
+	static constexpr size_t btree_node_keys =
+	    utilities::get_value_if_present_else_default<TreeFlags::BTREE_NODE_KEYS,
+	                                                 32, Opts...>::value;
+
 	/**********************************************
 	 * Micro-Optimization
 	 **********************************************/
@@ -671,6 +922,8 @@ public:
 	    typename decltype(compute_pointer_get_callback_type())::type;
 	static constexpr bool has_pointer_get_callback =
 	    compute_has_pointer_get_callback();
+	static constexpr bool pointer_get_callback_takes_node =
+	    compute_pointer_get_callback_takes_node();
 
 	static_assert(!(has_pointer_get_callback && micro_avoid_conditionals),
 	              "MICRO_AVOID_CONDITIONALS and BENCHMARK_POINTER_GET_CALLBACK "
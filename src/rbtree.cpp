@@ -313,11 +313,96 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::insert_leaf_base(Node & node,
 	return;
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::insert_leaf_onepass(
+    Node & node) CMP_NOEXCEPT(node)
+{
+	node.NB::set_right(nullptr);
+	node.NB::set_left(nullptr);
+
+	if (this->root == nullptr) {
+		node.NB::set_parent(nullptr);
+		node.NB::make_black();
+		this->root = &node;
+		NodeTraits::leaf_inserted(node, *this);
+		return;
+	}
+
+	Node * cur = this->root;
+	bool go_right;
+
+	while (true) {
+		if constexpr (Options::micro_prefetch) {
+			__builtin_prefetch(cur->NB::get_left());
+			__builtin_prefetch(cur->NB::get_right());
+		}
+
+		/* Split every node with two red children on the way down. Afterwards, the
+		 * uncle of a red-red violation is always black, thus a single (or double)
+		 * rotation resolves it and nothing ever propagates upwards. */
+		Node * left = cur->NB::get_left();
+		Node * right = cur->NB::get_right();
+		if ((left != nullptr) && (right != nullptr) &&
+		    (left->NB::get_color() == rbtree_internal::Color::RED) &&
+		    (right->NB::get_color() == rbtree_internal::Color::RED)) {
+			left->NB::make_black();
+			right->NB::make_black();
+
+			Node * parent = cur->NB::get_parent();
+			// The root stays black
+			if (parent != nullptr) {
+				cur->NB::make_red();
+				if (parent->NB::get_color() == rbtree_internal::Color::RED) {
+					// Might change the children of cur
+					this->rotate_red_violation(cur);
+				}
+			}
+		}
+
+		if constexpr (Options::multiple) {
+			go_right = this->cmp(*cur, node);
+		} else {
+			if (this->cmp(*cur, node)) {
+				go_right = true;
+			} else if (this->cmp(node, *cur)) {
+				go_right = false;
+			} else {
+				// Same as existing. Reduce size (because we increased it earlier)
+				// and exit. The tree is valid after every split.
+				this->s.reduce(1);
+				return;
+			}
+		}
+
+		Node * next = go_right ? cur->NB::get_right() : cur->NB::get_left();
+		if (next == nullptr) {
+			break;
+		}
+		cur = next;
+	}
+
+	node.NB::set_parent(cur);
+	node.NB::make_red();
+	if (go_right) {
+		cur->NB::set_right(&node);
+	} else {
+		cur->NB::set_left(&node);
+	}
+	NodeTraits::leaf_inserted(node, *this);
+
+	if (cur->NB::get_color() == rbtree_internal::Color::RED) {
+		this->rotate_red_violation(&node);
+	}
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
 void
 RBTree<Node, NodeTraits, Options, Tag, Compare>::rotate_left(
     Node * parent) noexcept
 {
+	this->stat_counters().count_rotation();
+
 	Node * right_child = parent->NB::get_right();
 	parent->NB::set_right(right_child->NB::get_left());
 	if (right_child->NB::get_left() != nullptr) {
@@ -349,6 +434,8 @@ void
 RBTree<Node, NodeTraits, Options, Tag, Compare>::rotate_right(
     Node * parent) noexcept
 {
+	this->stat_counters().count_rotation();
+
 	Node * left_child = parent->NB::get_left();
 	parent->NB::set_left(left_child->NB::get_right());
 
@@ -415,6 +502,14 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::fixup_after_insert(
 		return;
 	}
 
+	this->rotate_red_violation(node);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::rotate_red_violation(
+    Node * node) noexcept
+{
 	Node * parent = node->NB::get_parent();
 	Node * grandparent = parent->NB::get_parent();
 
@@ -455,7 +550,12 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::insert(Node & node)
 #endif
 	// TODO merge this
 	this->s.add(1);
-	this->insert_leaf_base(node, this->root);
+	this->cache_key(node);
+	if constexpr (Options::rbt_single_pass) {
+		this->insert_leaf_onepass(node);
+	} else {
+		this->insert_leaf_base(node, this->root);
+	}
 }
 
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
@@ -469,6 +569,7 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::insert(Node & node,
 	                          Options::SequenceInterface::get_key(node));
 #endif
 	this->s.add(1);
+	this->cache_key(node);
 
 	/* TODO this code does not work. We need to traverse the path up until
 	 * we have seen at least one smaller-than and one larger-than node.
@@ -545,7 +646,7 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::insert(Node & node,
 
 	if (parent->NB::get_left() != nullptr) {
 	  parent = parent->NB::get_left();
-	  this->insert_leaf_base<false>(node, parent);
+	  this->insert_leaf_base(node, parent);
 	} else {
 	  this->insert_leaf_base<true>(node, parent);
 	}
@@ -559,29 +660,54 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::insert(
     RBTree<Node, NodeTraits, Options, Tag, Compare>::iterator<false> hint)
     CMP_NOEXCEPT(node)
 {
+	if (hint == this->end()) {
 #ifdef YGG_STORE_SEQUENCE
-	this->bss.register_insert(reinterpret_cast<const void *>(&node),
-	                          Options::SequenceInterface::get_key(node));
+		this->bss.register_insert(reinterpret_cast<const void *>(&node),
+		                          Options::SequenceInterface::get_key(node));
 #endif
-	this->s.add(1);
+		this->s.add(1);
+		this->cache_key(node);
 
-	if (hint == this->end()) {
 		// special case: insert at the end
 		Node * parent = this->root;
 
 		if (parent == nullptr) {
-			this->insert_leaf_base<false>(node, parent);
+			this->insert_leaf_base(node, parent);
 		} else {
 			while (parent->NB::get_right() != nullptr) {
 				parent = parent->NB::get_right();
 			}
-			this->insert_leaf_base<false>(node, parent);
+			this->insert_leaf_base(node, parent);
 		}
 	} else {
 		this->insert(node, *hint);
 	}
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::insert_near(
+    Node & node,
+    RBTree<Node, NodeTraits, Options, Tag, Compare>::iterator<false> finger)
+    CMP_NOEXCEPT(node)
+{
+	if (finger == this->end()) {
+		this->insert(node);
+		return;
+	}
+
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
+	this->s.add(1);
+	this->cache_key(node);
+
+	Node * upper;
+	Node * anchor = this->climb_from_finger(&*finger, node, upper);
+	this->insert_leaf_base(node, anchor);
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
 void
 RBTree<Node, NodeTraits, Options, Tag, Compare>::verify_black_root() const
@@ -909,7 +1035,7 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::erase(const Comparable & c)
 			size_t count = 1;
 
 			auto next = el + 1;
-			this->remove_to_leaf(*el);
+			this->remove_base(*el);
 			if (Options::multiple) {
 				el = next;
 
@@ -919,7 +1045,7 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::erase(const Comparable & c)
 				                        false)) {
 					count++;
 					next = el + 1;
-					this->remove_to_leaf(*el);
+					this->remove_base(*el);
 					el = next;
 				}
 			} else {
@@ -928,7 +1054,7 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::erase(const Comparable & c)
 			this->s.reduce(count);
 			return count;
 		} else {
-			this->remove_to_leaf(*el);
+			this->remove_base(*el);
 			this->s.reduce(1);
 			return &(*el);
 		}
@@ -967,6 +1093,84 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::erase(
 	}
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable, class Callback>
+size_t
+RBTree<Node, NodeTraits, Options, Tag, Compare>::erase_range(
+    const Comparable & lo, const Comparable & hi, Callback callback)
+{
+	decltype(auto) hi_key = this->search_key(hi);
+	auto it = this->lower_bound(lo);
+	size_t count = 0;
+
+	while ((it != this->end()) && this->cmp(*it, hi_key)) {
+		Node & node = *it;
+		++it;
+
+#ifdef YGG_STORE_SEQUENCE
+		this->bss.register_delete(reinterpret_cast<const void *>(&node),
+		                          Options::SequenceInterface::get_key(node));
+#endif
+		// Always bottom-up: A top-down removal (RBT_SINGLE_PASS) would descend
+		// from the root again for every node.
+		this->remove_to_leaf(node);
+		this->s.reduce(1);
+		count++;
+		callback(node);
+	}
+
+	return count;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+RBTree<Node, NodeTraits, Options, Tag, Compare>::erase_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	return this->erase_range(lo, hi, [](Node &) {});
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+typename RBTree<Node, NodeTraits, Options, Tag, Compare>::MyClass
+RBTree<Node, NodeTraits, Options, Tag, Compare>::extract_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	MyClass extracted;
+	Node * largest = nullptr;
+
+	this->erase_range(lo, hi, [&](Node & node) {
+		extracted.append_leaf(node, largest);
+		largest = &node;
+	});
+
+	return extracted;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::append_leaf(
+    Node & node, Node * largest) noexcept
+{
+	this->s.add(1);
+
+	node.NB::set_right(nullptr);
+	node.NB::set_left(nullptr);
+	node.NB::set_parent(largest);
+
+	if (largest == nullptr) {
+		node.NB::make_black();
+		this->root = &node;
+		NodeTraits::leaf_inserted(node, *this);
+	} else {
+		node.NB::make_red();
+		largest->NB::set_right(&node);
+		NodeTraits::leaf_inserted(node, *this);
+		this->fixup_after_insert(&node);
+	}
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
 void
 RBTree<Node, NodeTraits, Options, Tag, Compare>::fixup_after_delete(
@@ -1082,6 +1286,149 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::fixup_after_delete(
 	}
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::remove_onepass(Node & node)
+    CMP_NOEXCEPT(node)
+{
+	auto is_red = [](const Node * n) {
+		return (n != nullptr) &&
+		       (n->NB::get_color() == rbtree_internal::Color::RED);
+	};
+	// Rotates n's child opposite to <right> up, moving n towards <right>
+	auto rotate_towards = [&](Node * n, bool right) {
+		if (right) {
+			this->rotate_right(n);
+		} else {
+			this->rotate_left(n);
+		}
+	};
+
+	/* With equal keys, comparisons cannot tell the way from the root to <node>.
+	 * In that case, we record it by walking up from <node>. A red-black tree
+	 * holding less than 2^64 nodes is at most 128 levels deep. The rotations
+	 * below only ever change the tree above or beside the current node, so the
+	 * recorded way stays valid. */
+	constexpr size_t MAX_DEPTH = 2 * 8 * sizeof(size_t);
+	bool way_right[MAX_DEPTH];
+	size_t step = MAX_DEPTH;
+	if constexpr (Options::multiple) {
+		for (Node * cur = &node; cur->NB::get_parent() != nullptr;
+		     cur = cur->NB::get_parent()) {
+			way_right[--step] = (cur->NB::get_parent()->NB::get_right() == cur);
+		}
+	} else {
+		(void)way_right;
+		(void)step;
+	}
+
+	// The node that is actually unlinked: <node> itself or its successor
+	Node * victim = &node;
+	if ((node.NB::get_left() != nullptr) && (node.NB::get_right() != nullptr)) {
+		victim = node.NB::get_right();
+		while (victim->NB::get_left() != nullptr) {
+			victim = victim->NB::get_left();
+		}
+	}
+
+	/* Descend towards victim, making sure that every node we step to is red
+	 * (or the root). Then, the victim can be unlinked without any fixup. */
+	Node * cur = this->root;
+	bool below_node = false;
+	while (true) {
+		bool right;
+		if (cur == victim) {
+			// Towards the missing child
+			right = (victim->NB::get_left() != nullptr);
+		} else if (cur == &node) {
+			right = true;
+		} else if (below_node) {
+			right = false;
+		} else {
+			if constexpr (Options::multiple) {
+				right = way_right[step++];
+			} else {
+				right = this->cmp(*cur, node);
+			}
+		}
+
+		Node * child = right ? cur->NB::get_right() : cur->NB::get_left();
+		Node * other = right ? cur->NB::get_left() : cur->NB::get_right();
+
+		if (!is_red(cur) && !is_red(child)) {
+			if (is_red(other)) {
+				// Make cur red by rotating its red child up
+				rotate_towards(cur, right);
+				other->NB::make_black();
+				cur->NB::make_red();
+			} else if (cur->NB::get_parent() != nullptr) {
+				// The parent is red (or the root), the sibling must exist
+				Node * parent = cur->NB::get_parent();
+				bool last_right = (parent->NB::get_right() == cur);
+				Node * sibling =
+				    last_right ? parent->NB::get_left() : parent->NB::get_right();
+				Node * sibling_outer =
+				    last_right ? sibling->NB::get_left() : sibling->NB::get_right();
+				Node * sibling_inner =
+				    last_right ? sibling->NB::get_right() : sibling->NB::get_left();
+
+				if (!is_red(sibling_outer) && !is_red(sibling_inner)) {
+					// Color flip
+					parent->NB::make_black();
+					sibling->NB::make_red();
+					cur->NB::make_red();
+				} else {
+					if (is_red(sibling_inner)) {
+						rotate_towards(sibling, !last_right);
+					}
+					rotate_towards(parent, last_right);
+
+					Node * top = parent->NB::get_parent();
+					cur->NB::make_red();
+					top->NB::make_red();
+					top->NB::get_left()->NB::make_black();
+					top->NB::get_right()->NB::make_black();
+				}
+			}
+		}
+
+		if (cur == victim) {
+			break;
+		}
+		below_node |= (cur == &node);
+		cur = right ? cur->NB::get_right() : cur->NB::get_left();
+	}
+
+	if (victim != &node) {
+		this->swap_nodes(&node, victim, false);
+	}
+
+	// Now, node is red and thus a leaf - unless it is the root, which may have a
+	// single (red) child. Move that child up.
+	Node * child = (node.NB::get_left() != nullptr) ? node.NB::get_left()
+	                                                : node.NB::get_right();
+	if (child != nullptr) {
+		this->swap_nodes(&node, child, true);
+	}
+
+	NodeTraits::delete_leaf(node, *this);
+	Node * parent = node.NB::get_parent();
+	if (parent != nullptr) {
+		if (parent->NB::get_left() == &node) {
+			parent->NB::set_left(nullptr);
+		} else {
+			parent->NB::set_right(nullptr);
+		}
+		NodeTraits::deleted_below(*parent, *this);
+	} else {
+		this->root = nullptr;
+	}
+
+	if (this->root != nullptr) {
+		this->root->NB::make_black();
+	}
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
 void
 RBTree<Node, NodeTraits, Options, Tag, Compare>::remove(Node & node)
@@ -1092,10 +1439,22 @@ RBTree<Node, NodeTraits, Options, Tag, Compare>::remove(Node & node)
 	                          Options::SequenceInterface::get_key(node));
 #endif
 
-	this->remove_to_leaf(node);
+	this->remove_base(node);
 	this->s.reduce(1);
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+RBTree<Node, NodeTraits, Options, Tag, Compare>::remove_base(Node & node)
+    CMP_NOEXCEPT(node)
+{
+	if constexpr (Options::rbt_single_pass) {
+		this->remove_onepass(node);
+	} else {
+		this->remove_to_leaf(node);
+	}
+}
+
 } // namespace ygg
 
 #endif // YGG_RBTREE_CPP
@@ -251,6 +251,21 @@ public:
 	// TODO document hinted inserts
 	// TODO should order be preserved on hints?
 
+	/**
+	 * @brief Inserts <node> into the tree, starting at a finger
+	 *
+	 * Inserts <node> into the tree. Instead of searching the insertion position
+	 * from the root, the search climbs up from <finger> only as far as
+	 * necessary. If <node> is inserted d elements away from <finger>, this
+	 * usually costs O(log d) comparisons instead of O(log n). See
+	 * lower_bound_from() for details.
+	 *
+	 * @param   Node  The node to be inserted.
+	 * @param   finger  An iterator into this tree. If it is end(), this is
+	 * equivalent to insert(<node>).
+	 */
+	void insert_near(Node & node, iterator<false> finger) CMP_NOEXCEPT(node);
+
 	/**
 	 * @brief Removes <node> from the tree
 	 *
@@ -304,6 +319,51 @@ public:
 	utilities::select_type_t<const iterator<reverse>, Node *, Options::stl_erase>
 	erase(const iterator<reverse> & it) CMP_NOEXCEPT(*it);
 
+	/**
+	 * @brief Removes all nodes in a key range from the tree
+	 *
+	 * Removes all nodes that are not less than <lo> but less than <hi>, i.e., the
+	 * range [lo, hi). Every node is handed to <callback> right after it has been
+	 * removed, so the owner of the nodes may e.g. free them there.
+	 *
+	 * Only the first node is searched for. From there on, the nodes are unlinked
+	 * one after the other. Since red-black trees need only amortized O(1)
+	 * rebalancing work per removal, removing k nodes costs O(log n + k)
+	 * amortized. This also holds with TreeFlags::RBT_SINGLE_PASS, since the
+	 * nodes are always removed bottom-up here.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be removed.
+	 * @param hi    Anything comparable to a node. All removed nodes are less than
+	 * <hi>.
+	 * @param callback  A callable that is invoked as callback(Node &) for every
+	 * removed node.
+	 *
+	 * @return The number of removed nodes
+	 */
+	template <class Comparable, class Callback>
+	size_t erase_range(const Comparable & lo, const Comparable & hi,
+	                   Callback callback);
+	template <class Comparable>
+	size_t erase_range(const Comparable & lo, const Comparable & hi);
+
+	/**
+	 * @brief Moves all nodes in a key range into a new tree
+	 *
+	 * Removes all nodes in the range [lo, hi) from this tree (see erase_range())
+	 * and returns a tree containing exactly these nodes. Since the nodes are
+	 * appended to the new tree in order, this costs O(log n + k) amortized, too.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be moved.
+	 * @param hi    Anything comparable to a node. All moved nodes are less than
+	 * <hi>.
+	 *
+	 * @return A new tree containing the nodes of the range
+	 */
+	template <class Comparable>
+	MyClass extract_range(const Comparable & lo, const Comparable & hi);
+
 	// Mainly debugging methods
 	/// @cond INTERNAL
 	void dbg_verify() const;
@@ -313,12 +373,24 @@ public:
 protected:
 	using Path = std::vector<Node *>;
 
+	// Dispatches to remove_to_leaf() or remove_onepass()
+	void remove_base(Node & node) CMP_NOEXCEPT(node);
 	void remove_to_leaf(Node & node) CMP_NOEXCEPT(node);
 	void fixup_after_delete(Node * parent, bool deleted_left) noexcept;
+	// Top-down removal, see TreeFlags::RBT_SINGLE_PASS
+	void remove_onepass(Node & node) CMP_NOEXCEPT(node);
 
 	void insert_leaf_base(Node & node, Node * start) CMP_NOEXCEPT(node);
+	// Inserts <node> as right child of <largest>, which must be the largest node
+	// in the tree (or nullptr if the tree is empty).
+	void append_leaf(Node & node, Node * largest) noexcept;
+
+	// Top-down insertion, see TreeFlags::RBT_SINGLE_PASS
+	void insert_leaf_onepass(Node & node) CMP_NOEXCEPT(node);
 
 	void fixup_after_insert(Node * node) noexcept;
+	// Resolves a red <node> below a red parent, given that its uncle is black
+	void rotate_red_violation(Node * node) noexcept;
 	void rotate_left(Node * parent) noexcept;
 	void rotate_right(Node * parent) noexcept;
 
@@ -0,0 +1,204 @@
+#ifndef YGG_STATS_HPP
+#define YGG_STATS_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ygg {
+namespace stats {
+
+/**
+ * @brief Counters of the structural operations a tree has performed
+ *
+ * Trees only count these if TreeFlags::COLLECT_STATISTICS is set. Counters
+ * that do not apply to a tree (e.g. zips for a red-black tree) stay zero.
+ */
+struct Counters
+{
+	/// Number of (single) rotations
+	size_t rotations = 0;
+	/// Number of zip operations (Zip Tree removals)
+	size_t zips = 0;
+	/// Number of unzip operations (Zip Tree insertions)
+	size_t unzips = 0;
+	/// Number of subtree rebuilds (Energy-Balanced Tree)
+	size_t rebuilds = 0;
+	/// Number of key comparisons
+	size_t comparisons = 0;
+};
+
+/**
+ * @brief The shape of a tree at a certain point in time
+ *
+ * Depths are counted in edges, i.e., the root has depth zero.
+ */
+struct Shape
+{
+	/// depth_histogram[d] is the number of nodes with depth d
+	std::vector<size_t> depth_histogram;
+	/// Number of nodes in the tree
+	size_t node_count = 0;
+	/// The average depth of all nodes
+	double average_path_length = 0;
+	/// The depth of the deepest node
+	size_t max_depth = 0;
+};
+
+/// @cond INTERNAL
+
+/* Holds the counters of a tree. This is empty if statistics are disabled, and
+ * counting does nothing. The trees inherit from it instead of holding it as a
+ * member, such that it then takes up no space at all. */
+template <bool enable>
+class CounterHolder {
+};
+
+template <>
+class CounterHolder<true> {
+public:
+	void
+	count_rotation() noexcept
+	{
+		this->c.rotations++;
+	}
+
+	void
+	count_zip() noexcept
+	{
+		this->c.zips++;
+	}
+
+	void
+	count_unzip() noexcept
+	{
+		this->c.unzips++;
+	}
+
+	void
+	count_rebuild() noexcept
+	{
+		this->c.rebuilds++;
+	}
+
+	const Counters &
+	get() const noexcept
+	{
+		return this->c;
+	}
+
+	void
+	reset() noexcept
+	{
+		this->c = Counters();
+	}
+
+private:
+	Counters c;
+};
+
+template <>
+class CounterHolder<false> {
+public:
+	void
+	count_rotation() noexcept
+	{}
+
+	void
+	count_zip() noexcept
+	{}
+
+	void
+	count_unzip() noexcept
+	{}
+
+	void
+	count_rebuild() noexcept
+	{}
+
+	void
+	reset() noexcept
+	{}
+};
+
+static_assert(std::is_empty_v<CounterHolder<false>>,
+              "Disabled statistics must not take up space.");
+
+/* Wraps a tree's comparator and counts how often it is called. Comparisons
+ * happen in const methods (e.g. find()), thus the counter is mutable. */
+template <class Compare>
+class CountingCompare {
+public:
+	template <class T1, class T2>
+	[[gnu::always_inline]] inline bool
+	operator()(const T1 & lhs, const T2 & rhs) const
+	    noexcept(noexcept(std::declval<const Compare &>()(lhs, rhs)))
+	{
+		this->count++;
+		return this->cmp(lhs, rhs);
+	}
+
+	size_t
+	get_count() const noexcept
+	{
+		return this->count;
+	}
+
+	void
+	reset_count() noexcept
+	{
+		this->count = 0;
+	}
+
+private:
+	Compare cmp;
+	mutable size_t count = 0;
+};
+
+/* Computes the shape of the tree rooted at root. ChildGetter must provide
+ * static get_left(const Node *) and get_right(const Node *) methods. */
+template <class ChildGetter, class Node>
+Shape
+compute_shape(const Node * root)
+{
+	Shape shape;
+	if (root == nullptr) {
+		return shape;
+	}
+
+	size_t depth_sum = 0;
+	std::vector<std::pair<const Node *, size_t>> stack;
+	stack.emplace_back(root, 0);
+	while (!stack.empty()) {
+		auto [node, depth] = stack.back();
+		stack.pop_back();
+
+		if (shape.depth_histogram.size() <= depth) {
+			shape.depth_histogram.resize(depth + 1, 0);
+		}
+		shape.depth_histogram[depth]++;
+		shape.node_count++;
+		depth_sum += depth;
+
+		if (ChildGetter::get_left(node) != nullptr) {
+			stack.emplace_back(ChildGetter::get_left(node), depth + 1);
+		}
+		if (ChildGetter::get_right(node) != nullptr) {
+			stack.emplace_back(ChildGetter::get_right(node), depth + 1);
+		}
+	}
+
+	shape.max_depth = shape.depth_histogram.size() - 1;
+	shape.average_path_length = static_cast<double>(depth_sum) /
+	                            static_cast<double>(shape.node_count);
+
+	return shape;
+}
+
+/// @endcond
+
+} // namespace stats
+} // namespace ygg
+
+#endif // YGG_STATS_HPP
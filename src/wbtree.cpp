@@ -498,6 +498,8 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::rotate_left(
     Node * parent) noexcept
 {
+	this->stat_counters().count_rotation();
+
 	Node * right_child = parent->NB::get_right();
 
 	size_t right_child_old_size = right_child->NB::_wbt_size;
@@ -538,6 +540,8 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::rotate_right(
     Node * parent) noexcept
 {
+	this->stat_counters().count_rotation();
+
 	// TODO adapt rotate_right to arithmetics
 	Node * left_child = parent->NB::get_left();
 
@@ -689,7 +693,12 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::insert(Node & node)
     CMP_NOEXCEPT(node)
 {
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
 	this->s.add(1);
+	this->cache_key(node);
 	if constexpr (Options::wbt_single_pass) {
 		this->insert_leaf_onepass<true>(node);
 	} else {
@@ -702,7 +711,12 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::insert_left_leaning(
     Node & node) CMP_NOEXCEPT(node)
 {
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
 	this->s.add(1);
+	this->cache_key(node);
 	this->insert_leaf_base_twopass<true>(node, this->root);
 }
 
@@ -711,10 +725,404 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::insert_right_leaning(
     Node & node) CMP_NOEXCEPT(node)
 {
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
 	this->s.add(1);
+	this->cache_key(node);
 	this->insert_leaf_base_twopass<false>(node, this->root);
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+WBTree<Node, NodeTraits, Options, Tag, Compare>::insert_near(
+    Node & node, iterator<false> finger) CMP_NOEXCEPT(node)
+{
+	if (finger == this->end()) {
+		this->insert(node);
+		return;
+	}
+
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
+	this->s.add(1);
+	this->cache_key(node);
+
+	Node * upper;
+	Node * anchor = this->climb_from_finger(&*finger, node, upper);
+	// The descent below only accounts for the new node from anchor downwards
+	for (Node * cur = anchor->NB::get_parent(); cur != nullptr;
+	     cur = cur->NB::get_parent()) {
+		cur->NB::_wbt_size += 1;
+	}
+	this->insert_leaf_base_twopass<true>(node, anchor);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable, class Callback>
+size_t
+WBTree<Node, NodeTraits, Options, Tag, Compare>::erase_range(
+    const Comparable & lo, const Comparable & hi, Callback callback)
+{
+	Node * range = this->unlink_range(lo, hi);
+	size_t count = weight(range) - 1;
+
+	// Flatten the range into a list along the right pointers. The callback may
+	// free a node, thus we must not climb back up to it afterwards.
+	Node * head = nullptr;
+	Node * tail = nullptr;
+	Node * rest = range;
+	while (rest != nullptr) {
+		Node * left = rest->NB::get_left();
+		if (left == nullptr) {
+			tail = rest;
+			rest = rest->NB::get_right();
+		} else {
+			// Rotate right without any bookkeeping, the nodes are gone anyway
+			rest->NB::set_left(left->NB::get_right());
+			left->NB::set_right(rest);
+			rest = left;
+			if (tail == nullptr) {
+				head = left;
+			} else {
+				tail->NB::set_right(left);
+			}
+		}
+		if (head == nullptr) {
+			head = tail;
+		}
+	}
+
+	while (head != nullptr) {
+		Node & node = *head;
+		head = head->NB::get_right();
+
+#ifdef YGG_STORE_SEQUENCE
+		this->bss.register_delete(reinterpret_cast<const void *>(&node),
+		                          Options::SequenceInterface::get_key(node));
+#endif
+		callback(node);
+	}
+
+	return count;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+WBTree<Node, NodeTraits, Options, Tag, Compare>::erase_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	return this->erase_range(lo, hi, [](Node &) {});
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+typename WBTree<Node, NodeTraits, Options, Tag, Compare>::MyClass
+WBTree<Node, NodeTraits, Options, Tag, Compare>::extract_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	MyClass extracted;
+	Node * range = this->unlink_range(lo, hi);
+
+	if (range != nullptr) {
+		extracted.root = range;
+		extracted.s.add(weight(range) - 1);
+	}
+
+#ifdef YGG_STORE_SEQUENCE
+	for (const Node & node : extracted) {
+		this->bss.register_delete(reinterpret_cast<const void *>(&node),
+		                          Options::SequenceInterface::get_key(node));
+	}
+#endif
+
+	return extracted;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+Node *
+WBTree<Node, NodeTraits, Options, Tag, Compare>::unlink_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	decltype(auto) lo_key = this->search_key(lo);
+	decltype(auto) hi_key = this->search_key(hi);
+
+	auto [before, rest] = this->split(this->root, lo_key);
+	auto [range, after] = this->split(rest, hi_key);
+
+	this->root = this->join(before, after);
+	this->s.reduce(weight(range) - 1);
+
+	return range;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Key>
+std::pair<Node *, Node *>
+WBTree<Node, NodeTraits, Options, Tag, Compare>::split(Node * subtree,
+                                                       const Key & key)
+{
+	// Returns the nodes less than <key> and the nodes not less than <key>
+	if (subtree == nullptr) {
+		return {nullptr, nullptr};
+	}
+
+	Node * left = subtree->NB::get_left();
+	Node * right = subtree->NB::get_right();
+	if (left != nullptr) {
+		left->NB::set_parent(nullptr);
+	}
+	if (right != nullptr) {
+		right->NB::set_parent(nullptr);
+	}
+
+	if (this->cmp(*subtree, key)) {
+		auto [less, not_less] = this->split(right, key);
+		return {this->join(left, *subtree, less), not_less};
+	} else {
+		auto [less, not_less] = this->split(left, key);
+		return {less, this->join(not_less, *subtree, right)};
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+std::pair<Node *, Node *>
+WBTree<Node, NodeTraits, Options, Tag, Compare>::split_last(
+    Node * subtree) noexcept
+{
+	// Returns <subtree> without its largest node, and that node
+	Node * left = subtree->NB::get_left();
+	Node * right = subtree->NB::get_right();
+	if (left != nullptr) {
+		left->NB::set_parent(nullptr);
+	}
+
+	if (right == nullptr) {
+		return {left, subtree};
+	}
+
+	right->NB::set_parent(nullptr);
+	auto [rest, last] = this->split_last(right);
+	return {this->join(left, *subtree, rest), last};
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+Node *
+WBTree<Node, NodeTraits, Options, Tag, Compare>::join(Node * left,
+                                                      Node * right) noexcept
+{
+	if (left == nullptr) {
+		return right;
+	}
+
+	auto [rest, last] = this->split_last(left);
+	return this->join(rest, *last, right);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+Node *
+WBTree<Node, NodeTraits, Options, Tag, Compare>::join(Node * left,
+                                                      Node & middle,
+                                                      Node * right) noexcept
+{
+	// Joins <left>, <middle> and <right>, which must be ordered like this. If
+	// one side is too heavy, <middle> is hung into its inner spine as far down
+	// as necessary, and the spine is rebalanced on the way back up. This costs
+	// O(1 + |log(weight(left)) - log(weight(right))|).
+	size_t left_weight = weight(left);
+	size_t right_weight = weight(right);
+
+	Node * parent = nullptr;
+	size_t added_weight = 0;
+	if (too_heavy(left_weight, right_weight)) {
+		parent = left;
+		left = left->NB::get_right();
+		while (too_heavy(weight(left), right_weight)) {
+			parent = left;
+			left = left->NB::get_right();
+		}
+		parent->NB::set_right(&middle);
+		added_weight = right_weight;
+	} else if (too_heavy(right_weight, left_weight)) {
+		parent = right;
+		right = right->NB::get_left();
+		while (too_heavy(weight(right), left_weight)) {
+			parent = right;
+			right = right->NB::get_left();
+		}
+		parent->NB::set_left(&middle);
+		added_weight = left_weight;
+	}
+
+	middle.NB::set_parent(parent);
+	middle.NB::set_left(left);
+	middle.NB::set_right(right);
+	if (left != nullptr) {
+		left->NB::set_parent(&middle);
+	}
+	if (right != nullptr) {
+		right->NB::set_parent(&middle);
+	}
+	middle.NB::_wbt_size = weight(left) + weight(right);
+
+	if (parent == nullptr) {
+		return &middle;
+	}
+
+	Node * cur = parent;
+	while (true) {
+		cur->NB::_wbt_size += added_weight;
+		cur = this->rebalance_after_join(cur);
+		if (cur->NB::get_parent() == nullptr) {
+			return cur;
+		}
+		cur = cur->NB::get_parent();
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+Node *
+WBTree<Node, NodeTraits, Options, Tag, Compare>::rebalance_after_join(
+    Node * node) noexcept
+{
+	// Other than after a single insertion or deletion, one side may have grown
+	// by a lot. Thus, we rotate once if that balances both rotated nodes, and
+	// twice otherwise, instead of relying on gamma.
+	size_t left_weight = weight(node->NB::get_left());
+	size_t right_weight = weight(node->NB::get_right());
+
+	auto balanced = [](size_t a, size_t b) {
+		return !too_heavy(a, b) && !too_heavy(b, a);
+	};
+
+	if (too_heavy(right_weight, left_weight)) {
+		Node * right = node->NB::get_right();
+		size_t right_left = weight(right->NB::get_left());
+		size_t right_right = weight(right->NB::get_right());
+
+		if ((right->NB::get_left() != nullptr) &&
+		    (!balanced(left_weight, right_left) ||
+		     !balanced(left_weight + right_left, right_right))) {
+			this->rotate_right(right);
+		}
+		this->rotate_left(node);
+
+		return node->NB::get_parent();
+	} else if (too_heavy(left_weight, right_weight)) {
+		Node * left = node->NB::get_left();
+		size_t left_right = weight(left->NB::get_right());
+		size_t left_left = weight(left->NB::get_left());
+
+		if ((left->NB::get_right() != nullptr) &&
+		    (!balanced(right_weight, left_right) ||
+		     !balanced(right_weight + left_right, left_left))) {
+			this->rotate_left(left);
+		}
+		this->rotate_right(node);
+
+		return node->NB::get_parent();
+	}
+
+	return node;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+size_t
+WBTree<Node, NodeTraits, Options, Tag, Compare>::weight(
+    const Node * subtree) noexcept
+{
+	// _wbt_size counts the nodes in the subtree plus one
+	return (subtree != nullptr) ? subtree->NB::_wbt_size : 1;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+bool
+WBTree<Node, NodeTraits, Options, Tag, Compare>::too_heavy(
+    size_t heavy, size_t light) noexcept
+{
+	return static_cast<typename Options::WBTDeltaT>(light) *
+	           Options::wbt_delta() <
+	       static_cast<typename Options::WBTDeltaT>(heavy);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+template <class Comparable>
+size_t
+WBTree<Node, NodeTraits, Options, Tag, Compare>::count(
+    const Comparable & query) const CMP_NOEXCEPT(query)
+{
+	// _wbt_size counts the nodes in the subtree plus one
+	auto subtree_size = [](const Node * n) -> size_t {
+		return (n != nullptr) ? (n->NB::_wbt_size - 1) : 0;
+	};
+
+	decltype(auto) key = this->search_key(query);
+	Node * cur = this->root;
+	while (cur != nullptr) {
+		if (this->cmp(*cur, key)) {
+			cur = cur->NB::get_right();
+		} else if (this->cmp(key, *cur)) {
+			cur = cur->NB::get_left();
+		} else {
+			break;
+		}
+	}
+
+	if (cur == nullptr) {
+		return 0;
+	}
+
+	size_t count = 1;
+
+	// Everything in the left subtree that is not less than the query
+	Node * left = cur->NB::get_left();
+	while (left != nullptr) {
+		if (this->cmp(*left, key)) {
+			left = left->NB::get_right();
+		} else {
+			count += 1 + subtree_size(left->NB::get_right());
+			left = left->NB::get_left();
+		}
+	}
+
+	// Everything in the right subtree that is not greater than the query
+	Node * right = cur->NB::get_right();
+	while (right != nullptr) {
+		if (this->cmp(key, *right)) {
+			right = right->NB::get_left();
+		} else {
+			count += 1 + subtree_size(right->NB::get_left());
+			right = right->NB::get_right();
+		}
+	}
+
+	return count;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare>
+void
+WBTree<Node, NodeTraits, Options, Tag, Compare>::append_leaf(
+    Node & node, Node * largest) CMP_NOEXCEPT(node)
+{
+	this->s.add(1);
+
+	if (largest != nullptr) {
+		// The descent below only accounts for the new node from largest downwards
+		for (Node * cur = largest->NB::get_parent(); cur != nullptr;
+		     cur = cur->NB::get_parent()) {
+			cur->NB::_wbt_size += 1;
+		}
+	}
+
+	// Prefer right on equality, so that node ends up right of largest
+	this->insert_leaf_base_twopass<false>(node, largest);
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare>
 void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::verify_sizes() const
@@ -1709,6 +2117,10 @@ void
 WBTree<Node, NodeTraits, Options, Tag, Compare>::remove(Node & node)
     CMP_NOEXCEPT(node)
 {
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_delete(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
 	this->s.reduce(1);
 
 	if constexpr (Options::wbt_single_pass) {
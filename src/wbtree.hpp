@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <set>
 #include <type_traits>
+#include <utility>
 
 // Only for debugging purposes
 #include <fstream>
@@ -192,6 +193,22 @@ public:
 	void insert_left_leaning(Node & node) CMP_NOEXCEPT(node);
 	void insert_right_leaning(Node & node) CMP_NOEXCEPT(node);
 
+	/**
+	 * @brief Inserts <node> into the tree, starting at a finger
+	 *
+	 * Inserts <node> into the tree. Instead of searching the insertion position
+	 * from the root, the search climbs up from <finger> only as far as
+	 * necessary, which usually saves most of the comparisons if <node> is
+	 * inserted close to <finger>. Note that the subtree sizes of all ancestors
+	 * must still be updated and rebalanced, so this still costs O(log n) pointer
+	 * operations.
+	 *
+	 * @param   Node  The node to be inserted.
+	 * @param   finger  An iterator into this tree. If it is end(), this is
+	 * equivalent to insert(<node>).
+	 */
+	void insert_near(Node & node, iterator<false> finger) CMP_NOEXCEPT(node);
+
 	/**
 	 * @brief Deletes a node that compares equally to <c> from the tree
 	 *
@@ -236,6 +253,62 @@ public:
 	utilities::select_type_t<const iterator<reverse>, Node *, Options::stl_erase>
 	erase(const iterator<reverse> & it) CMP_NOEXCEPT(*it);
 
+	/**
+	 * @brief Removes all nodes in a key range from the tree
+	 *
+	 * Removes all nodes that are not less than <lo> but less than <hi>, i.e., the
+	 * range [lo, hi). Every node is handed to <callback> right after it has been
+	 * removed, so the owner of the nodes may e.g. free them there.
+	 *
+	 * The tree is split at <lo> and <hi>, and the two outer parts are joined
+	 * again. Both use the subtree sizes stored at the nodes, thus removing k
+	 * nodes costs O(log n + k). Note that the nodes are relinked directly by
+	 * split and join, the NodeTraits are only notified about rotations.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be removed.
+	 * @param hi    Anything comparable to a node. All removed nodes are less than
+	 * <hi>.
+	 * @param callback  A callable that is invoked as callback(Node &) for every
+	 * removed node.
+	 *
+	 * @return The number of removed nodes
+	 */
+	template <class Comparable, class Callback>
+	size_t erase_range(const Comparable & lo, const Comparable & hi,
+	                   Callback callback);
+	template <class Comparable>
+	size_t erase_range(const Comparable & lo, const Comparable & hi);
+
+	/**
+	 * @brief Moves all nodes in a key range into a new tree
+	 *
+	 * Removes all nodes in the range [lo, hi) from this tree (see erase_range())
+	 * and returns a tree containing exactly these nodes. The middle part of the
+	 * split becomes the new tree as it is, thus this costs O(log n).
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be moved.
+	 * @param hi    Anything comparable to a node. All moved nodes are less than
+	 * <hi>.
+	 *
+	 * @return A new tree containing the nodes of the range
+	 */
+	template <class Comparable>
+	MyClass extract_range(const Comparable & lo, const Comparable & hi);
+
+	/**
+	 * @brief Counts the elements comparing equally to <query>
+	 *
+	 * Uses the subtree sizes stored at the nodes, thus this runs in O(log n)
+	 * regardless of the number of counted elements.
+	 *
+	 * @param query An object comparable to Node
+	 * @returns The number of elements comparing equally to <query>
+	 */
+	template <class Comparable>
+	size_t count(const Comparable & query) const CMP_NOEXCEPT(query);
+
 	// TODO document
 	template <class Comparable>
 	Node * erase_optimistic(const Comparable & c) CMP_NOEXCEPT(c);
@@ -279,8 +352,25 @@ protected:
 
 	template <bool on_equality_prefer_left>
 	void insert_leaf_base_twopass(Node & node, Node * start) CMP_NOEXCEPT(node);
+	// Inserts <node> as right child of <largest>, which must be the largest node
+	// in the tree (or nullptr if the tree is empty).
+	void append_leaf(Node & node, Node * largest) CMP_NOEXCEPT(node);
 	void fixup_after_insert_twopass(Node * node) CMP_NOEXCEPT(*node);
 
+	// Split and join, used by erase_range() and extract_range(). All subtrees
+	// handed to or returned from these are detached, i.e., their root has no
+	// parent. Note that the rotations may overwrite this->root.
+	template <class Comparable>
+	Node * unlink_range(const Comparable & lo, const Comparable & hi);
+	template <class Key>
+	std::pair<Node *, Node *> split(Node * subtree, const Key & key);
+	std::pair<Node *, Node *> split_last(Node * subtree) noexcept;
+	Node * join(Node * left, Node & middle, Node * right) noexcept;
+	Node * join(Node * left, Node * right) noexcept;
+	Node * rebalance_after_join(Node * node) noexcept;
+	static size_t weight(const Node * subtree) noexcept;
+	static bool too_heavy(size_t heavy, size_t light) noexcept;
+
 	template <bool on_equality_prefer_left>
 	void insert_leaf_onepass(Node & node) CMP_NOEXCEPT(node);
 
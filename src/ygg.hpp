@@ -1,8 +1,12 @@
+#include "btree_index.hpp"
 #include "dynamic_segment_tree.hpp"
+#include "eytzinger.hpp"
 #include "intervaltree.hpp"
 #include "list.hpp"
+#include "node_pool.hpp"
 #include "options.hpp"
 #include "rbtree.hpp"
 #include "ziptree.hpp"
+#include "concurrent_ziptree.hpp"
 #include "energy.hpp"
 #include "wbtree.hpp"
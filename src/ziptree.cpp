@@ -3,6 +3,7 @@
 
 #include "ziptree.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -49,31 +50,87 @@ ZTreeRankGenerator<Node, Options, true, false>::update_rank(
 	(void)node;
 }
 
-template <class Node, class Options>
-int
-ZTreeRankGenerator<Node, Options, true, false>::get_rank(
-    const Node & node) noexcept
+std::uint32_t
+mix_rank_hash(size_t hash) noexcept
 {
-	auto hasher = typename Options::template ztree_hasher_type<Node>();
+	// Fold to 32 bits, then apply the finalizer of MurmurHash3. Only 32 bit
+	// multiplications are used, which all vector instruction sets provide.
+	std::uint64_t wide = hash;
+	auto mixed = static_cast<std::uint32_t>(wide ^ (wide >> 32));
+	mixed ^= mixed >> 16;
+	mixed *= 0x85ebca6bu;
+	mixed ^= mixed >> 13;
+	mixed *= 0xc2b2ae35u;
+	mixed ^= mixed >> 16;
+	return mixed;
+}
+
+size_t
+rank_from_mixed_hash(std::uint32_t mixed) noexcept
+{
+	// Setting the topmost bit avoids the branch for zero. Same result as
+	// ffs() otherwise.
+	constexpr std::uint32_t top_bit = std::uint32_t{1} << 31;
+	return static_cast<size_t>(__builtin_ctz(mixed | top_bit)) + 1;
+}
 
-	// TODO ffsl? ffs?
+std::uint32_t
+rank_from_mixed_hash_vectorizable(std::uint32_t mixed) noexcept
+{
+	constexpr std::uint32_t top_bit = std::uint32_t{1} << 31;
+	mixed |= top_bit;
+	std::uint32_t lowest_bit = mixed & (0u - mixed);
+
+	// The exponent of a power of two is its number of trailing zeroes. Signed
+	// conversions vectorize everywhere, and 2^31 becomes -2^31, which has the
+	// same exponent.
+	auto as_float = static_cast<float>(static_cast<std::int32_t>(lowest_bit));
+	std::uint32_t bits;
+	std::memcpy(&bits, &as_float, sizeof(bits));
+	return ((bits >> 23) & 0xffu) - 126u;
+}
+
+template <class Options>
+size_t
+universalize_rank_hash(size_t hash) noexcept
+{
+	// TODO this is not strictly a universal family
 	if constexpr (Options::ztree_universalize_lincong) {
-		// TODO this is not strictly a universal family
-		size_t universalized =
-		    (hasher(node) * Options::ztree_universalize_coefficient) %
-		    Options::ztree_universalize_modul;
-		return __builtin_ffsl(static_cast<long int>(universalized));
+		hash = (hash * Options::ztree_universalize_coefficient) %
+		       Options::ztree_universalize_modul;
 	} else if constexpr (Options::ztree_universalize_multiply) {
 		// This is a variant of the multiply-shift method by Dietzfelbinger et al.
 		// Since we hash to all of size_t, we don't need a shift.
-		size_t universalized =
-		    (hasher(node) * Options::ztree_universalize_coefficient);
-		return __builtin_ffsl(static_cast<long int>(universalized));
+		hash = hash * Options::ztree_universalize_coefficient;
+	}
+
+	return hash;
+}
+
+template <class Options>
+size_t
+rank_from_hash(size_t hash) noexcept
+{
+	hash = universalize_rank_hash<Options>(hash);
+
+	if constexpr (Options::ztree_rank_hash_mix) {
+		return rank_from_mixed_hash(mix_rank_hash(hash));
 	} else {
-		return __builtin_ffsl(static_cast<long int>(hasher(node)));
+		// TODO ffsl? ffs?
+		return static_cast<size_t>(__builtin_ffsl(static_cast<long int>(hash)));
 	}
 }
 
+template <class Node, class Options>
+int
+ZTreeRankGenerator<Node, Options, true, false>::get_rank(
+    const Node & node) noexcept
+{
+	auto hasher = typename Options::template ztree_hasher_type<Node>();
+
+	return static_cast<int>(rank_from_hash<Options>(hasher(node)));
+}
+
 template <class Node, class Options>
 ZTreeRankGenerator<Node, Options, true, true>::ZTreeRankGenerator()
 {}
@@ -84,24 +141,48 @@ ZTreeRankGenerator<Node, Options, true, true>::update_rank(Node & node) noexcept
 {
 	const auto hasher = typename Options::template ztree_hasher_type<Node>();
 
-	// TODO ffsl? ffs?
-	if constexpr (Options::ztree_universalize_lincong) {
-		// TODO this is not strictly a universal family
-		size_t universalized =
-		    (hasher(node) * Options::ztree_universalize_coefficient) %
-		    Options::ztree_universalize_modul;
-		node._zt_rank.rank = static_cast<decltype(node._zt_rank.rank)>(
-		    __builtin_ffsl(static_cast<long int>(universalized)));
-	} else if constexpr (Options::ztree_universalize_multiply) {
-		// This is a variant of the multiply-shift method by Dietzfelbinger et al.
-		// Since we hash to all of size_t, we don't need a shift.
-		size_t universalized =
-		    (hasher(node) * Options::ztree_universalize_coefficient);
-		node._zt_rank.rank = static_cast<decltype(node._zt_rank.rank)>(
-		    __builtin_ffsl(static_cast<long int>(universalized)));
-	} else {
-		node._zt_rank.rank = static_cast<decltype(node._zt_rank.rank)>(
-		    __builtin_ffsl(static_cast<long int>(hasher(node))));
+	node._zt_rank.rank = static_cast<decltype(node._zt_rank.rank)>(
+	    rank_from_hash<Options>(hasher(node)));
+}
+
+template <class Node, class Options>
+template <class InputIt>
+void
+ZTreeRankGenerator<Node, Options, true, true>::update_ranks(
+    InputIt first, InputIt last) noexcept
+{
+	const auto hasher = typename Options::template ztree_hasher_type<Node>();
+
+	constexpr size_t BLOCK_SIZE = 32;
+	Node * nodes[BLOCK_SIZE];
+	size_t hashes[BLOCK_SIZE];
+	std::uint32_t ranks[BLOCK_SIZE];
+
+	while (first != last) {
+		size_t count = 0;
+		for (; (count < BLOCK_SIZE) && (first != last); ++count, ++first) {
+			nodes[count] = &(*first);
+			hashes[count] = hasher(*first);
+		}
+
+		if constexpr (Options::ztree_rank_hash_mix) {
+			// No dependencies between the iterations and no bit scan, thus this is
+			// vectorized
+			for (size_t i = 0; i < count; ++i) {
+				ranks[i] = rank_from_mixed_hash_vectorizable(
+				    mix_rank_hash(universalize_rank_hash<Options>(hashes[i])));
+			}
+		} else {
+			for (size_t i = 0; i < count; ++i) {
+				ranks[i] =
+				    static_cast<std::uint32_t>(rank_from_hash<Options>(hashes[i]));
+			}
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			nodes[i]->_zt_rank.rank =
+			    static_cast<decltype(nodes[i]->_zt_rank.rank)>(ranks[i]);
+		}
 	}
 }
 
@@ -233,6 +314,20 @@ ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::operator=(
 	this->s = other.s;
 }
 
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class InputIt>
+void
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::update_ranks(
+    InputIt first, InputIt last) noexcept
+{
+	static_assert(Options::ztree_use_hash && Options::ztree_store_rank,
+	              "update_ranks() requires ZTREE_USE_HASH and ZTREE_RANK_TYPE");
+
+	ztree_internal::ZTreeRankGenerator<Node, Options, true, true>::update_ranks(
+	    first, last);
+}
+
 template <class Node, class NodeTraits, class Options, class Tag, class Compare,
           class RankGetter>
 void
@@ -252,6 +347,7 @@ ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::insert(
 	// First, search for insertion position.
 	auto node_rank = RankGetter::get_rank(node);
 	this->s.add(1);
+	this->cache_key(node);
 
 	// TODO this should be handled by the code below
 	if (this->root == nullptr) {
@@ -266,54 +362,199 @@ ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::insert(
 
 		this->unzip(*old_root, node);
 	} else {
-		Node * current = this->root;
-
-		// Find the *parent* of the node to be replaced
-		// TODO this assumes that comparison is cheaper than rank-getting. Should we
-		// implement both?
-		// TODO this assumes to insert the nodes as far to the bottom as possible in
-		// the case of rank ties. Is that a good idea?
-		while (true) {
-			// Check if we must descend left
-
-			bool goes_after = this->cmp(*current, node);
-			if (!goes_after &&
-			    __builtin_expect((current->NB::get_left() != nullptr), 1) &&
-			    (RankGetter::get_rank(*current->NB::get_left()) >= node_rank)) {
-				current = current->NB::get_left();
-			} else if (goes_after &&
-			           __builtin_expect((current->NB::get_right() != nullptr), 1) &&
-			           (RankGetter::get_rank(*current->NB::get_right()) >=
-			            node_rank)) {
-				current = current->NB::get_right();
-			} else {
-				// we're done!
-				break;
-			}
-		}
+		this->insert_below(node, this->root, node_rank);
+	}
+}
 
-		// Place node below parent
-		Node * old_node = nullptr;
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::insert_near(
+    Node & node, iterator<false> finger) noexcept
+{
+	if (finger == this->end()) {
+		this->insert(node);
+		return;
+	}
 
-		node.NB::set_parent(current);
-		if (!this->cmp(*current, node)) {
-			// Place left
-			if (current->NB::get_left() != nullptr) {
-				old_node = current->NB::get_left();
-			}
-			current->NB::set_left(&node);
+	auto node_rank = RankGetter::get_rank(node);
+	this->cache_key(node);
+
+	// Every ancestor of a node on the search path is on the search path, too.
+	// Ranks never decrease going upwards, so we climb until the rank suffices.
+	Node * upper;
+	Node * current = this->climb_from_finger(&*finger, node, upper);
+	while ((current != nullptr) &&
+	       (RankGetter::get_rank(*current) < node_rank)) {
+		current = current->NB::get_parent();
+	}
+
+	if ((current == nullptr) || (current == this->root)) {
+		// The root might need to be replaced
+		this->insert(node);
+		return;
+	}
+
+#ifdef YGG_STORE_SEQUENCE
+	this->bss.register_insert(reinterpret_cast<const void *>(&node),
+	                          Options::SequenceInterface::get_key(node));
+#endif
+
+	node.NB::set_parent(nullptr);
+	node.NB::set_left(nullptr);
+	node.NB::set_right(nullptr);
+	this->s.add(1);
+
+	this->insert_below(node, current, node_rank);
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+void
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::insert_below(
+    Node & node, Node * current,
+    typename ZTree<Node, NodeTraits, Options, Tag, Compare,
+                   RankGetter>::RankType node_rank) noexcept
+{
+	// Find the *parent* of the node to be replaced
+	// TODO this assumes that comparison is cheaper than rank-getting. Should we
+	// implement both?
+	// TODO this assumes to insert the nodes as far to the bottom as possible in
+	// the case of rank ties. Is that a good idea?
+	while (true) {
+		// Check if we must descend left
+
+		bool goes_after = this->cmp(*current, node);
+		if (!goes_after &&
+		    __builtin_expect((current->NB::get_left() != nullptr), 1) &&
+		    (RankGetter::get_rank(*current->NB::get_left()) >= node_rank)) {
+			current = current->NB::get_left();
+		} else if (goes_after &&
+		           __builtin_expect((current->NB::get_right() != nullptr), 1) &&
+		           (RankGetter::get_rank(*current->NB::get_right()) >=
+		            node_rank)) {
+			current = current->NB::get_right();
 		} else {
-			// Place right
-			if (current->NB::get_right() != nullptr) {
-				old_node = current->NB::get_right();
-			}
-			current->NB::set_right(&node);
+			// we're done!
+			break;
 		}
+	}
+
+	// Place node below parent
+	Node * old_node = nullptr;
 
-		if (old_node != nullptr) {
-			this->unzip(*old_node, node);
+	node.NB::set_parent(current);
+	if (!this->cmp(*current, node)) {
+		// Place left
+		if (current->NB::get_left() != nullptr) {
+			old_node = current->NB::get_left();
 		}
+		current->NB::set_left(&node);
+	} else {
+		// Place right
+		if (current->NB::get_right() != nullptr) {
+			old_node = current->NB::get_right();
+		}
+		current->NB::set_right(&node);
+	}
+
+	if (old_node != nullptr) {
+		this->unzip(*old_node, node);
+	}
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable, class Callback>
+size_t
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::erase_range(
+    const Comparable & lo, const Comparable & hi, Callback callback)
+{
+	decltype(auto) hi_key = this->search_key(hi);
+	auto it = this->lower_bound(lo);
+	size_t count = 0;
+
+	while ((it != this->end()) && this->cmp(*it, hi_key)) {
+		Node & node = *it;
+		++it;
+
+		this->remove(node);
+		count++;
+		callback(node);
+	}
+
+	return count;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable>
+size_t
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::erase_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	return this->erase_range(lo, hi, [](Node &) {});
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+template <class Comparable>
+typename ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::MyClass
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::extract_range(
+    const Comparable & lo, const Comparable & hi)
+{
+	MyClass extracted;
+	Node * largest = nullptr;
+
+	this->erase_range(lo, hi, [&](Node & node) {
+		largest = extracted.append(node, largest);
+	});
+
+	return extracted;
+}
+
+template <class Node, class NodeTraits, class Options, class Tag, class Compare,
+          class RankGetter>
+Node *
+ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::append(
+    Node & node, Node * largest) noexcept
+{
+	node.NB::set_left(nullptr);
+	node.NB::set_right(nullptr);
+	this->s.add(1);
+
+	auto node_rank = RankGetter::get_rank(node);
+
+	if ((largest != nullptr) && !this->cmp(*largest, node) &&
+	    (RankGetter::get_rank(*largest) >= node_rank)) {
+		// Equal nodes must never be in each other's right subtree, so node must
+		// go below largest, into its left subtree.
+		this->insert_below(node, largest, node_rank);
+		return largest;
+	}
+
+	// Climb the right spine until we find a node that stays above node. The
+	// part of the spine below it ends up in node's left subtree, which costs
+	// amortized O(1).
+	Node * parent = largest;
+	Node * below = nullptr;
+	while ((parent != nullptr) && (RankGetter::get_rank(*parent) < node_rank)) {
+		below = parent;
+		parent = parent->NB::get_parent();
 	}
+
+	node.NB::set_parent(parent);
+	if (parent != nullptr) {
+		parent->NB::set_right(&node);
+	} else {
+		this->root = &node;
+	}
+
+	if (below != nullptr) {
+		this->unzip(*below, node);
+	}
+
+	return &node;
 }
 
 template <class Node, class NodeTraits, class Options, class Tag, class Compare,
@@ -343,6 +584,8 @@ void
 ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::unzip(
     Node & oldn, Node & newn) noexcept
 {
+	this->stat_counters().count_unzip();
+
 	Node * left_head = &newn;
 	Node * right_head = &newn;
 
@@ -646,6 +889,8 @@ void
 ZTree<Node, NodeTraits, Options, Tag, Compare, RankGetter>::zip(
     Node & old_root) noexcept
 {
+	this->stat_counters().count_zip();
+
 	NodeTraits traits;
 
 	Node * left_head = old_root.NB::get_left();
@@ -12,6 +12,7 @@
 #endif
 
 #include <cmath>
+#include <cstdint>
 #include <functional>
 
 namespace ygg {
@@ -32,6 +33,28 @@ struct dbg_verify_size_helper
 template <class Node, class Options, bool use_hash, bool store>
 class ZTreeRankGenerator;
 
+// Branch-free mixer from 64 to 32 bits, see TreeFlags::ZTREE_RANK_HASH_MIX
+[[gnu::always_inline]] inline std::uint32_t mix_rank_hash(size_t hash) noexcept;
+
+// The rank of a mixed hash, i.e., its number of trailing zeroes plus one
+[[gnu::always_inline]] inline size_t
+rank_from_mixed_hash(std::uint32_t mixed) noexcept;
+
+// Same as rank_from_mixed_hash, but without a bit scan, such that loops over it
+// can be vectorized
+[[gnu::always_inline]] inline std::uint32_t
+rank_from_mixed_hash_vectorizable(std::uint32_t mixed) noexcept;
+
+// Applies the universalization configured in Options to a hash value
+template <class Options>
+[[gnu::always_inline]] inline size_t
+universalize_rank_hash(size_t hash) noexcept;
+
+// Derives a rank from a hash value, applying universalization / mixing as
+// configured in Options
+template <class Options>
+[[gnu::always_inline]] inline size_t rank_from_hash(size_t hash) noexcept;
+
 template <class Node, class Options>
 class ZTreeRankGenerator<Node, Options, true, false> {
 public:
@@ -46,6 +69,8 @@ class ZTreeRankGenerator<Node, Options, true, true> {
 public:
 	ZTreeRankGenerator();
 	static void update_rank(Node & node) noexcept;
+	template <class InputIt>
+	static void update_ranks(InputIt first, InputIt last) noexcept;
 	static size_t get_rank(const Node & node) noexcept;
 
 private:
@@ -82,6 +107,27 @@ class ZTreeRankGenerator<Node, Options, false, false> {
 /// @endcond
 } // namespace ztree_internal
 
+/**
+ * @brief Hasher that derives zip tree ranks from the nodes' addresses
+ *
+ * Since nodes may not move in memory while they are in a tree, their address
+ * is a valid source of randomness for their ranks. Using this as hasher (via
+ * TreeFlags::ZTREE_HASHER_TYPE) means that you neither need to specialize
+ * std::hash for your nodes nor store ranks in the nodes.
+ *
+ * @warning Addresses are aligned, i.e., their lowest bits are always zero. You
+ * must set TreeFlags::ZTREE_RANK_HASH_MIX when using this hasher.
+ */
+template <class Node>
+class ZTreeAddressHasher {
+public:
+	size_t
+	operator()(const Node & node) const noexcept
+	{
+		return reinterpret_cast<size_t>(&node);
+	}
+};
+
 /**
  * @brief Base class (template) to supply your node class with metainformation
  *
@@ -240,6 +286,30 @@ public:
 	 */
 	MyClass & operator=(MyClass && other) noexcept;
 
+	/**
+	 * @brief Computes the stored ranks of many nodes at once
+	 *
+	 * If the ranks are derived from hashes (TreeFlags::ZTREE_USE_HASH) and
+	 * stored at the nodes (TreeFlags::ZTREE_RANK_TYPE), every node's rank must
+	 * be updated before insertion. For bulk insertions, this method does so for
+	 * a whole range of nodes. Hashes are computed in blocks of 32.
+	 *
+	 * With TreeFlags::ZTREE_RANK_HASH_MIX, the ranks of a block are then derived
+	 * in a loop the compiler can vectorize: The mixer works on 32 bit lanes,
+	 * and the trailing zeroes are counted via a conversion to float instead of
+	 * a bit scan. The hash function itself is still called one node at a time.
+	 * Universalizing by multiplication needs 64 bit multiplications, which
+	 * vectorize with AVX2, but universalizing modulo
+	 * TreeFlags::ZTREE_RANK_HASH_UNIVERSALIZE_MODUL does not vectorize. Without
+	 * the mixer, ranks are derived from the full 64 bit hash via a bit scan,
+	 * which has no vector form, thus the whole batch is scalar.
+	 *
+	 * @param first Iterator to the first node whose rank should be updated
+	 * @param last Iterator after the last node whose rank should be updated
+	 */
+	template <class InputIt>
+	static void update_ranks(InputIt first, InputIt last) noexcept;
+
 	/*
 	 * Pull in classes from base tree
 	 */
@@ -265,6 +335,22 @@ public:
 	void insert(Node & node) noexcept;
 	void insert(Node & node, Node & hint) noexcept;
 
+	/**
+	 * @brief Inserts <node> into the tree, starting at a finger
+	 *
+	 * Inserts <node> into the tree. Instead of searching the insertion position
+	 * from the root, the search climbs up from <finger> until it reaches a node
+	 * that lies on the search path of <node> and has a rank at least as large
+	 * as the rank of <node>. Since the ranks are geometrically distributed, this
+	 * usually costs O(log d) if <node> is inserted d elements away from
+	 * <finger>, instead of O(log n).
+	 *
+	 * @param   Node  The node to be inserted.
+	 * @param   finger  An iterator into this tree. If it is end(), this is
+	 * equivalent to insert(<node>).
+	 */
+	void insert_near(Node & node, iterator<false> finger) noexcept;
+
 	/**
 	 * @brief Removes <node> from the tree
 	 *
@@ -318,6 +404,49 @@ public:
 	utilities::select_type_t<const iterator<reverse>, Node *, Options::stl_erase>
 	erase(const iterator<reverse> & it) CMP_NOEXCEPT(*it);
 
+	/**
+	 * @brief Removes all nodes in a key range from the tree
+	 *
+	 * Removes all nodes that are not less than <lo> but less than <hi>, i.e., the
+	 * range [lo, hi). Every node is handed to <callback> right after it has been
+	 * removed, so the owner of the nodes may e.g. free them there.
+	 *
+	 * Only the first node is searched for. From there on, the nodes are unlinked
+	 * one after the other. Since zipping takes expected O(1) time per removal,
+	 * removing k nodes costs expected O(log n + k).
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be removed.
+	 * @param hi    Anything comparable to a node. All removed nodes are less than
+	 * <hi>.
+	 * @param callback  A callable that is invoked as callback(Node &) for every
+	 * removed node.
+	 *
+	 * @return The number of removed nodes
+	 */
+	template <class Comparable, class Callback>
+	size_t erase_range(const Comparable & lo, const Comparable & hi,
+	                   Callback callback);
+	template <class Comparable>
+	size_t erase_range(const Comparable & lo, const Comparable & hi);
+
+	/**
+	 * @brief Moves all nodes in a key range into a new tree
+	 *
+	 * Removes all nodes in the range [lo, hi) from this tree (see erase_range())
+	 * and returns a tree containing exactly these nodes. Since the nodes are
+	 * appended to the new tree in order, this costs expected O(log n + k), too.
+	 *
+	 * @param lo    Anything comparable to a node. The first node not less than
+	 * <lo> is the first node to be moved.
+	 * @param hi    Anything comparable to a node. All moved nodes are less than
+	 * <hi>.
+	 *
+	 * @return A new tree containing the nodes of the range
+	 */
+	template <class Comparable>
+	MyClass extract_range(const Comparable & lo, const Comparable & hi);
+
 	// Debugging methods
 	void dbg_verify() const;
 	void dbg_print_rank_stats() const;
@@ -333,8 +462,19 @@ public:
 	void dump_to_dot(const std::string & filename) const;
 
 private:
+	using RankType =
+	    decltype(RankGetter::get_rank(std::declval<const Node &>()));
+
 	void unzip(Node & oldn, Node & newn) noexcept;
 	void zip(Node & old_root) noexcept;
+	// Inserts <node> somewhere below <current>, which must be on its search
+	// path and have a rank of at least <node_rank>.
+	void insert_below(Node & node, Node * current,
+	                  RankType node_rank) noexcept;
+	// Inserts <node>, which must not be less than any node in the tree.
+	// <largest> must be the last node on the right spine (or nullptr if the tree
+	// is empty). Returns the new last node on the right spine.
+	Node * append(Node & node, Node * largest) noexcept;
 
 	// Debugging methods
 	void dbg_verify_consistency(Node * sub_root, Node * lower_bound,
@@ -6,8 +6,11 @@
 #include "test_multi_rbtree.hpp"
 #include "test_rbtree.hpp"
 #include "test_ziptree.hpp"
+#include "test_concurrent_ziptree.hpp"
 #include "test_energy.hpp"
 #include "test_wbtree.hpp"
+#include "test_node_pool.hpp"
+#include "test_btree_index.hpp"
 
 int
 main(int argc, char ** argv)
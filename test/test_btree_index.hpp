@@ -0,0 +1,307 @@
+#ifndef TEST_BTREE_INDEX_HPP
+#define TEST_BTREE_INDEX_HPP
+
+#include "../src/btree_index.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace ygg {
+namespace testing {
+namespace btree_index {
+
+using namespace ygg;
+
+constexpr size_t BTREE_TESTSIZE = 5000;
+constexpr unsigned int BTREE_SEED = 4;
+
+class Node {
+public:
+	int data;
+
+	explicit Node(int data_in) : data(data_in){};
+};
+
+class NodeTraits : public BTreeIndexNodeTraits<Node> {
+public:
+	using key_type = int;
+
+	static int
+	get_key(const Node & n)
+	{
+		return n.data;
+	}
+};
+
+// Small nodes, such that the index becomes deep
+using SmallMultiOptions =
+    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::BTREE_NODE_KEYS<4>>;
+using MultiOptions = TreeOptions<TreeFlags::MULTIPLE>;
+using SmallOptions = TreeOptions<TreeFlags::BTREE_NODE_KEYS<4>>;
+
+template <class Index>
+void
+compare_to_reference(const Index & index, const std::multiset<int> & reference)
+{
+	ASSERT_EQ(index.size(), reference.size());
+	ASSERT_EQ(index.empty(), reference.empty());
+
+	auto ref_it = reference.begin();
+	for (const Node & n : index) {
+		ASSERT_TRUE(ref_it != reference.end());
+		ASSERT_EQ(n.data, *ref_it);
+		++ref_it;
+	}
+	ASSERT_TRUE(ref_it == reference.end());
+
+	auto ref_rit = reference.rbegin();
+	for (auto it = index.rbegin(); it != index.rend(); ++it) {
+		ASSERT_TRUE(ref_rit != reference.rend());
+		ASSERT_EQ(it->data, *ref_rit);
+		++ref_rit;
+	}
+	ASSERT_TRUE(ref_rit == reference.rend());
+}
+
+template <class Options>
+void
+run_insertion_test()
+{
+	BTreeIndex<Node, NodeTraits, Options> index;
+	std::multiset<int> reference;
+	std::mt19937 rng(BTREE_SEED);
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < BTREE_TESTSIZE; ++i) {
+		// Produce many duplicates
+		nodes.emplace_back(static_cast<int>(rng() % (BTREE_TESTSIZE / 4)));
+	}
+
+	for (auto & n : nodes) {
+		index.insert(n);
+		reference.insert(n.data);
+	}
+	index.dbg_verify();
+	ASSERT_GT(index.get_height(), 0u);
+	compare_to_reference(index, reference);
+
+	// Equal elements are in insertion order
+	for (auto it = index.begin(); it != index.end(); ++it) {
+		auto next = it;
+		++next;
+		if ((next != index.end()) && (next->data == it->data)) {
+			ASSERT_LT(&*it, &*next);
+		}
+	}
+
+	// Decrementing forward iterators
+	auto it = index.lower_bound(*reference.rbegin());
+	while (std::next(it) != index.end()) {
+		++it;
+	}
+	size_t steps = 0;
+	for (auto rit = index.rbegin(); rit != index.rend(); ++rit) {
+		ASSERT_EQ(&*it, &*rit);
+		if (it != index.begin()) {
+			--it;
+		}
+		steps++;
+	}
+	ASSERT_EQ(steps, BTREE_TESTSIZE);
+
+	index.clear();
+	index.dbg_verify();
+	ASSERT_TRUE(index.empty());
+	ASSERT_TRUE(index.begin() == index.end());
+}
+
+template <class Options>
+void
+run_search_test()
+{
+	BTreeIndex<Node, NodeTraits, Options> index;
+	std::multiset<int> reference;
+	std::mt19937 rng(BTREE_SEED);
+	const int max_value = static_cast<int>(BTREE_TESTSIZE / 4);
+
+	// Empty index
+	ASSERT_TRUE(index.find(0) == index.end());
+	ASSERT_TRUE(index.lower_bound(0) == index.end());
+	ASSERT_TRUE(index.upper_bound(0) == index.end());
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < BTREE_TESTSIZE; ++i) {
+		// Only even values
+		nodes.emplace_back(2 * static_cast<int>(rng() % (BTREE_TESTSIZE / 4)));
+	}
+	for (auto & n : nodes) {
+		index.insert(n);
+		reference.insert(n.data);
+	}
+
+	for (int q = -1; q <= 2 * max_value + 1; ++q) {
+		auto lb = index.lower_bound(q);
+		auto ref_lb = reference.lower_bound(q);
+		if (ref_lb == reference.end()) {
+			ASSERT_TRUE(lb == index.end());
+		} else {
+			ASSERT_EQ(lb->data, *ref_lb);
+			// It's the first of its kind
+			if (lb != index.begin()) {
+				ASSERT_LT(std::prev(lb)->data, q);
+			}
+		}
+
+		auto ub = index.upper_bound(q);
+		auto ref_ub = reference.upper_bound(q);
+		if (ref_ub == reference.end()) {
+			ASSERT_TRUE(ub == index.end());
+		} else {
+			ASSERT_EQ(ub->data, *ref_ub);
+			if (ub != index.begin()) {
+				ASSERT_LE(std::prev(ub)->data, q);
+			}
+		}
+
+		ASSERT_EQ(static_cast<size_t>(std::distance(lb, ub)),
+		          reference.count(q));
+
+		auto found = index.find(q);
+		if (reference.count(q) == 0) {
+			ASSERT_TRUE(found == index.end());
+		} else {
+			ASSERT_TRUE(found == lb);
+		}
+
+		// Nodes can be used as queries, too
+		Node query(q);
+		ASSERT_TRUE(index.lower_bound(query) == lb);
+		ASSERT_TRUE(index.upper_bound(query) == ub);
+	}
+
+	// Const versions
+	const auto & const_index = index;
+	auto const_it = const_index.find(nodes[0].data);
+	ASSERT_EQ(const_it->data, nodes[0].data);
+	ASSERT_TRUE(const_index.lower_bound(-1) == const_index.begin());
+	ASSERT_TRUE(const_index.upper_bound(2 * max_value) == const_index.end());
+}
+
+template <class Options>
+void
+run_removal_test()
+{
+	BTreeIndex<Node, NodeTraits, Options> index;
+	std::multiset<int> reference;
+	std::mt19937 rng(BTREE_SEED);
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < BTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(static_cast<int>(rng() % (BTREE_TESTSIZE / 4)));
+	}
+	for (auto & n : nodes) {
+		index.insert(n);
+		reference.insert(n.data);
+	}
+
+	std::vector<Node *> order;
+	for (auto & n : nodes) {
+		order.push_back(&n);
+	}
+	std::shuffle(order.begin(), order.end(), rng);
+
+	// Remove half, then re-insert a quarter
+	for (size_t i = 0; i < BTREE_TESTSIZE / 2; ++i) {
+		index.remove(*order[i]);
+		reference.erase(reference.find(order[i]->data));
+		if (i % 100 == 0) {
+			index.dbg_verify();
+		}
+	}
+	index.dbg_verify();
+	compare_to_reference(index, reference);
+
+	for (size_t i = 0; i < BTREE_TESTSIZE / 4; ++i) {
+		index.insert(*order[i]);
+		reference.insert(order[i]->data);
+	}
+	index.dbg_verify();
+	compare_to_reference(index, reference);
+
+	std::shuffle(order.begin(), order.begin() + BTREE_TESTSIZE / 4, rng);
+	for (size_t i = 0; i < BTREE_TESTSIZE / 4; ++i) {
+		index.remove(*order[i]);
+	}
+	for (size_t i = BTREE_TESTSIZE / 2; i < BTREE_TESTSIZE; ++i) {
+		index.remove(*order[i]);
+		if (i % 100 == 0) {
+			index.dbg_verify();
+		}
+	}
+
+	index.dbg_verify();
+	ASSERT_TRUE(index.empty());
+	ASSERT_EQ(index.get_height(), 0u);
+	ASSERT_TRUE(index.begin() == index.end());
+}
+
+TEST(BTreeIndexTest, InsertionTest)
+{
+	run_insertion_test<SmallMultiOptions>();
+	run_insertion_test<MultiOptions>();
+}
+
+TEST(BTreeIndexTest, SearchTest)
+{
+	run_search_test<SmallMultiOptions>();
+	run_search_test<MultiOptions>();
+}
+
+TEST(BTreeIndexTest, RemovalTest)
+{
+	run_removal_test<SmallMultiOptions>();
+	run_removal_test<MultiOptions>();
+}
+
+TEST(BTreeIndexTest, UniqueTest)
+{
+	BTreeIndex<Node, NodeTraits, SmallOptions> index;
+	std::set<int> reference;
+	std::mt19937 rng(BTREE_SEED);
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < BTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(static_cast<int>(rng() % (BTREE_TESTSIZE / 4)));
+	}
+
+	std::vector<Node *> inserted;
+	for (auto & n : nodes) {
+		index.insert(n);
+		if (reference.insert(n.data).second) {
+			inserted.push_back(&n);
+		}
+	}
+	index.dbg_verify();
+	ASSERT_EQ(index.size(), reference.size());
+
+	// The first inserted node of every key is present
+	for (Node * n : inserted) {
+		ASSERT_EQ(&*index.find(n->data), n);
+	}
+
+	std::shuffle(inserted.begin(), inserted.end(), rng);
+	for (Node * n : inserted) {
+		index.remove(*n);
+	}
+	index.dbg_verify();
+	ASSERT_TRUE(index.empty());
+}
+
+} // namespace btree_index
+} // namespace testing
+} // namespace ygg
+
+#endif // TEST_BTREE_INDEX_HPP
@@ -0,0 +1,249 @@
+#ifndef TEST_CONCURRENT_ZIPTREE_HPP
+#define TEST_CONCURRENT_ZIPTREE_HPP
+
+#include "../src/concurrent_ziptree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ygg {
+namespace testing {
+namespace concurrent_ziptree {
+
+using namespace ygg;
+
+constexpr size_t CZIPTREE_TESTSIZE = 5000;
+constexpr size_t CZIPTREE_THREADS = 8;
+constexpr size_t CZIPTREE_SEED = 4;
+
+class Node;
+using Options = ygg::TreeOptions<
+    TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+    TreeFlags::ZTREE_USE_HASH, TreeFlags::ZTREE_RANK_HASH_MIX,
+    TreeFlags::ZTREE_HASHER_TYPE<ZTreeAddressHasher<Node>>>;
+
+class Node : public ConcurrentZTreeNodeBase<Node, Options> {
+public:
+	int data;
+	size_t reclaimed;
+
+	Node() : data(0), reclaimed(0){};
+	explicit Node(int data_in) : data(data_in), reclaimed(0){};
+
+	bool
+	operator<(const Node & other) const
+	{
+		return this->data < other.data;
+	}
+};
+
+bool
+operator<(const Node & lhs, int rhs)
+{
+	return lhs.data < rhs;
+}
+bool
+operator<(int lhs, const Node & rhs)
+{
+	return lhs < rhs.data;
+}
+
+class NodeTraits : public ConcurrentZTreeDefaultNodeTraits<Node> {
+public:
+	void
+	reclaimable(Node * node) const noexcept
+	{
+		node->reclaimed++;
+	}
+};
+
+using Tree = ConcurrentZTree<Node, NodeTraits, Options>;
+
+TEST(ConcurrentZipTreeTest, InsertionAndDeletionTest)
+{
+	Tree tree;
+	std::mt19937 rng(CZIPTREE_SEED);
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE; ++i) {
+		// Produce many duplicates
+		nodes.emplace_back(static_cast<int>(rng() % (CZIPTREE_TESTSIZE / 4)));
+	}
+
+	ASSERT_TRUE(tree.empty());
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+	tree.dbg_verify();
+	ASSERT_EQ(tree.size(), CZIPTREE_TESTSIZE);
+
+	for (auto & n : nodes) {
+		Node * found = tree.find(n.data);
+		ASSERT_NE(found, nullptr);
+		ASSERT_EQ(found->data, n.data);
+	}
+	ASSERT_EQ(tree.find(-1), nullptr);
+
+	std::vector<size_t> indices(CZIPTREE_TESTSIZE);
+	std::iota(indices.begin(), indices.end(), 0);
+	std::shuffle(indices.begin(), indices.end(), rng);
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE / 2; ++i) {
+		tree.remove(nodes[indices[i]]);
+	}
+	tree.dbg_verify();
+	ASSERT_EQ(tree.size(), CZIPTREE_TESTSIZE - CZIPTREE_TESTSIZE / 2);
+
+	for (size_t i = CZIPTREE_TESTSIZE / 2; i < CZIPTREE_TESTSIZE; ++i) {
+		tree.remove(nodes[indices[i]]);
+		if (i % 100 == 0) {
+			tree.dbg_verify();
+		}
+	}
+	ASSERT_TRUE(tree.empty());
+}
+
+TEST(ConcurrentZipTreeTest, ConcurrentInsertionTest)
+{
+	Tree tree;
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE * CZIPTREE_THREADS; ++i) {
+		nodes.emplace_back(static_cast<int>(i));
+	}
+	std::shuffle(nodes.begin(), nodes.end(), std::mt19937(CZIPTREE_SEED));
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < CZIPTREE_THREADS; ++t) {
+		threads.emplace_back([&, t]() {
+			for (size_t i = t; i < nodes.size(); i += CZIPTREE_THREADS) {
+				tree.insert(nodes[i]);
+			}
+		});
+	}
+	for (auto & thread : threads) {
+		thread.join();
+	}
+
+	tree.dbg_verify();
+	ASSERT_EQ(tree.size(), nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		Node * found = tree.find(static_cast<int>(i));
+		ASSERT_NE(found, nullptr);
+		ASSERT_EQ(found->data, static_cast<int>(i));
+	}
+}
+
+TEST(ConcurrentZipTreeTest, ConcurrentMixedTest)
+{
+	Tree tree;
+
+	// The first half is inserted before and never touched by the threads, so
+	// those must always be found.
+	std::vector<Node> fixed_nodes;
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE; ++i) {
+		fixed_nodes.emplace_back(static_cast<int>(2 * i));
+		nodes.emplace_back(static_cast<int>(2 * i + 1));
+	}
+	for (auto & n : fixed_nodes) {
+		tree.insert(n);
+	}
+
+	std::atomic<size_t> missing(0);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < CZIPTREE_THREADS; ++t) {
+		threads.emplace_back([&, t]() {
+			std::mt19937 rng(static_cast<unsigned int>(CZIPTREE_SEED + t));
+			auto handle = tree.register_thread();
+
+			for (size_t round = 0; round < 5; ++round) {
+				for (size_t i = t; i < nodes.size(); i += CZIPTREE_THREADS) {
+					tree.insert(nodes[i]);
+
+					auto guard = handle.pin();
+					int query = static_cast<int>(2 * (rng() % CZIPTREE_TESTSIZE));
+					Node * found = tree.find(query);
+					if ((found == nullptr) || (found->data != query)) {
+						missing++;
+					}
+				}
+				for (size_t i = t; i < nodes.size(); i += CZIPTREE_THREADS) {
+					tree.remove(nodes[i], handle);
+				}
+			}
+		});
+	}
+	for (auto & thread : threads) {
+		thread.join();
+	}
+
+	ASSERT_EQ(missing.load(), 0u);
+	tree.dbg_verify();
+	ASSERT_EQ(tree.size(), fixed_nodes.size());
+
+	// Every removal is reported exactly once
+	tree.reclaim_all();
+	for (auto & n : nodes) {
+		ASSERT_EQ(n.reclaimed, 5u);
+	}
+}
+
+TEST(ConcurrentZipTreeTest, ReclamationTest)
+{
+	Tree tree;
+
+	std::vector<Node> nodes;
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(static_cast<int>(i));
+	}
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+
+	// Handles do not care about the thread using them, thus we can simulate
+	// a reader and a writer thread deterministically.
+	auto reader = tree.register_thread();
+	auto writer = tree.register_thread();
+
+	Node * held;
+	{
+		auto reader_guard = reader.pin();
+		held = tree.find(42);
+		ASSERT_EQ(held, &nodes[42]);
+
+		tree.remove(*held, writer);
+		for (size_t i = 0; i < CZIPTREE_TESTSIZE / 2; ++i) {
+			if (i != 42) {
+				auto writer_guard = writer.pin();
+				tree.remove(nodes[i], writer);
+			}
+		}
+
+		// The reader might still use the node
+		ASSERT_EQ(held->reclaimed, 0u);
+	}
+
+	// Once the reader is gone, the writer reclaims the node eventually
+	for (size_t i = 0; i < 10 * 64; ++i) {
+		auto writer_guard = writer.pin();
+	}
+	ASSERT_EQ(held->reclaimed, 1u);
+
+	tree.reclaim_all();
+	for (size_t i = 0; i < CZIPTREE_TESTSIZE; ++i) {
+		ASSERT_EQ(nodes[i].reclaimed, (i < CZIPTREE_TESTSIZE / 2) ? 1u : 0u);
+	}
+	tree.dbg_verify();
+	ASSERT_EQ(tree.size(), CZIPTREE_TESTSIZE - CZIPTREE_TESTSIZE / 2);
+}
+
+} // namespace concurrent_ziptree
+} // namespace testing
+} // namespace ygg
+
+#endif // TEST_CONCURRENT_ZIPTREE_HPP
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <random>
+#include <set>
 #include <vector>
 
 #include "../src/energy.hpp"
@@ -323,6 +324,354 @@ TEST(EnergyTreeTest, ComprehensiveTest)
 	}
 }
 
+TEST(EnergyTreeTest, OrderStatisticsTest)
+{
+	auto tree = EnergyTree<Node>();
+
+	std::mt19937 rng(4); // chosen by fair xkcd
+	std::uniform_int_distribution<int> uni(0, ETREE_TESTSIZE);
+
+	std::vector<Node> nodes(ETREE_TESTSIZE);
+	std::vector<int> values;
+	for (unsigned int i = 0; i < ETREE_TESTSIZE; ++i) {
+		nodes[i] = Node(uni(rng));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+	ASSERT_TRUE(tree.verify_integrity());
+
+	// select() and rank() are inverse to each other
+	size_t k = 0;
+	for (const auto & n : tree) {
+		ASSERT_EQ(tree.select(k)->data, values[k]);
+		ASSERT_EQ(&(*tree.select(k)), &n);
+		ASSERT_EQ(tree.rank(n), k);
+		k++;
+	}
+	ASSERT_EQ(tree.select(ETREE_TESTSIZE), tree.end());
+
+	for (unsigned int i = 0; i < 100; ++i) {
+		int lower = uni(rng);
+		int upper = uni(rng);
+		size_t expected = 0;
+		if (lower <= upper) {
+			expected = static_cast<size_t>(
+			    std::upper_bound(values.begin(), values.end(), upper) -
+			    std::lower_bound(values.begin(), values.end(), lower));
+		}
+		ASSERT_EQ(tree.count_range(lower, upper), expected);
+	}
+
+	// Iterator jumps in both directions
+	std::uniform_int_distribution<size_t> ranks(0, ETREE_TESTSIZE - 1);
+	for (unsigned int i = 0; i < 1000; ++i) {
+		size_t from = ranks(rng);
+		size_t to = ranks(rng);
+
+		auto it = tree.select(from);
+		if (to >= from) {
+			it += to - from;
+		} else {
+			it -= from - to;
+		}
+		ASSERT_EQ(it->data, values[to]);
+		ASSERT_EQ(tree.select(from) + (ETREE_TESTSIZE - from), tree.end());
+
+		auto rit = tree.rbegin();
+		rit += ETREE_TESTSIZE - 1 - to;
+		ASSERT_EQ(rit->data, values[to]);
+	}
+}
+
+TEST(EnergyTreeTest, EqualRangeTest)
+{
+	auto tree = EnergyTree<Node>();
+
+	std::mt19937 rng(4); // chosen by fair xkcd
+	std::uniform_int_distribution<int> uni(0, ETREE_TESTSIZE / 10);
+
+	std::vector<Node> nodes(ETREE_TESTSIZE);
+	std::vector<int> values;
+	for (unsigned int i = 0; i < ETREE_TESTSIZE; ++i) {
+		nodes[i] = Node(uni(rng));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	for (int query = -1; query <= ETREE_TESTSIZE / 10 + 1; ++query) {
+		auto expected = std::equal_range(values.begin(), values.end(), query);
+		size_t expected_count =
+		    static_cast<size_t>(expected.second - expected.first);
+		ASSERT_EQ(tree.count(query), expected_count);
+
+		auto range = tree.equal_range(query);
+		size_t seen = 0;
+		for (auto it = range.first; it != range.second; ++it) {
+			ASSERT_EQ(it->data, query);
+			seen++;
+		}
+		ASSERT_EQ(seen, expected_count);
+	}
+}
+
+TEST(EnergyTreeTest, RangeEraseTest)
+{
+	auto tree = EnergyTree<Node>();
+
+	std::mt19937 rng(4); // chosen by fair xkcd
+	std::uniform_int_distribution<int> uni(0, ETREE_TESTSIZE / 2);
+
+	std::vector<Node> nodes(ETREE_TESTSIZE);
+	std::vector<int> values;
+	for (unsigned int i = 0; i < ETREE_TESTSIZE; ++i) {
+		nodes[i] = Node(uni(rng));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	auto count_in = [&](int lo, int hi) {
+		return static_cast<size_t>(
+		    std::lower_bound(values.begin(), values.end(), hi) -
+		    std::lower_bound(values.begin(), values.end(), lo));
+	};
+
+	// Erase a range, handing every node to the callback
+	size_t expected = count_in(100, 300);
+	std::vector<Node *> erased;
+	size_t count =
+	    tree.erase_range(100, 300, [&](Node & n) { erased.push_back(&n); });
+	ASSERT_EQ(count, expected);
+	ASSERT_EQ(erased.size(), expected);
+	for (auto n : erased) {
+		ASSERT_TRUE((n->data >= 100) && (n->data < 300));
+	}
+	ASSERT_EQ(tree.size(), ETREE_TESTSIZE - expected);
+	ASSERT_EQ(tree.lower_bound(100), tree.lower_bound(300));
+	ASSERT_TRUE(tree.verify_integrity());
+
+	// Empty range
+	ASSERT_EQ(tree.erase_range(200, 250), 0u);
+	ASSERT_EQ(tree.erase_range(500, 400), 0u);
+
+	// Extract a range into a new tree
+	size_t remaining = tree.size();
+	expected = count_in(400, 1700);
+	auto extracted = tree.extract_range(400, 1700);
+	ASSERT_EQ(extracted.size(), expected);
+	ASSERT_EQ(tree.size(), remaining - expected);
+	ASSERT_TRUE(extracted.verify_integrity());
+	ASSERT_TRUE(tree.verify_integrity());
+	ASSERT_TRUE(std::is_sorted(extracted.begin(), extracted.end()));
+	size_t seen = 0;
+	for (auto & n : extracted) {
+		ASSERT_TRUE((n.data >= 400) && (n.data < 1700));
+		seen++;
+	}
+	ASSERT_EQ(seen, expected);
+	ASSERT_TRUE(tree.extract_range(400, 1700).empty());
+
+	// Random ranges, which cut the tree at random places
+	for (unsigned int i = 0; i < 20; ++i) {
+		int lo = uni(rng);
+		int hi = lo + static_cast<int>(rng() % 50);
+		size_t in_tree = 0;
+		for (auto & n : tree) {
+			if ((n.data >= lo) && (n.data < hi)) {
+				in_tree++;
+			}
+		}
+
+		remaining = tree.size();
+		ASSERT_EQ(tree.erase_range(lo, hi), in_tree);
+		ASSERT_EQ(tree.size(), remaining - in_tree);
+		ASSERT_EQ(tree.lower_bound(lo), tree.lower_bound(hi));
+		ASSERT_TRUE(tree.verify_integrity());
+	}
+
+	// Everything that remains, up to the end
+	remaining = tree.size();
+	ASSERT_EQ(tree.erase_range(-1, ETREE_TESTSIZE), remaining);
+	ASSERT_TRUE(tree.empty());
+}
+
+template <class Options>
+class OptionsNode
+    : public EnergyTreeNodeBase<OptionsNode<Options>, Options> {
+public:
+	int data;
+
+	OptionsNode() : data(0){};
+	explicit OptionsNode(int data_in) : data(data_in){};
+
+	bool
+	operator<(const OptionsNode & other) const
+	{
+		return this->data < other.data;
+	}
+};
+
+template <class Options>
+void
+random_operations_test()
+{
+	using ONode = OptionsNode<Options>;
+	auto tree = EnergyTree<ONode, Options>();
+
+	std::mt19937 rng(4); // chosen by fair xkcd
+	std::uniform_int_distribution<int> uni(0, 10 * ETREE_TESTSIZE);
+
+	std::vector<ONode> nodes(2 * ETREE_TESTSIZE);
+	std::multiset<int> values;
+	for (unsigned int i = 0; i < 2 * ETREE_TESTSIZE; ++i) {
+		nodes[i] = ONode(uni(rng));
+	}
+
+	// Grow to a large tree, then alternate between removing and re-inserting
+	for (unsigned int i = 0; i < 2 * ETREE_TESTSIZE; ++i) {
+		tree.insert(nodes[i]);
+		values.insert(nodes[i].data);
+	}
+	ASSERT_TRUE(tree.verify_integrity());
+
+	for (unsigned int round = 0; round < 4; ++round) {
+		for (unsigned int i = round % 2; i < 2 * ETREE_TESTSIZE; i += 2) {
+			tree.remove(nodes[i]);
+			values.erase(values.find(nodes[i].data));
+		}
+		ASSERT_TRUE(tree.verify_integrity());
+
+		for (unsigned int i = round % 2; i < 2 * ETREE_TESTSIZE; i += 2) {
+			tree.insert(nodes[i]);
+			values.insert(nodes[i].data);
+		}
+		ASSERT_TRUE(tree.verify_integrity());
+
+		auto value_it = values.begin();
+		for (const auto & n : tree) {
+			ASSERT_EQ(n.data, *value_it);
+			value_it++;
+		}
+		ASSERT_EQ(value_it, values.end());
+	}
+
+	// Once all scheduled work is done, the energy invariant must hold again
+	for (unsigned int i = 0; i < ETREE_TESTSIZE; ++i) {
+		ONode & n = *tree.begin();
+		tree.remove(n);
+		tree.insert(n);
+	}
+	ASSERT_TRUE(tree.verify_integrity());
+}
+
+TEST(EnergyTreeTest, ParallelRebuildTest)
+{
+	random_operations_test<
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::ETREE_PARALLEL_REBUILD<64>>>();
+}
+
+TEST(EnergyTreeTest, NestedParallelRebuildTest)
+{
+	// Fork independently of the number of hardware threads, such that the
+	// forks nest at least two levels deep
+	random_operations_test<
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::ETREE_PARALLEL_REBUILD<64>,
+	                TreeFlags::ETREE_PARALLEL_REBUILD_THREADS<3>>>();
+	random_operations_test<
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::ETREE_PARALLEL_REBUILD<64>,
+	                TreeFlags::ETREE_PARALLEL_REBUILD_THREADS<8>>>();
+}
+
+TEST(EnergyTreeTest, IncrementalRebuildTest)
+{
+	random_operations_test<
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::ETREE_INCREMENTAL_REBUILD<16>>>();
+}
+
+TEST(EnergyTreeTest, IncrementalRebuildEnergyTest)
+{
+	using Options =
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::ETREE_INCREMENTAL_REBUILD<8>>;
+	using ONode = OptionsNode<Options>;
+	auto tree = EnergyTree<ONode, Options>();
+
+	std::mt19937 rng(4);
+	std::uniform_int_distribution<int> uni(0, 10 * ETREE_TESTSIZE);
+	std::uniform_int_distribution<unsigned int> op_distr(0, 2);
+
+	std::vector<ONode> nodes(ETREE_TESTSIZE / 10);
+	std::vector<ONode *> inserted;
+	std::vector<ONode *> removed;
+	for (auto & n : nodes) {
+		n = ONode(uni(rng));
+		removed.push_back(&n);
+	}
+
+	/* Random insertions and removals. Whenever no rebuild work is scheduled,
+	 * verify_integrity() also checks the energy of every node. */
+	for (unsigned int i = 0; i < 2 * ETREE_TESTSIZE; ++i) {
+		bool do_insert = removed.empty() ? false
+		                 : inserted.empty() ? true
+		                                    : (op_distr(rng) > 0);
+		auto & from = do_insert ? removed : inserted;
+		auto & to = do_insert ? inserted : removed;
+		std::uniform_int_distribution<size_t> pick(0, from.size() - 1);
+		size_t index = pick(rng);
+		ONode * n = from[index];
+		from[index] = from.back();
+		from.pop_back();
+		to.push_back(n);
+
+		if (do_insert) {
+			tree.insert(*n);
+		} else {
+			tree.remove(*n);
+		}
+		ASSERT_TRUE(tree.verify_integrity());
+	}
+}
+
+TEST(EnergyTreeTest, StatisticsTest)
+{
+	using Options =
+	    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+	                TreeFlags::COLLECT_STATISTICS>;
+	using ONode = OptionsNode<Options>;
+	auto tree = EnergyTree<ONode, Options>();
+
+	std::vector<ONode> nodes;
+	for (int i = 0; i < ETREE_TESTSIZE; ++i) {
+		nodes.emplace_back(i);
+	}
+
+	// Linear insertion unbalances the tree, which must trigger rebuilds
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+	ASSERT_TRUE(tree.verify_integrity());
+
+	auto counters = tree.get_statistics();
+	ASSERT_GT(counters.rebuilds, 0u);
+	ASSERT_GT(counters.comparisons, 0u);
+	ASSERT_EQ(counters.zips, 0u);
+
+	auto shape = tree.collect_shape();
+	ASSERT_EQ(shape.node_count, static_cast<size_t>(ETREE_TESTSIZE));
+	ASSERT_EQ(shape.depth_histogram[0], 1u);
+	ASSERT_EQ(shape.depth_histogram.size(), shape.max_depth + 1);
+
+	tree.reset_statistics();
+	ASSERT_EQ(tree.get_statistics().rebuilds, 0u);
+	ASSERT_EQ(tree.get_statistics().comparisons, 0u);
+}
+
 } // namespace energy
 } // namespace testing
 } // namespace ygg
@@ -4,6 +4,7 @@
 #include "../src/intervaltree.hpp"
 #include "randomizer.hpp"
 
+#include <set>
 #include <unordered_set>
 
 namespace ygg {
@@ -519,6 +520,86 @@ TEST(ITreeTest, FastFindTest)
 	}
 }
 
+TEST(ITreeTest, ContainmentAndNearestQueryTest)
+{
+	auto tree = IntervalTree<ITNode, MyNodeTraits<ITNode>>();
+
+	ITNode nodes[IT_TESTSIZE];
+	std::mt19937 rng(4); // chosen by fair xkcd
+
+	for (unsigned int i = 0; i < IT_TESTSIZE; ++i) {
+		std::uniform_int_distribution<unsigned int> lower_distr(0, 100000);
+		std::uniform_int_distribution<unsigned int> length_distr(0, 2000);
+		unsigned int lower = lower_distr(rng);
+		unsigned int upper = lower + length_distr(rng);
+
+		nodes[i] = ITNode(lower, upper, static_cast<int>(i));
+		tree.insert(nodes[i]);
+	}
+
+	ASSERT_TRUE(tree.verify_integrity());
+
+	for (unsigned int i = 0; i < IT_TESTSIZE; ++i) {
+		std::uniform_int_distribution<unsigned int> lower_distr(0, 100000);
+		std::uniform_int_distribution<unsigned int> length_distr(0, 4000);
+		unsigned int q_lower = lower_distr(rng);
+		unsigned int q_upper = q_lower + length_distr(rng);
+		Interval q{q_lower, q_upper};
+
+		std::set<const ITNode *> expected_enclosing;
+		std::set<const ITNode *> expected_contained;
+		for (const auto & n : nodes) {
+			if ((n.lower <= q_lower) && (n.upper >= q_upper)) {
+				expected_enclosing.insert(&n);
+			}
+			if ((n.lower >= q_lower) && (n.upper <= q_upper)) {
+				expected_contained.insert(&n);
+			}
+		}
+
+		std::set<const ITNode *> found;
+		unsigned int last_lower = 0;
+		for (const auto & n : tree.query_enclosing(q)) {
+			ASSERT_LE(last_lower, n.lower);
+			last_lower = n.lower;
+			found.insert(&n);
+		}
+		ASSERT_EQ(found, expected_enclosing);
+
+		found.clear();
+		last_lower = 0;
+		for (const auto & n : tree.query_contained(q)) {
+			ASSERT_LE(last_lower, n.lower);
+			last_lower = n.lower;
+			found.insert(&n);
+		}
+		ASSERT_EQ(found, expected_contained);
+
+		// The nearest interval must have the minimum distance
+		unsigned int point = q_lower;
+		auto distance = [&](const ITNode & n) {
+			if (point < n.lower) {
+				return n.lower - point;
+			} else if (n.upper < point) {
+				return point - n.upper;
+			} else {
+				return 0u;
+			}
+		};
+		unsigned int min_distance = std::numeric_limits<unsigned int>::max();
+		for (const auto & n : nodes) {
+			min_distance = std::min(min_distance, distance(n));
+		}
+
+		auto nearest = tree.nearest(point);
+		ASSERT_NE(nearest, tree.end());
+		ASSERT_EQ(distance(*nearest), min_distance);
+	}
+
+	auto empty_tree = IntervalTree<ITNode, MyNodeTraits<ITNode>>();
+	ASSERT_EQ(empty_tree.nearest(5), empty_tree.end());
+}
+
 } // namespace intervaltree
 } // namespace testing
 } // namespace ygg
@@ -7,6 +7,8 @@
 
 #include "../src/list.hpp"
 
+#include <random>
+
 namespace ygg {
 namespace testing {
 namespace list {
@@ -18,6 +20,13 @@ using namespace ygg;
 class LNode : public ListNodeBase<LNode> {
 public:
   int data;
+  int sub_data;
+
+  bool
+  operator<(const LNode & other) const
+  {
+    return this->data < other.data;
+  }
 };
 
 using MyList = List<LNode>;
@@ -92,6 +101,135 @@ TEST(ListTest, ComprehensiveTest)
   ASSERT_TRUE(l.empty());
 }
 
+TEST(ListTest, RemoveRangeTest)
+{
+  LNode nodes[LIST_TESTSIZE];
+  MyList l;
+
+  for (unsigned int i = 0; i < LIST_TESTSIZE; ++i) {
+    nodes[i].data = static_cast<int>(i);
+    l.insert(nullptr, &nodes[i]);
+  }
+
+  // Middle, front, back
+  l.remove_range(&nodes[100], &nodes[200]);
+  l.remove_range(&nodes[0], &nodes[10]);
+  l.remove_range(&nodes[LIST_TESTSIZE - 10], nullptr);
+  l.remove_range(&nodes[500], &nodes[500]);
+  ASSERT_EQ(l.size(), LIST_TESTSIZE - 120);
+
+  int expected = 10;
+  for (auto & n : l) {
+    if (expected == 100) {
+      expected = 200;
+    }
+    ASSERT_EQ(n.data, expected++);
+  }
+  ASSERT_EQ(expected, LIST_TESTSIZE - 10);
+  ASSERT_EQ(l.back()->data, LIST_TESTSIZE - 11);
+
+  l.remove_range(&*l.begin(), nullptr);
+  ASSERT_TRUE(l.empty());
+  ASSERT_EQ(l.size(), 0);
+}
+
+TEST(ListTest, SpliceTest)
+{
+  LNode nodes[LIST_TESTSIZE];
+  MyList l1;
+  MyList l2;
+
+  for (unsigned int i = 0; i < LIST_TESTSIZE; ++i) {
+    nodes[i].data = static_cast<int>(i);
+    if (i < LIST_TESTSIZE / 2) {
+      l1.insert(nullptr, &nodes[i]);
+    } else {
+      l2.insert(nullptr, &nodes[i]);
+    }
+  }
+
+  // Move the first 100 of l2 to the end of l1
+  l1.splice(nullptr, l2, &nodes[LIST_TESTSIZE / 2],
+            &nodes[LIST_TESTSIZE / 2 + 100]);
+  ASSERT_EQ(l1.size(), LIST_TESTSIZE / 2 + 100);
+  ASSERT_EQ(l2.size(), LIST_TESTSIZE / 2 - 100);
+
+  // Move the rest of l2 to the front of l1
+  l1.splice(&nodes[0], l2, &nodes[LIST_TESTSIZE / 2 + 100], nullptr);
+  ASSERT_TRUE(l2.empty());
+  ASSERT_EQ(l2.size(), 0);
+  ASSERT_EQ(l1.size(), LIST_TESTSIZE);
+
+  // Rotate it back into order within the same list
+  l1.splice(nullptr, l1, &nodes[LIST_TESTSIZE / 2 + 100], &nodes[0]);
+  ASSERT_EQ(l1.size(), LIST_TESTSIZE);
+
+  int expected = 0;
+  for (auto & n : l1) {
+    ASSERT_EQ(n.data, expected++);
+  }
+  ASSERT_EQ(expected, LIST_TESTSIZE);
+
+  // Whole-list splice, and walk backwards
+  l2.splice(nullptr, l1);
+  ASSERT_TRUE(l1.empty());
+  ASSERT_EQ(l2.size(), LIST_TESTSIZE);
+  for (auto it = l2.back(); it != l2.end(); --it) {
+    ASSERT_EQ(it->data, --expected);
+  }
+  ASSERT_EQ(expected, 0);
+}
+
+TEST(ListTest, SortTest)
+{
+  LNode nodes[LIST_TESTSIZE];
+  MyList l;
+
+  ASSERT_TRUE(l.empty());
+  l.sort();
+  ASSERT_TRUE(l.empty());
+
+  std::mt19937 rng(4);
+  for (unsigned int i = 0; i < LIST_TESTSIZE; ++i) {
+    // Produce duplicates
+    nodes[i].data = static_cast<int>(rng() % (LIST_TESTSIZE / 10));
+    nodes[i].sub_data = static_cast<int>(i);
+    l.insert(nullptr, &nodes[i]);
+  }
+
+  l.sort();
+  ASSERT_EQ(l.size(), LIST_TESTSIZE);
+
+  const LNode * prev = nullptr;
+  size_t count = 0;
+  for (auto & n : l) {
+    if (prev != nullptr) {
+      ASSERT_LE(prev->data, n.data);
+      if (prev->data == n.data) {
+        // Stable
+        ASSERT_LT(prev->sub_data, n.sub_data);
+      }
+    }
+    ASSERT_EQ(n._l_prev, prev);
+    prev = &n;
+    count++;
+  }
+  ASSERT_EQ(count, LIST_TESTSIZE);
+  ASSERT_EQ(&*l.back(), prev);
+
+  // Sorting descending
+  l.sort([](const LNode & lhs, const LNode & rhs) {
+    return lhs.data > rhs.data;
+  });
+  prev = nullptr;
+  for (auto & n : l) {
+    if (prev != nullptr) {
+      ASSERT_GE(prev->data, n.data);
+    }
+    prev = &n;
+  }
+}
+
 } // namespace list
 } // namespace testing
 } // namespace ygg
@@ -0,0 +1,265 @@
+#ifndef TEST_NODE_POOL_HPP
+#define TEST_NODE_POOL_HPP
+
+#include "../src/concurrent_ziptree.hpp"
+#include "../src/node_pool.hpp"
+#include "../src/rbtree.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ygg {
+namespace testing {
+namespace node_pool {
+
+using namespace ygg;
+
+constexpr size_t POOL_TESTSIZE = 20000;
+constexpr size_t POOL_THREADS = 4;
+constexpr unsigned int POOL_SEED = 4;
+
+// Small slabs, such that the tests span many of them
+using PoolOptions = TreeOptions<TreeFlags::POOL_SLAB_SIZE<(1 << 14)>>;
+
+class Node : public RBTreeNodeBase<Node, TreeOptions<TreeFlags::MULTIPLE>> {
+public:
+	int data;
+	static size_t alive;
+
+	explicit Node(int data_in) : data(data_in) { alive++; }
+	~Node() { alive--; }
+
+	bool
+	operator<(const Node & other) const
+	{
+		return this->data < other.data;
+	}
+};
+size_t Node::alive = 0;
+
+using Pool = NodePool<Node, PoolOptions>;
+
+TEST(NodePoolTest, AllocationTest)
+{
+	Pool pool;
+	RBTree<Node, RBDefaultNodeTraits, TreeOptions<TreeFlags::MULTIPLE>> tree;
+	std::vector<Node *> nodes;
+
+	for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+		Node * n = pool.allocate(static_cast<int>(i));
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(n) % alignof(Node), 0u);
+		ASSERT_EQ(n->data, static_cast<int>(i));
+		nodes.push_back(n);
+		tree.insert(*n);
+	}
+	ASSERT_EQ(Node::alive, POOL_TESTSIZE);
+	ASSERT_GE(pool.capacity(), POOL_TESTSIZE);
+	tree.dbg_verify();
+
+	// All distinct
+	std::set<Node *> distinct(nodes.begin(), nodes.end());
+	ASSERT_EQ(distinct.size(), POOL_TESTSIZE);
+
+	// Nodes allocated one after the other are adjacent within a slab
+	size_t adjacent = 0;
+	for (size_t i = 1; i < POOL_TESTSIZE; ++i) {
+		if (nodes[i] == nodes[i - 1] + 1) {
+			adjacent++;
+		}
+	}
+	ASSERT_GE(adjacent, POOL_TESTSIZE - pool.capacity() / 10);
+
+	size_t capacity = pool.capacity();
+	for (auto n : nodes) {
+		tree.remove(*n);
+		pool.deallocate(n);
+	}
+	ASSERT_EQ(Node::alive, 0u);
+	ASSERT_TRUE(tree.empty());
+
+	// Memory is reused
+	for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+		nodes[i] = pool.allocate(static_cast<int>(i));
+	}
+	ASSERT_EQ(pool.capacity(), capacity);
+	for (auto n : nodes) {
+		Pool::release(n);
+	}
+	ASSERT_EQ(Node::alive, 0u);
+}
+
+TEST(NodePoolTest, AddressOrderTest)
+{
+	Pool pool;
+	std::mt19937 rng(POOL_SEED);
+	std::vector<Node *> nodes;
+
+	for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+		nodes.push_back(pool.allocate(static_cast<int>(i)));
+	}
+
+	// Free half of the nodes in random order
+	std::shuffle(nodes.begin(), nodes.end(), rng);
+	std::vector<Node *> freed(nodes.begin(), nodes.begin() + POOL_TESTSIZE / 2);
+	nodes.erase(nodes.begin(), nodes.begin() + POOL_TESTSIZE / 2);
+	for (auto n : freed) {
+		pool.deallocate(n);
+	}
+
+	// The freed slots are reused from the lowest address upwards
+	std::sort(freed.begin(), freed.end(), std::less<Node *>());
+	for (size_t i = 0; i < freed.size(); ++i) {
+		Node * n = pool.allocate(static_cast<int>(i));
+		ASSERT_EQ(n, freed[i]);
+		nodes.push_back(n);
+	}
+
+	// Interleaved frees and allocations, as in a tree in its steady state
+	std::shuffle(nodes.begin(), nodes.end(), rng);
+	std::set<Node *> free_slots(nodes.begin(), nodes.begin() + 1000);
+	nodes.erase(nodes.begin(), nodes.begin() + 1000);
+	for (Node * slot : free_slots) {
+		pool.deallocate(slot);
+	}
+	std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+	for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+		size_t index = pick(rng);
+		free_slots.insert(nodes[index]);
+		pool.deallocate(nodes[index]);
+
+		nodes[index] = pool.allocate(static_cast<int>(i));
+		ASSERT_EQ(nodes[index], *free_slots.begin());
+		free_slots.erase(free_slots.begin());
+	}
+	for (Node * slot : free_slots) {
+		nodes.push_back(pool.allocate(0));
+		ASSERT_EQ(nodes.back(), slot);
+	}
+
+	// Same via a thread cache
+	auto cache = pool.register_thread();
+	std::shuffle(nodes.begin(), nodes.end(), rng);
+	freed.assign(nodes.begin(), nodes.begin() + 100);
+	nodes.erase(nodes.begin(), nodes.begin() + 100);
+	for (auto n : freed) {
+		cache.deallocate(n);
+	}
+	std::sort(freed.begin(), freed.end(), std::less<Node *>());
+	for (size_t i = 0; i < freed.size(); ++i) {
+		Node * n = cache.allocate(static_cast<int>(i));
+		nodes.push_back(n);
+		ASSERT_EQ(n, freed[i]);
+	}
+
+	for (auto n : nodes) {
+		cache.deallocate(n);
+	}
+	ASSERT_EQ(Node::alive, 0u);
+}
+
+TEST(NodePoolTest, ThreadCacheTest)
+{
+	Pool pool;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<Node *>> allocated(POOL_THREADS);
+
+	for (size_t t = 0; t < POOL_THREADS; ++t) {
+		threads.emplace_back([&, t]() {
+			auto cache = pool.register_thread();
+			std::mt19937 rng(static_cast<unsigned int>(POOL_SEED + t));
+
+			for (size_t round = 0; round < 5; ++round) {
+				for (size_t i = 0; i < POOL_TESTSIZE / POOL_THREADS; ++i) {
+					allocated[t].push_back(cache.allocate(static_cast<int>(i)));
+				}
+				std::shuffle(allocated[t].begin(), allocated[t].end(), rng);
+				// Free most of them again, some via the pool
+				while (allocated[t].size() > 100) {
+					if (allocated[t].size() % 7 == 0) {
+						Pool::release(allocated[t].back());
+					} else {
+						cache.deallocate(allocated[t].back());
+					}
+					allocated[t].pop_back();
+				}
+			}
+		});
+	}
+	for (auto & thread : threads) {
+		thread.join();
+	}
+
+	std::set<Node *> distinct;
+	for (size_t t = 0; t < POOL_THREADS; ++t) {
+		for (auto n : allocated[t]) {
+			distinct.insert(n);
+			pool.deallocate(n);
+		}
+	}
+	ASSERT_EQ(distinct.size(), 100 * POOL_THREADS);
+	ASSERT_EQ(Node::alive, 0u);
+	// Freed memory has been reused instead of growing the pool
+	ASSERT_LE(pool.capacity(), 2 * POOL_TESTSIZE);
+}
+
+class CNode;
+using COptions =
+    TreeOptions<TreeFlags::MULTIPLE, TreeFlags::ZTREE_USE_HASH,
+                TreeFlags::ZTREE_RANK_HASH_MIX,
+                TreeFlags::ZTREE_HASHER_TYPE<ZTreeAddressHasher<CNode>>>;
+
+class CNode : public ConcurrentZTreeNodeBase<CNode, COptions> {
+public:
+	int data;
+
+	explicit CNode(int data_in) : data(data_in){};
+
+	bool
+	operator<(const CNode & other) const
+	{
+		return this->data < other.data;
+	}
+};
+
+TEST(NodePoolTest, ReclamationTest)
+{
+	using CPool = NodePool<CNode, PoolOptions>;
+	using CTraits =
+	    PoolReclaimingNodeTraits<CPool, ConcurrentZTreeDefaultNodeTraits<CNode>>;
+
+	CPool pool;
+	std::vector<CNode *> nodes;
+	size_t capacity;
+	{
+		ConcurrentZTree<CNode, CTraits, COptions> tree;
+		auto handle = tree.register_thread();
+
+		for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+			nodes.push_back(pool.allocate(static_cast<int>(i)));
+			tree.insert(*nodes.back());
+		}
+		capacity = pool.capacity();
+
+		// Removed nodes go back to the pool once they are reclaimable
+		for (auto n : nodes) {
+			tree.remove(*n, handle);
+		}
+		tree.reclaim_all();
+		ASSERT_TRUE(tree.empty());
+	}
+
+	for (size_t i = 0; i < POOL_TESTSIZE; ++i) {
+		pool.allocate(static_cast<int>(i));
+	}
+	ASSERT_EQ(pool.capacity(), capacity);
+}
+
+} // namespace node_pool
+} // namespace testing
+} // namespace ygg
+
+#endif // TEST_NODE_POOL_HPP
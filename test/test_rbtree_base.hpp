@@ -328,6 +328,326 @@ TEST(__RBT_BASENAME(RBTreeTest), UpperBoundTest)
 	ASSERT_EQ(it, tree.end());
 }
 
+TEST(__RBT_BASENAME(RBTreeTest), FingerSearchTest)
+{
+	auto tree = RBTree<MultiNode, MultiNodeTraits, __RBT_MULTIPLE<>>();
+
+	std::mt19937 rng(RBTREE_SEED);
+	std::uniform_int_distribution<int> values(0, RBTREE_TESTSIZE / 2);
+
+	MultiNode nodes[RBTREE_TESTSIZE];
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		// Produce duplicates
+		nodes[i] = MultiNode(2 * values(rng), static_cast<int>(i));
+		tree.insert(nodes[i]);
+	}
+	tree.dbg_verify();
+
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		auto finger = tree.iterator_to(nodes[rng() % RBTREE_TESTSIZE]);
+		int query = values(rng) * 2 + static_cast<int>(rng() % 2);
+
+		ASSERT_EQ(tree.lower_bound_from(finger, query), tree.lower_bound(query));
+		ASSERT_EQ(tree.lower_bound_from(tree.end(), query),
+		          tree.lower_bound(query));
+
+		auto found = tree.find_from(finger, query);
+		if (query % 2 == 1) {
+			ASSERT_EQ(found, tree.end());
+		} else if (found != tree.end()) {
+			ASSERT_EQ(found->data, query);
+			ASSERT_EQ(found, tree.lower_bound(query));
+		}
+	}
+
+	// const variants
+	const auto & ctree = tree;
+	auto cfinger = ctree.iterator_to(nodes[0]);
+	ASSERT_EQ(ctree.lower_bound_from(cfinger, nodes[1].data),
+	          ctree.lower_bound(nodes[1].data));
+	ASSERT_EQ(ctree.find_from(cfinger, nodes[1].data)->data, nodes[1].data);
+	ASSERT_EQ(ctree.find_from(cfinger, -1), ctree.cend());
+}
+
+TEST(__RBT_BASENAME(RBTreeTest), NearInsertionTest)
+{
+	auto tree = RBTree<MultiNode, MultiNodeTraits, __RBT_MULTIPLE<>>();
+
+	std::mt19937 rng(RBTREE_SEED);
+	MultiNode nodes[RBTREE_TESTSIZE];
+
+	// Nearly sorted, with duplicates
+	auto finger = tree.end();
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		nodes[i] = MultiNode(static_cast<int>(i) - static_cast<int>(rng() % 20),
+		                     static_cast<int>(i));
+		tree.insert_near(nodes[i], finger);
+		finger = tree.iterator_to(nodes[i]);
+		ASSERT_EQ(tree.size(), i + 1);
+	}
+	tree.dbg_verify();
+
+	ASSERT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+
+	// Far away from the finger
+	MultiNode small(-100);
+	MultiNode large(RBTREE_TESTSIZE + 100);
+	tree.insert_near(small, tree.iterator_to(nodes[RBTREE_TESTSIZE - 1]));
+	tree.insert_near(large, tree.iterator_to(nodes[0]));
+	tree.dbg_verify();
+	ASSERT_EQ(&*tree.begin(), &small);
+	ASSERT_EQ(&*tree.rbegin(), &large);
+
+	// Hinting with an iterator must count the node only once
+	MultiNode hinted(RBTREE_TESTSIZE / 2);
+	tree.insert(hinted, tree.iterator_to(nodes[RBTREE_TESTSIZE / 2]));
+	ASSERT_EQ(tree.size(), static_cast<size_t>(RBTREE_TESTSIZE + 3));
+	tree.dbg_verify();
+}
+
+TEST(__RBT_BASENAME(RBTreeTest), RangeErasureTest)
+{
+	auto tree = RBTree<MultiNode, MultiNodeTraits, __RBT_MULTIPLE<>>();
+
+	std::mt19937 rng(RBTREE_SEED);
+	MultiNode nodes[RBTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		// Produce duplicates
+		nodes[i] = MultiNode(static_cast<int>(rng() % (RBTREE_TESTSIZE / 2)),
+		                     static_cast<int>(i));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	auto count_in = [&](int lo, int hi) {
+		return static_cast<size_t>(
+		    std::lower_bound(values.begin(), values.end(), hi) -
+		    std::lower_bound(values.begin(), values.end(), lo));
+	};
+
+	// Erase a range, handing every node to the callback
+	size_t expected = count_in(100, 300);
+	std::vector<MultiNode *> erased;
+	size_t count = tree.erase_range(
+	    100, 300, [&](MultiNode & n) { erased.push_back(&n); });
+	ASSERT_EQ(count, expected);
+	ASSERT_EQ(erased.size(), expected);
+	for (auto n : erased) {
+		ASSERT_TRUE((n->data >= 100) && (n->data < 300));
+	}
+	ASSERT_EQ(tree.size(), RBTREE_TESTSIZE - expected);
+	ASSERT_EQ(tree.lower_bound(100), tree.lower_bound(300));
+	tree.dbg_verify();
+
+	// Empty range
+	ASSERT_EQ(tree.erase_range(200, 250), 0u);
+	ASSERT_EQ(tree.erase_range(500, 400), 0u);
+
+	// Extract a range into a new tree
+	size_t remaining = tree.size();
+	expected = count_in(400, 700);
+	auto extracted = tree.extract_range(400, 700);
+	ASSERT_EQ(extracted.size(), expected);
+	ASSERT_EQ(tree.size(), remaining - expected);
+	extracted.dbg_verify();
+	tree.dbg_verify();
+	ASSERT_TRUE(std::is_sorted(extracted.begin(), extracted.end()));
+	size_t seen = 0;
+	for (auto & n : extracted) {
+		ASSERT_TRUE((n.data >= 400) && (n.data < 700));
+		seen++;
+	}
+	ASSERT_EQ(seen, expected);
+
+	// Everything that remains, up to the end
+	remaining = tree.size();
+	ASSERT_EQ(tree.erase_range(-1, RBTREE_TESTSIZE), remaining);
+	ASSERT_TRUE(tree.empty());
+}
+
+TEST(__RBT_BASENAME(RBTreeTest), EqualRangeTest)
+{
+	auto tree = RBTree<MultiNode, MultiNodeTraits, __RBT_MULTIPLE<>>();
+
+	std::mt19937 rng(RBTREE_SEED);
+	MultiNode nodes[RBTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		// Produce many duplicates
+		nodes[i] = MultiNode(static_cast<int>(rng() % (RBTREE_TESTSIZE / 10)),
+		                     static_cast<int>(i));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	const int max_value = RBTREE_TESTSIZE / 10;
+	for (int query = -1; query <= max_value; ++query) {
+		auto expected = std::equal_range(values.begin(), values.end(), query);
+		size_t expected_count =
+		    static_cast<size_t>(expected.second - expected.first);
+		ASSERT_EQ(tree.count(query), expected_count);
+
+		auto range = tree.equal_range(query);
+		ASSERT_EQ(range.first, tree.lower_bound(query));
+		ASSERT_EQ(range.second, tree.upper_bound(query));
+		size_t seen = 0;
+		for (auto it = range.first; it != range.second; ++it) {
+			ASSERT_EQ(it->data, query);
+			seen++;
+		}
+		ASSERT_EQ(seen, expected_count);
+
+		const auto & ctree = tree;
+		auto crange = ctree.equal_range(query);
+		ASSERT_EQ(crange.first, range.first);
+		ASSERT_EQ(crange.second, range.second);
+	}
+}
+
+// Caches MultiNode's data inside the tree nodes
+class CachedKeyExtractor {
+public:
+	using key_type = int;
+
+	template <class N>
+	static key_type
+	get_key(const N & node) noexcept
+	{
+		return node.data;
+	}
+};
+
+TEST(__RBT_BASENAME(RBTreeTest), CachedKeyTest)
+{
+	using CachedOpt = TreeFlags::BST_CACHED_KEY<CachedKeyExtractor>;
+	using CachedNode = MultiNodeBase<CachedOpt>;
+	auto tree = RBTree<CachedNode, MultiNodeTraits, __RBT_MULTIPLE<CachedOpt>>();
+
+	std::mt19937 rng(RBTREE_SEED);
+	CachedNode nodes[RBTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		// Produce duplicates
+		nodes[i] = CachedNode(static_cast<int>(rng() % (RBTREE_TESTSIZE / 4)),
+		                      static_cast<int>(i));
+		values.push_back(nodes[i].data);
+		// Mix plain, hinted and near insertion
+		if ((i % 3 == 1) && (i > 0)) {
+			tree.insert(nodes[i], nodes[i - 1]);
+		} else if (i % 3 == 2) {
+			tree.insert_near(nodes[i], tree.iterator_to(nodes[i - 1]));
+		} else {
+			tree.insert(nodes[i]);
+		}
+	}
+	std::sort(values.begin(), values.end());
+	tree.dbg_verify();
+	ASSERT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+
+	const int max_value = RBTREE_TESTSIZE / 4;
+	for (int query = -1; query <= max_value; ++query) {
+		auto lower = std::lower_bound(values.begin(), values.end(), query);
+		auto upper = std::upper_bound(values.begin(), values.end(), query);
+
+		// Keys and (uncached) nodes as queries
+		CachedNode query_node(query);
+		for (auto it : {tree.lower_bound(query), tree.lower_bound(query_node)}) {
+			if (lower == values.end()) {
+				ASSERT_EQ(it, tree.end());
+			} else {
+				ASSERT_EQ(it->data, *lower);
+			}
+		}
+		for (auto it : {tree.upper_bound(query), tree.upper_bound(query_node)}) {
+			if (upper == values.end()) {
+				ASSERT_EQ(it, tree.end());
+			} else {
+				ASSERT_EQ(it->data, *upper);
+			}
+		}
+		ASSERT_EQ(tree.find(query) == tree.end(), lower == upper);
+		ASSERT_EQ(tree.find(query_node) == tree.end(), lower == upper);
+		ASSERT_EQ(tree.count(query), static_cast<size_t>(upper - lower));
+	}
+
+	size_t expected = static_cast<size_t>(
+	    std::lower_bound(values.begin(), values.end(), 200) -
+	    std::lower_bound(values.begin(), values.end(), 100));
+	ASSERT_EQ(tree.erase_range(CachedNode(100), CachedNode(200)), expected);
+	tree.dbg_verify();
+
+	for (auto & n : nodes) {
+		if ((n.data < 100) || (n.data >= 200)) {
+			tree.remove(n);
+		}
+	}
+	ASSERT_TRUE(tree.empty());
+}
+
+TEST(__RBT_BASENAME(RBTreeTest), EytzingerTest)
+{
+	auto tree = RBTree<MultiNode, MultiNodeTraits, __RBT_MULTIPLE<>>();
+
+	// Empty snapshot
+	auto empty = tree.freeze_eytzinger<CachedKeyExtractor>();
+	ASSERT_TRUE(empty.empty());
+	ASSERT_EQ(empty.find(0), nullptr);
+	ASSERT_EQ(empty.lower_bound(0), nullptr);
+
+	std::mt19937 rng(RBTREE_SEED);
+	MultiNode nodes[RBTREE_TESTSIZE];
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		// Produce duplicates, leave out odd values
+		nodes[i] = MultiNode(2 * static_cast<int>(rng() % (RBTREE_TESTSIZE / 4)),
+		                     static_cast<int>(i));
+		tree.insert(nodes[i]);
+	}
+
+	auto snapshot = tree.freeze_eytzinger<CachedKeyExtractor>();
+	ASSERT_EQ(snapshot.size(), RBTREE_TESTSIZE);
+
+	auto as_pointer = [&](auto it) -> MultiNode * {
+		return (it == tree.end()) ? nullptr : &*it;
+	};
+	const int max_value = RBTREE_TESTSIZE / 2;
+	for (int query = -1; query <= max_value + 1; ++query) {
+		// The same nodes as in the tree, including the first of equal nodes
+		ASSERT_EQ(snapshot.lower_bound(query), as_pointer(tree.lower_bound(query)));
+		ASSERT_EQ(snapshot.upper_bound(query), as_pointer(tree.upper_bound(query)));
+		if (tree.find(query) == tree.end()) {
+			ASSERT_EQ(snapshot.find(query), nullptr);
+		} else {
+			ASSERT_EQ(snapshot.find(query), snapshot.lower_bound(query));
+		}
+	}
+
+	// The snapshot does not change with the tree
+	tree.remove(*snapshot.lower_bound(0));
+	ASSERT_EQ(snapshot.size(), RBTREE_TESTSIZE);
+
+	// Trees caching their keys use the cached key extractor by default
+	using CachedOpt = TreeFlags::BST_CACHED_KEY<CachedKeyExtractor>;
+	using CachedNode = MultiNodeBase<CachedOpt>;
+	auto cached_tree =
+	    RBTree<CachedNode, MultiNodeTraits, __RBT_MULTIPLE<CachedOpt>>();
+	CachedNode cached_nodes[RBTREE_TESTSIZE];
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		cached_nodes[i] = CachedNode(static_cast<int>(i));
+		cached_tree.insert(cached_nodes[i]);
+	}
+	auto cached_snapshot = cached_tree.freeze_eytzinger();
+	for (unsigned int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		ASSERT_EQ(cached_snapshot.find(static_cast<int>(i)), &cached_nodes[i]);
+	}
+	ASSERT_EQ(cached_snapshot.find(static_cast<int>(RBTREE_TESTSIZE)), nullptr);
+}
+
 TEST(__RBT_BASENAME(RBTreeTest), TrivialDeletionTest)
 {
 	auto tree = RBTree<Node, NodeTraits, __RBT_NONMULTIPLE<>>();
@@ -761,4 +1081,69 @@ TEST(__RBT_BASENAME(RBTreeTest), ComprehensiveMultipleTest)
 		ASSERT_EQ(&(*it), &(persistent_nodes[i]));
 	}
 }
+TEST(__RBT_BASENAME(RBTreeTest), StatisticsTest)
+{
+	using MyNode = NodeBase<TreeFlags::COLLECT_STATISTICS>;
+	auto tree = RBTree<MyNode, NodeTraits,
+	                   __RBT_NONMULTIPLE<TreeFlags::COLLECT_STATISTICS>>();
+
+	// Without statistics, the tree holds nothing but its root, comparator and
+	// size. The counters are empty then (see stats.hpp), this checks that they
+	// are stored such that they do not take up space either.
+	struct PlainTree
+	{
+		void * root;
+		ygg::utilities::flexible_less cmp;
+		size_t size;
+	};
+	static_assert(sizeof(RBTree<Node, NodeTraits, __RBT_NONMULTIPLE<>>) ==
+	                  sizeof(PlainTree),
+	              "Disabled statistics must not take up space.");
+
+	std::vector<MyNode> nodes;
+	for (int i = 0; i < RBTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(i);
+	}
+
+	// Linear insertion needs plenty of rotations
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+	tree.dbg_verify();
+
+	auto counters = tree.get_statistics();
+	ASSERT_GT(counters.rotations, 0u);
+	ASSERT_GT(counters.comparisons, 0u);
+	ASSERT_EQ(counters.zips, 0u);
+	ASSERT_EQ(counters.unzips, 0u);
+	ASSERT_EQ(counters.rebuilds, 0u);
+
+	tree.reset_statistics();
+	ASSERT_EQ(tree.get_statistics().rotations, 0u);
+	ASSERT_EQ(tree.get_statistics().comparisons, 0u);
+
+	ASSERT_NE(tree.find(RBTREE_TESTSIZE / 2), tree.end());
+	ASSERT_GT(tree.get_statistics().comparisons, 0u);
+	ASSERT_EQ(tree.get_statistics().rotations, 0u);
+
+	auto shape = tree.collect_shape();
+	ASSERT_EQ(shape.node_count, static_cast<size_t>(RBTREE_TESTSIZE));
+	ASSERT_EQ(shape.depth_histogram[0], 1u);
+	ASSERT_EQ(shape.depth_histogram.size(), shape.max_depth + 1);
+	size_t histogram_sum = 0;
+	for (auto count : shape.depth_histogram) {
+		histogram_sum += count;
+	}
+	ASSERT_EQ(histogram_sum, shape.node_count);
+	// The height of a red-black tree is at most 2 log(n + 1)
+	ASSERT_LE(static_cast<double>(shape.max_depth),
+	          2 * std::log2(RBTREE_TESTSIZE + 1));
+	ASSERT_LE(shape.average_path_length, static_cast<double>(shape.max_depth));
+
+	auto empty_tree = RBTree<MyNode, NodeTraits,
+	                         __RBT_NONMULTIPLE<TreeFlags::COLLECT_STATISTICS>>();
+	ASSERT_EQ(empty_tree.collect_shape().node_count, 0u);
+	ASSERT_TRUE(empty_tree.collect_shape().depth_histogram.empty());
+}
+
 // TODO test equal elements
@@ -501,6 +501,158 @@ TEST(__WBT_BASENAME(WBTreeTest), UpperBoundTest)
 	ASSERT_EQ(it, tree.end());
 }
 
+TEST(__WBT_BASENAME(WBTreeTest), NearInsertionTest)
+{
+	auto tree = WBTree<MultiNode, MultiNodeTraits, MULTI_FLAGS<>>();
+
+	std::mt19937 rng(WBTREE_SEED);
+	MultiNode nodes[WBTREE_TESTSIZE];
+
+	// Nearly sorted, with duplicates
+	auto finger = tree.end();
+	for (unsigned int i = 0; i < WBTREE_TESTSIZE; ++i) {
+		nodes[i] = MultiNode(static_cast<int>(i) - static_cast<int>(rng() % 20),
+		                     static_cast<int>(i));
+		tree.insert_near(nodes[i], finger);
+		finger = tree.iterator_to(nodes[i]);
+		ASSERT_EQ(tree.size(), i + 1);
+
+		if (i % WBTREE_CHECK_INTERVAL == 0) {
+			tree.dbg_verify();
+		}
+	}
+	tree.dbg_verify();
+	ASSERT_TRUE(std::is_sorted(tree.begin(), tree.end()));
+
+	for (unsigned int i = 0; i < WBTREE_TESTSIZE; ++i) {
+		auto from = tree.iterator_to(nodes[rng() % WBTREE_TESTSIZE]);
+		int query = static_cast<int>(rng() % (WBTREE_TESTSIZE + 40)) - 20;
+		ASSERT_EQ(tree.lower_bound_from(from, query), tree.lower_bound(query));
+	}
+}
+
+TEST(__WBT_BASENAME(WBTreeTest), RangeErasureTest)
+{
+	auto tree = WBTree<MultiNode, MultiNodeTraits, MULTI_FLAGS<>>();
+
+	std::mt19937 rng(WBTREE_SEED);
+	MultiNode nodes[WBTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (unsigned int i = 0; i < WBTREE_TESTSIZE; ++i) {
+		// Produce duplicates
+		nodes[i] = MultiNode(static_cast<int>(rng() % (WBTREE_TESTSIZE / 2)),
+		                     static_cast<int>(i));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	auto count_in = [&](int lo, int hi) {
+		return static_cast<size_t>(
+		    std::lower_bound(values.begin(), values.end(), hi) -
+		    std::lower_bound(values.begin(), values.end(), lo));
+	};
+
+	// Erase a range, handing every node to the callback
+	size_t expected = count_in(100, 300);
+	std::vector<MultiNode *> erased;
+	size_t count = tree.erase_range(
+	    100, 300, [&](MultiNode & n) { erased.push_back(&n); });
+	ASSERT_EQ(count, expected);
+	ASSERT_EQ(erased.size(), expected);
+	for (auto n : erased) {
+		ASSERT_TRUE((n->data >= 100) && (n->data < 300));
+	}
+	ASSERT_EQ(tree.size(), WBTREE_TESTSIZE - expected);
+	ASSERT_EQ(tree.lower_bound(100), tree.lower_bound(300));
+	tree.dbg_verify();
+
+	// Empty range
+	ASSERT_EQ(tree.erase_range(200, 250), 0u);
+	ASSERT_EQ(tree.erase_range(500, 400), 0u);
+
+	// Extract a range into a new tree
+	size_t remaining = tree.size();
+	expected = count_in(400, 700);
+	auto extracted = tree.extract_range(400, 700);
+	ASSERT_EQ(extracted.size(), expected);
+	ASSERT_EQ(tree.size(), remaining - expected);
+	extracted.dbg_verify();
+	tree.dbg_verify();
+	ASSERT_TRUE(std::is_sorted(extracted.begin(), extracted.end()));
+	size_t seen = 0;
+	for (auto & n : extracted) {
+		ASSERT_TRUE((n.data >= 400) && (n.data < 700));
+		seen++;
+	}
+	ASSERT_EQ(seen, expected);
+
+	// Random ranges, which split and join the tree at random places
+	for (unsigned int i = 0; i < 20; ++i) {
+		int lo = static_cast<int>(rng() % (WBTREE_TESTSIZE / 2));
+		int hi = lo + static_cast<int>(rng() % 50);
+		size_t in_tree = 0;
+		for (auto & n : tree) {
+			if ((n.data >= lo) && (n.data < hi)) {
+				in_tree++;
+			}
+		}
+
+		remaining = tree.size();
+		ASSERT_EQ(tree.erase_range(lo, hi), in_tree);
+		ASSERT_EQ(tree.size(), remaining - in_tree);
+		ASSERT_EQ(tree.lower_bound(lo), tree.lower_bound(hi));
+		tree.dbg_verify();
+	}
+
+	// Everything that remains, up to the end
+	remaining = tree.size();
+	ASSERT_EQ(tree.erase_range(-1, WBTREE_TESTSIZE), remaining);
+	ASSERT_TRUE(tree.empty());
+}
+
+TEST(__WBT_BASENAME(WBTreeTest), EqualRangeTest)
+{
+	auto tree = WBTree<MultiNode, MultiNodeTraits, MULTI_FLAGS<>>();
+
+	std::mt19937 rng(WBTREE_SEED);
+	MultiNode nodes[WBTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (unsigned int i = 0; i < WBTREE_TESTSIZE; ++i) {
+		// Produce many duplicates
+		nodes[i] = MultiNode(static_cast<int>(rng() % (WBTREE_TESTSIZE / 10)),
+		                     static_cast<int>(i));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	const int max_value = WBTREE_TESTSIZE / 10;
+	for (int query = -1; query <= max_value; ++query) {
+		auto expected = std::equal_range(values.begin(), values.end(), query);
+		size_t expected_count =
+		    static_cast<size_t>(expected.second - expected.first);
+		ASSERT_EQ(tree.count(query), expected_count);
+
+		auto range = tree.equal_range(query);
+		ASSERT_EQ(range.first, tree.lower_bound(query));
+		ASSERT_EQ(range.second, tree.upper_bound(query));
+		size_t seen = 0;
+		for (auto it = range.first; it != range.second; ++it) {
+			ASSERT_EQ(it->data, query);
+			seen++;
+		}
+		ASSERT_EQ(seen, expected_count);
+
+		const auto & ctree = tree;
+		auto crange = ctree.equal_range(query);
+		ASSERT_EQ(crange.first, range.first);
+		ASSERT_EQ(crange.second, range.second);
+	}
+}
+
 TEST(__WBT_BASENAME(WBTreeTest), TrivialDeletionTest)
 {
 	auto tree = WBTree<Node, NodeTraits, DEFAULT_FLAGS<>>();
@@ -1046,3 +1198,32 @@ TEST(__WBT_BASENAME(WBTreeTest), TestRotationBug1)
 
 	tree.erase_optimistic(nodes[0]);
 }
+
+TEST(__WBT_BASENAME(WBTreeTest), StatisticsTest)
+{
+	using MyNode = NodeBase<TreeFlags::COLLECT_STATISTICS>;
+	auto tree = WBTree<MyNode, NodeTraits,
+	                   DEFAULT_FLAGS<TreeFlags::COLLECT_STATISTICS>>();
+
+	std::vector<MyNode> nodes;
+	for (int i = 0; i < WBTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(i);
+	}
+
+	// Linear insertion needs plenty of rotations
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+	ASSERT_TRUE(tree.verify_integrity());
+
+	auto counters = tree.get_statistics();
+	ASSERT_GT(counters.rotations, 0u);
+	ASSERT_GT(counters.comparisons, 0u);
+
+	auto shape = tree.collect_shape();
+	ASSERT_EQ(shape.node_count, static_cast<size_t>(WBTREE_TESTSIZE));
+	ASSERT_EQ(shape.depth_histogram.size(), shape.max_depth + 1);
+
+	tree.reset_statistics();
+	ASSERT_EQ(tree.get_statistics().rotations, 0u);
+}
@@ -613,6 +613,295 @@ TEST(ZipTreeTest, Bug1Test)
 	itree.dbg_verify();
 }
 
+TEST(ZipTreeTest, FingerSearchAndNearInsertionTest)
+{
+	ExplicitRankTree tree;
+	ImplicitRankTree itree;
+
+	std::mt19937 rng(ZIPTREE_SEED);
+	Node nodes[ZIPTREE_TESTSIZE];
+	HashRankNode inodes[ZIPTREE_TESTSIZE];
+
+	// Nearly sorted, with duplicates and rank ties
+	auto finger = tree.end();
+	auto ifinger = itree.end();
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		int data = static_cast<int>(i / 2) - static_cast<int>(rng() % 20);
+		nodes[i] = Node(data, static_cast<int>(rng() % 8));
+		inodes[i].set_from(HashRankNode(data));
+
+		tree.insert_near(nodes[i], finger);
+		itree.insert_near(inodes[i], ifinger);
+		finger = tree.iterator_to(nodes[i]);
+		ifinger = itree.iterator_to(inodes[i]);
+
+		ASSERT_EQ(tree.size(), i + 1);
+		ASSERT_EQ(itree.size(), i + 1);
+		if (i % 100 == 0) {
+			tree.dbg_verify();
+			itree.dbg_verify();
+		}
+	}
+	tree.dbg_verify();
+	itree.dbg_verify();
+
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		auto from = tree.iterator_to(nodes[rng() % ZIPTREE_TESTSIZE]);
+		auto ifrom = itree.iterator_to(inodes[rng() % ZIPTREE_TESTSIZE]);
+		int query = static_cast<int>(rng() % (ZIPTREE_TESTSIZE / 2 + 40)) - 20;
+
+		ASSERT_EQ(tree.lower_bound_from(from, query), tree.lower_bound(query));
+		ASSERT_EQ(itree.lower_bound_from(ifrom, query), itree.lower_bound(query));
+
+		auto found = tree.find_from(from, query);
+		if (found != tree.end()) {
+			ASSERT_EQ(found->data, query);
+		} else {
+			ASSERT_EQ(tree.find(query), tree.end());
+		}
+	}
+
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		tree.remove(nodes[i]);
+		itree.remove(inodes[i]);
+	}
+	ASSERT_TRUE(tree.empty());
+	ASSERT_TRUE(itree.empty());
+}
+
+TEST(ZipTreeTest, RangeErasureTest)
+{
+	ImplicitRankTree tree;
+
+	std::mt19937 rng(ZIPTREE_SEED);
+	HashRankNode nodes[ZIPTREE_TESTSIZE];
+	std::vector<int> values;
+
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		// Produce duplicates
+		nodes[i].set_from(
+		    HashRankNode(static_cast<int>(rng() % (ZIPTREE_TESTSIZE / 2))));
+		values.push_back(nodes[i].data);
+		tree.insert(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+
+	auto count_in = [&](int lo, int hi) {
+		return static_cast<size_t>(
+		    std::lower_bound(values.begin(), values.end(), hi) -
+		    std::lower_bound(values.begin(), values.end(), lo));
+	};
+
+	// Erase a range, handing every node to the callback
+	size_t expected = count_in(100, 600);
+	std::vector<HashRankNode *> erased;
+	size_t count = tree.erase_range(
+	    100, 600, [&](HashRankNode & n) { erased.push_back(&n); });
+	ASSERT_EQ(count, expected);
+	ASSERT_EQ(erased.size(), expected);
+	for (auto n : erased) {
+		ASSERT_TRUE((n->data >= 100) && (n->data < 600));
+	}
+	ASSERT_EQ(tree.size(), ZIPTREE_TESTSIZE - expected);
+	ASSERT_EQ(tree.lower_bound(100), tree.lower_bound(600));
+	tree.dbg_verify();
+
+	ASSERT_EQ(tree.erase_range(200, 250), 0u);
+
+	// Extract a range into a new tree
+	size_t remaining = tree.size();
+	expected = count_in(1000, 2000);
+	auto extracted = tree.extract_range(1000, 2000);
+	ASSERT_EQ(extracted.size(), expected);
+	ASSERT_EQ(tree.size(), remaining - expected);
+	extracted.dbg_verify();
+	tree.dbg_verify();
+	size_t seen = 0;
+	for (auto & n : extracted) {
+		ASSERT_TRUE((n.data >= 1000) && (n.data < 2000));
+		seen++;
+	}
+	ASSERT_EQ(seen, expected);
+
+	remaining = tree.size();
+	ASSERT_EQ(tree.erase_range(-1, static_cast<int>(ZIPTREE_TESTSIZE)),
+	          remaining);
+	ASSERT_TRUE(tree.empty());
+}
+
+class AddressRankNode;
+using AddressRankOptions = ygg::TreeOptions<
+    TreeFlags::MULTIPLE, TreeFlags::CONSTANT_TIME_SIZE,
+    TreeFlags::ZTREE_USE_HASH, TreeFlags::ZTREE_RANK_HASH_MIX,
+    TreeFlags::ZTREE_HASHER_TYPE<ZTreeAddressHasher<AddressRankNode>>>;
+
+class AddressRankNode
+    : public ZTreeNodeBase<AddressRankNode, AddressRankOptions> {
+public:
+	int data;
+
+	bool
+	operator<(const AddressRankNode & other) const
+	{
+		return this->data < other.data;
+	}
+};
+
+// Caches NodeBase's data inside the tree nodes
+class CachedKeyExtractor {
+public:
+	using key_type = int;
+
+	template <class N>
+	static key_type
+	get_key(const N & node) noexcept
+	{
+		return node.data;
+	}
+};
+
+TEST(ZipTreeTest, CachedKeyTest)
+{
+	using CachedOpt = TreeFlags::BST_CACHED_KEY<CachedKeyExtractor>;
+	using CachedNode = NodeBase<CachedOpt>;
+	ExplicitRankTreeBase<CachedOpt> tree;
+
+	std::mt19937 rng(ZIPTREE_SEED);
+	CachedNode nodes[ZIPTREE_TESTSIZE];
+	std::vector<int> values;
+
+	auto finger = tree.end();
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		// Duplicates and rank ties
+		nodes[i] = CachedNode(static_cast<int>(rng() % (ZIPTREE_TESTSIZE / 4)),
+		                      static_cast<int>(rng() % 8));
+		values.push_back(nodes[i].data);
+		if (i % 2 == 0) {
+			tree.insert(nodes[i]);
+		} else {
+			tree.insert_near(nodes[i], finger);
+		}
+		finger = tree.iterator_to(nodes[i]);
+	}
+	std::sort(values.begin(), values.end());
+	tree.dbg_verify();
+
+	const int max_value = static_cast<int>(ZIPTREE_TESTSIZE / 4);
+	for (int query = -1; query <= max_value; ++query) {
+		auto lower = std::lower_bound(values.begin(), values.end(), query);
+		auto upper = std::upper_bound(values.begin(), values.end(), query);
+
+		auto range = tree.equal_range(CachedNode(query, 0));
+		ASSERT_EQ(range.first, tree.lower_bound(query));
+		ASSERT_EQ(range.second, tree.upper_bound(query));
+		ASSERT_EQ(tree.count(query), static_cast<size_t>(upper - lower));
+		if (lower != values.end()) {
+			ASSERT_EQ(range.first->data, *lower);
+		}
+	}
+
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		tree.remove(nodes[i]);
+		if (i % 500 == 0) {
+			tree.dbg_verify();
+		}
+	}
+	ASSERT_TRUE(tree.empty());
+}
+
+TEST(ZipTreeTest, MixedHashRankTest)
+{
+	ZTree<AddressRankNode, ZTreeDefaultNodeTraits<AddressRankNode>,
+	      AddressRankOptions>
+	    tree;
+
+	std::vector<AddressRankNode> nodes(ZIPTREE_TESTSIZE);
+	std::vector<size_t> indices;
+	size_t lowest_rank_count = 0;
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		nodes[i].data = static_cast<int>(i);
+		indices.push_back(i);
+		if (nodes[i].dbg_get_rank() == 1) {
+			lowest_rank_count++;
+		}
+	}
+
+	// Even though the addresses are aligned, ranks must be (roughly)
+	// geometrically distributed
+	ASSERT_GT(lowest_rank_count, ZIPTREE_TESTSIZE * 4 / 10);
+	ASSERT_LT(lowest_rank_count, ZIPTREE_TESTSIZE * 6 / 10);
+
+	std::shuffle(indices.begin(), indices.end(),
+	             ygg::testing::utilities::Randomizer(ZIPTREE_SEED));
+	for (auto index : indices) {
+		tree.insert(nodes[index]);
+	}
+	tree.dbg_verify();
+
+	int i = 0;
+	for (auto & node : tree) {
+		ASSERT_EQ(node.data, i);
+		i++;
+	}
+
+	for (size_t j = 0; j < ZIPTREE_TESTSIZE; j += 2) {
+		tree.remove(nodes[indices[j]]);
+	}
+	tree.dbg_verify();
+
+	// Stored ranks computed in bulk must match the ones computed one by one
+	using MixedTree = ImplicitRankTreeBase<TreeFlags::ZTREE_RANK_HASH_MIX>;
+	using MixedNode = HashRankNodeBase<TreeFlags::ZTREE_RANK_HASH_MIX>;
+	std::vector<MixedNode> single_nodes;
+	std::vector<MixedNode> bulk_nodes(ZIPTREE_TESTSIZE);
+	for (size_t j = 0; j < ZIPTREE_TESTSIZE; ++j) {
+		single_nodes.emplace_back(static_cast<int>(j));
+		bulk_nodes[j] = single_nodes[j];
+	}
+	MixedTree::update_ranks(bulk_nodes.begin(), bulk_nodes.end());
+
+	MixedTree mixed_tree;
+	for (size_t j = 0; j < ZIPTREE_TESTSIZE; ++j) {
+		ASSERT_EQ(bulk_nodes[j].dbg_get_rank(), single_nodes[j].dbg_get_rank());
+		mixed_tree.insert(bulk_nodes[j]);
+	}
+	mixed_tree.dbg_verify();
+}
+
+TEST(ZipTreeTest, StatisticsTest)
+{
+	using StatTree = ImplicitRankTreeBase<TreeFlags::COLLECT_STATISTICS>;
+	using StatNode = HashRankNodeBase<TreeFlags::COLLECT_STATISTICS>;
+
+	std::vector<StatNode> nodes;
+	for (size_t i = 0; i < ZIPTREE_TESTSIZE; ++i) {
+		nodes.emplace_back(static_cast<int>(i));
+	}
+
+	StatTree tree;
+	for (auto & n : nodes) {
+		tree.insert(n);
+	}
+	tree.dbg_verify();
+
+	auto counters = tree.get_statistics();
+	ASSERT_GT(counters.unzips, 0u);
+	ASSERT_LE(counters.unzips, static_cast<size_t>(ZIPTREE_TESTSIZE));
+	ASSERT_EQ(counters.zips, 0u);
+	ASSERT_EQ(counters.rotations, 0u);
+	ASSERT_GT(counters.comparisons, 0u);
+
+	auto shape = tree.collect_shape();
+	ASSERT_EQ(shape.node_count, static_cast<size_t>(ZIPTREE_TESTSIZE));
+	ASSERT_GT(shape.average_path_length, 0);
+
+	for (auto & n : nodes) {
+		tree.remove(n);
+	}
+	ASSERT_EQ(tree.get_statistics().zips, static_cast<size_t>(ZIPTREE_TESTSIZE));
+	ASSERT_EQ(tree.collect_shape().node_count, 0u);
+}
+
 } // namespace ziptree
 } // namespace testing
 } // namespace ygg